@@ -9,16 +9,23 @@ CONFIG += c++11
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    Entities/animationcache.cpp \
+    Entities/archetype.cpp \
+    Entities/bodystore.cpp \
     Entities/collisionbox.cpp \
     Entities/door.cpp \
     Entities/entity.cpp \
+    Entities/entityids.cpp \
     Entities/living.cpp \
     Entities/monster.cpp \
     Entities/npc.cpp \
     Entities/projectile.cpp \
+    Entities/roomarena.cpp \
     Entities/samos.cpp \
+    Entities/samosstates.cpp \
     Entities/savepoint.cpp \
     Entities/terrain.cpp \
+    Entities/textureatlas.cpp \
     Entities/area.cpp \
     Easing/Back.cpp \
     Easing/Bounce.cpp \
@@ -38,20 +45,34 @@ SOURCES += \
     mainwindow.cpp \
     map.cpp \
     physics.cpp \
-    save.cpp
+    renderframe.cpp \
+    renderqueue.cpp \
+    renderworker.cpp \
+    roomstreamer.cpp \
+    save.cpp \
+    spatialgrid.cpp \
+    staticgeometry.cpp \
+    staticlayer.cpp
 
 HEADERS += \
+    Entities/animationcache.h \
+    Entities/archetype.h \
+    Entities/bodystore.h \
     Entities/collisionbox.h \
     Entities/door.h \
     Entities/dynamicobj.h \
     Entities/entity.h \
+    Entities/entityids.h \
     Entities/living.h \
     Entities/monster.h \
     Entities/npc.h \
     Entities/projectile.h \
+    Entities/roomarena.h \
     Entities/samos.h \
+    Entities/samosstates.h \
     Entities/savepoint.h \
     Entities/terrain.h \
+    Entities/textureatlas.h \
     Entities/area.h \
     Easing/Back.h \
     Easing/Bounce.h \
@@ -70,8 +91,17 @@ HEADERS += \
     map.h \
     nlohmann/json.hpp \
     physics.h \
+    physicsstepresult.h \
     precompiledheaders.h \
-    save.h
+    renderframe.h \
+    renderqueue.h \
+    renderworker.h \
+    roomstreamer.h \
+    save.h \
+    spatialgrid.h \
+    staticgeometry.h \
+    staticlayer.h \
+    triplebuffer.h
 
 PRECOMPILED_HEADER = precompiledheaders.h
 
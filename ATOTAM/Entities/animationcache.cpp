@@ -0,0 +1,405 @@
+#include "animationcache.h"
+
+#include <QPainter>
+#include <QString>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+std::mutex AnimationCache::mutex;
+std::string AnimationCache::texturesPath = "";
+std::unordered_map<std::string, QImage> AnimationCache::files;
+TextureAtlas AnimationCache::atlas;
+std::vector<std::shared_ptr<QImage>> AnimationCache::atlasPages;
+std::map<AnimationCache::ClipKey, AnimationCache::Frames> AnimationCache::clips;
+std::map<AnimationCache::AnimationKey, AnimationCache::Frames> AnimationCache::animations;
+std::list<std::pair<AnimationCache::TintKey, QImage>> AnimationCache::tints;
+std::map<AnimationCache::TintKey, std::list<std::pair<AnimationCache::TintKey, QImage>>::iterator> AnimationCache::tintIndex;
+unsigned long long AnimationCache::tintBytes = 0;
+const QColor AnimationCache::tintColors[tintCount] = {
+    QColor(0, 0, 0, 0), // NoTint
+    QColor(200, 200, 200, 200) // Flash, while invincible
+};
+unsigned long long AnimationCache::hits = 0;
+unsigned long long AnimationCache::misses = 0;
+unsigned long long AnimationCache::residentBytes = 0;
+
+AnimationCache::Frames AnimationCache::get(const Archetype *archetype, StateId state, Facing facing, std::pair<int, int> repeat)
+{
+    int horizontalRepeat = repeat.first;
+    int verticalRepeat = repeat.second;
+    if (archetype == nullptr || horizontalRepeat < 1 || verticalRepeat < 1)
+        return empty();
+
+    if (!archetype->randomTexture.empty() && state == State::None) {
+        // One random state per repetition, in the same order as the frames are placed
+        std::vector<StateId> cells;
+        for (int hRepeat = 0; hRepeat < horizontalRepeat; hRepeat++)
+            for (int vRepeat = 0; vRepeat < verticalRepeat; vRepeat++)
+                cells.push_back(archetype->randomTexture
+                        [((double) rand() / (RAND_MAX+1)) * (archetype->randomTexture.size() - 1 + 1) + 0]); // Generates a random number in range [0; archetype->randomTexture.size()]
+
+        // The same state everywhere is just that state's animation
+        if (std::count(cells.begin(), cells.end(), cells.front()) == static_cast<std::vector<StateId>::difference_type>(cells.size()))
+            return get(archetype, cells.front(), facing, repeat);
+
+        unsigned long long bytes = 0;
+        Frames frames = build(archetype, cells, facing, horizontalRepeat, verticalRepeat, bytes);
+        std::lock_guard<std::mutex> lock(mutex);
+        misses++;
+        return frames;
+    }
+
+    int facingSide = EntityIds::isLeft(facing) ? Left : EntityIds::isRight(facing) ? Right : Front;
+    AnimationKey key(archetype->texture, state, facingSide, horizontalRepeat, verticalRepeat);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<AnimationKey, Frames>::iterator cached = animations.find(key);
+        if (cached != animations.end()) {
+            hits++;
+            return cached->second;
+        }
+    }
+
+    // Built without the lock, as the overlays are other animations
+    unsigned long long bytes = 0;
+    Frames frames = build(archetype, std::vector<StateId>(horizontalRepeat * verticalRepeat, state),
+                          facing, horizontalRepeat, verticalRepeat, bytes);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    misses++;
+    std::pair<std::map<AnimationKey, Frames>::iterator, bool> inserted = animations.insert(std::make_pair(key, frames));
+    if (inserted.second)
+        residentBytes += bytes;
+    // Else another thread built it meanwhile, every entity should share the same frames
+    return inserted.first->second;
+}
+
+const AnimationCache::Frames &AnimationCache::empty()
+{
+    static const Frames none = std::make_shared<const std::vector<QImage>>();
+    return none;
+}
+
+QImage AnimationCache::tinted(const QImage &frame, Tint tint)
+{
+    if (tint == NoTint || frame.isNull())
+        return frame;
+
+    // The frames are never modified, so their cacheKey always means the same pixels
+    std::lock_guard<std::mutex> lock(mutex);
+    TintKey key(frame.cacheKey(), tint);
+    std::map<TintKey, std::list<std::pair<TintKey, QImage>>::iterator>::iterator cached = tintIndex.find(key);
+    if (cached != tintIndex.end()) {
+        tints.splice(tints.begin(), tints, cached->second);
+        return cached->second->second;
+    }
+
+    QImage result = frame;
+    QPainter painter(&result);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceAtop);
+    painter.fillRect(result.rect(), tintColors[tint]);
+    painter.end();
+    residentBytes += result.sizeInBytes();
+    tintBytes += result.sizeInBytes();
+    tints.push_front(std::make_pair(key, result));
+    tintIndex[key] = tints.begin();
+
+    // The random textures give each entity frames of its own, whose keys are never asked for again once it's gone
+    while (tintBytes > tintBudget && tints.size() > 1) {
+        residentBytes -= tints.back().second.sizeInBytes();
+        tintBytes -= tints.back().second.sizeInBytes();
+        tintIndex.erase(tints.back().first);
+        tints.pop_back();
+    }
+    return result;
+}
+
+QImage AnimationCache::displayReady(const QImage &image)
+{
+    if (image.isNull())
+        return image;
+    if (!image.hasAlphaChannel())
+        return image.convertToFormat(QImage::Format_RGB32);
+
+    QImage premultiplied = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    if (!isOpaque(premultiplied))
+        return premultiplied;
+    // Same pixels, the alpha bytes are just ignored from now on
+    return premultiplied.convertToFormat(QImage::Format_RGB32);
+}
+
+bool AnimationCache::isOpaque(const QImage &image)
+{
+    if (!image.hasAlphaChannel())
+        return true;
+    if (image.format() != QImage::Format_ARGB32 && image.format() != QImage::Format_ARGB32_Premultiplied)
+        return isOpaque(image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+
+    for (int y = 0; y < image.height(); y++) {
+        const QRgb *line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); x++)
+            if (qAlpha(line[x]) != 255)
+                return false;
+    }
+    return true;
+}
+
+void AnimationCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    files.clear();
+    std::fill(atlasPages.begin(), atlasPages.end(), std::shared_ptr<QImage>());
+    clips.clear();
+    animations.clear();
+    tints.clear();
+    tintIndex.clear();
+    tintBytes = 0;
+    residentBytes = 0;
+}
+
+void AnimationCache::setAssetsPath(const std::string &assetsPath)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    texturesPath = assetsPath + "/textures/";
+    files.clear();
+    atlasPages.clear();
+
+    if (atlas.load(TextureAtlas::indexPath(texturesPath))) {
+        if (atlas.getSourceHash() == TextureAtlas::hashSources(assetsPath, atlas.getSourceFiles()))
+            atlasPages.resize(atlas.getPages().size());
+        else {
+            // The clips or the textures may have changed, slicing the files is slower but right
+            std::cerr << "The texture atlas wasn't packed from this entities.json and these textures, run ATOTAM_AtlasPacker again" << std::endl;
+            atlas.clear();
+        }
+    }
+}
+
+bool AnimationCache::getUsesAtlas()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return !atlas.isEmpty();
+}
+
+unsigned long long AnimationCache::getHits()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+unsigned long long AnimationCache::getMisses()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+unsigned long long AnimationCache::getResidentBytes()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return residentBytes;
+}
+
+AnimationCache::Side AnimationCache::side(const AnimationClip &clip, Facing facing)
+{
+    if (EntityIds::isLeft(facing))
+        return Left;
+    // Only multi-directional clips are cropped when facing right
+    if (EntityIds::isRight(facing) || !clip.multiDirectional)
+        return Right;
+    return Front;
+}
+
+std::vector<QImage> AnimationCache::cut(const QImage &file, const AnimationClip &clip, Side side)
+{
+    std::vector<QImage> frames;
+
+    // Getting the full animation image which will be cropped afterwards
+    QImage fullAnim = file.copy(clip.x, clip.y, clip.width, clip.height);
+    // If the animation is multi-directional the program shouldn't keep the irrelevant part
+    if (clip.multiDirectional) {
+        if (side == Left) {
+            fullAnim = fullAnim.copy(0, 0, clip.width / 2, clip.height);
+        } else if (side == Right) {
+            fullAnim = fullAnim.copy(clip.width / 2, 0,
+                    clip.width, clip.height);
+        }
+    }
+
+    int imagesPerLine = (static_cast<int>(clip.count) + clip.emptyFrames) / clip.lines;
+    int width = clip.width / imagesPerLine;
+    // Make sure not to get two images at a time
+    if (clip.multiDirectional)
+        width /= 2;
+    int height = clip.height / clip.lines;
+    // For each line
+    for (int i = (clip.reversed ? clip.lines - 1 : 0);
+         (clip.reversed ? i > -1 : i < clip.lines);
+         (clip.reversed ? i-- : i++)) {
+        // For each sprite
+        if (side != Left)
+            for (int ii = 0;
+                 ii < (i + 1 == clip.lines ? /*Remove empty frames from the last line*/ clip.emptyFramesReversed ?
+                       imagesPerLine : imagesPerLine - clip.emptyFrames : imagesPerLine); ii++) {
+
+                if (clip.emptyFramesReversed && i + 1 == clip.lines && ii == 0)
+                    ii += clip.emptyFrames;
+
+                frames.push_back(fullAnim.copy(ii * width, i * height, width, height));
+            }
+        else
+            for (int ii = imagesPerLine - 1;
+                 ii > (i + 1 == clip.lines ? /*Remove empty frames from the last line*/ clip.emptyFramesReversed ?
+                       -1 : clip.emptyFrames - 1 : -1); ii--) {
+
+                if (clip.emptyFramesReversed && i + 1 == clip.lines && ii == imagesPerLine - 1)
+                    ii -= clip.emptyFrames;
+
+                frames.push_back(fullAnim.copy(ii * width, i * height, width, height));
+            }
+    }
+
+    return frames;
+}
+
+const QImage &AnimationCache::file(const std::string &name)
+{
+    std::unordered_map<std::string, QImage>::iterator decoded = files.find(name);
+    if (decoded == files.end()) {
+        // Premultiplied once here, the frames cut from it are then only checked for opacity
+        decoded = files.insert(std::make_pair(name, QImage(QString::fromStdString(texturesPath + name))
+                                               .convertToFormat(QImage::Format_ARGB32_Premultiplied))).first;
+        residentBytes += decoded->second.sizeInBytes();
+    }
+    return decoded->second;
+}
+
+std::vector<QImage> AnimationCache::map(const std::vector<AtlasFrame> &atlasFrames)
+{
+    std::vector<QImage> frames;
+    for (std::vector<AtlasFrame>::const_iterator atlasFrame = atlasFrames.begin(); atlasFrame != atlasFrames.end(); atlasFrame++) {
+        if (atlasFrame->page >= atlasPages.size() || atlasFrame->width == 0 || atlasFrame->height == 0) {
+            frames.push_back(QImage());
+            continue;
+        }
+        std::shared_ptr<QImage> &page = atlasPages[atlasFrame->page];
+        if (page == nullptr) {
+            page = std::make_shared<QImage>(QImage(QString::fromStdString(TextureAtlas::directory(texturesPath) + atlas.getPages()[atlasFrame->page]))
+                                            .convertToFormat(QImage::Format_ARGB32_Premultiplied));
+            residentBytes += page->sizeInBytes();
+        }
+        // The frame points into the page instead of copying its pixels, and keeps the page alive.
+        // Opaque frames read the same pixels as RGB32, see displayReady
+        uchar *pixels = page->bits() + atlasFrame->y * page->bytesPerLine() + atlasFrame->x * 4;
+        bool opaque = isOpaque(QImage(pixels, atlasFrame->width, atlasFrame->height, page->bytesPerLine(), page->format()));
+        frames.push_back(QImage(pixels, atlasFrame->width, atlasFrame->height, page->bytesPerLine(),
+                                opaque ? QImage::Format_RGB32 : page->format(),
+                                releasePage, new std::shared_ptr<QImage>(page)));
+    }
+    return frames;
+}
+
+void AnimationCache::releasePage(void *page)
+{
+    delete static_cast<std::shared_ptr<QImage>*>(page);
+}
+
+AnimationCache::Frames AnimationCache::slice(const Archetype *archetype, StateId state, Facing facing)
+{
+    const AnimationClip *clip = &archetype->getClip(state);
+    Side clipSide = side(*clip, facing);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ClipKey key(archetype->texture, state, clipSide);
+    std::map<ClipKey, Frames>::iterator cached = clips.find(key);
+    if (cached != clips.end())
+        return cached->second;
+
+    // The atlas is only for the texture's own clips, the default one has no file
+    const std::vector<AtlasFrame> *atlasFrames = clip == &archetype->defaultClip ? nullptr
+            : atlas.find(archetype->texture, EntityIds::stateName(clip->state), clipSide);
+    std::vector<QImage> *frames = new std::vector<QImage>(atlasFrames != nullptr ? map(*atlasFrames)
+                                                                               : cut(file(clip->file), *clip, clipSide));
+
+    // Remove the empty pixels on the top-left
+    for (std::vector<QImage>::iterator frame = frames->begin(); frame != frames->end(); frame++) {
+        if (atlasFrames == nullptr)
+            *frame = displayReady(*frame);
+        if (clipSide == Left)
+            frame->setOffset(QPoint(clip->xOffset[0], clip->yOffset[0]));
+        else
+            frame->setOffset(QPoint(clip->xOffset[1], clip->yOffset[1]));
+        // Mapped frames use the memory of their page
+        if (atlasFrames == nullptr)
+            residentBytes += frame->sizeInBytes();
+    }
+
+    Frames sliced(frames);
+    clips[key] = sliced;
+    return sliced;
+}
+
+AnimationCache::Frames AnimationCache::build(const Archetype *archetype, const std::vector<StateId> &cells, Facing facing,
+                                             int horizontalRepeat, int verticalRepeat, unsigned long long &bytes)
+{
+    // The last repetition's clip gives the overlays and the offsets
+    const AnimationClip *clip = &archetype->getClip(cells.back());
+
+    std::vector<Frames> cellFrames;
+    for (std::vector<StateId>::const_iterator cell = cells.begin(); cell != cells.end(); cell++)
+        cellFrames.push_back(slice(archetype, *cell, facing));
+
+    if ((horizontalRepeat == 1 && verticalRepeat == 1) && clip->overlay.empty())
+        return cellFrames.front(); // Already offset, nothing to copy
+
+    std::vector<QImage> animation = *cellFrames.front();
+
+    // Repeating the frame
+    if (horizontalRepeat != 1 || verticalRepeat != 1) {
+        for (unsigned int frameIndex = 0; frameIndex < animation.size(); frameIndex++) {
+            const QImage frame = animation[frameIndex];
+            // Creating the final frame. The repetitions may not all be opaque, so it starts transparent
+            QImage temp(frame.width() * horizontalRepeat,
+                        frame.height() * verticalRepeat,
+                        QImage::Format_ARGB32_Premultiplied);
+            temp.fill(Qt::transparent);
+            QPainter painter(&temp);
+            for (int hRepeat = 0; hRepeat < horizontalRepeat; hRepeat++) {
+                for (int vRepeat = 0; vRepeat < verticalRepeat; vRepeat++) {
+                    // Modifying the final frame using the current one
+                    painter.drawImage(hRepeat * clip->width, vRepeat * clip->height,
+                                      (*cellFrames[hRepeat * verticalRepeat + vRepeat])[frameIndex]);
+                }
+            }
+            painter.end();
+            animation[frameIndex] = displayReady(temp);
+        }
+    }
+
+    // Place the overlay on top of the current animation
+    for (std::vector<StateId>::const_iterator ovrly = clip->overlay.begin(); ovrly != clip->overlay.end(); ovrly++) {
+        Frames overlay = get(archetype, *ovrly, facing, std::pair<int, int>(horizontalRepeat, verticalRepeat));
+        for (unsigned int i = 0; i < animation.size(); i++) {
+            QImage result(std::max((*overlay)[i].width(), animation[i].width()), std::max((*overlay)[i].height(), animation[i].height()),
+                          QImage::Format_ARGB32_Premultiplied);
+            result.fill(Qt::transparent);
+            QPainter merger(&result);
+            merger.drawImage(0, 0, animation[i]);
+            merger.drawImage(0, 0, (*overlay)[i]);
+            merger.end();
+            animation[i] = displayReady(result);
+        }
+    }
+
+    // Remove the empty pixels on the top-left
+    for (std::vector<QImage>::iterator frame = animation.begin(); frame != animation.end(); frame++) {
+        if (EntityIds::isLeft(facing))
+            frame->setOffset(QPoint(clip->xOffset[0], clip->yOffset[0]));
+        else
+            frame->setOffset(QPoint(clip->xOffset[1], clip->yOffset[1]));
+        bytes += frame->sizeInBytes();
+    }
+
+    return std::make_shared<const std::vector<QImage>>(animation);
+}
@@ -0,0 +1,88 @@
+#ifndef ANIMATIONCACHE_H
+#define ANIMATIONCACHE_H
+
+#include "archetype.h"
+#include "entityids.h"
+#include "textureatlas.h"
+#include <QColor>
+#include <QImage>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Animations shared by every entity. Each texture file is decoded once, each clip is sliced once
+// per facing and each (texture, state, facing, repeat) animation is built once.
+// The frames are never modified after being built, so entities only keep a pointer to them
+class AnimationCache
+{
+public:
+    typedef std::shared_ptr<const std::vector<QImage>> Frames;
+    enum Side { Left, Right, Front }; // Facings giving different frames of a clip
+    enum Tint { NoTint, Flash, tintCount }; // Colors painted over the opaque pixels of a frame, see tintColors
+    static const unsigned long long tintBudget = 8 * 1024 * 1024; // in bytes, the least recently used tinted frames go beyond it
+
+    // Frames of 'state', repeated repeat.first times horizontally and repeat.second times vertically.
+    // Stateless entities with a 'randomTexture' get a random state per repetition
+    static Frames get(const Archetype *archetype, StateId state, Facing facing, std::pair<int, int> repeat);
+    static const Frames &empty(); // Never nullptr, for entities without a texture
+    // 'frame' with 'tint' painted over it, built the first time it is asked for and kept while it fits in tintBudget
+    static QImage tinted(const QImage &frame, Tint tint);
+    // 'image' in the format it's the fastest to draw onto the backbuffer from: RGB32 when every pixel is opaque,
+    // so that the blit is a plain copy, ARGB32_Premultiplied otherwise, so that QPainter doesn't convert it every time.
+    // Every frame of the cache goes through it, textures loaded elsewhere should too
+    static QImage displayReady(const QImage &image);
+    static bool isOpaque(const QImage &image);
+
+    // Forgets every animation, the entities keep the frames they are using alive.
+    // Called when entities.json is compiled again, as the textures may have changed
+    static void clear();
+    // Also loads the atlas packed by ATOTAM_AtlasPacker, if it was packed from this entities.json
+    static void setAssetsPath(const std::string &assetsPath);
+    static bool getUsesAtlas();
+
+    static Side side(const AnimationClip &clip, Facing facing);
+    // Frames of 'clip' cropped from its texture file, without their offsets.
+    // Used when the clip isn't in the atlas, and by ATOTAM_AtlasPacker
+    static std::vector<QImage> cut(const QImage &file, const AnimationClip &clip, Side side);
+
+    static unsigned long long getHits();
+    static unsigned long long getMisses(); // Built animations, including the random ones that can't be kept
+    static unsigned long long getResidentBytes(); // Decoded files and frames held by the cache
+
+private:
+    typedef std::tuple<std::string, StateId, int> ClipKey; // Texture, state, Side
+    typedef std::tuple<std::string, StateId, int, int, int> AnimationKey; // Texture, state, Side, repeats
+    typedef std::pair<long long, int> TintKey; // QImage::cacheKey, Tint
+
+    static const QColor tintColors[tintCount];
+
+    static const QImage &file(const std::string &name); // Called with 'mutex' locked
+    static std::vector<QImage> map(const std::vector<AtlasFrame> &atlasFrames); // Called with 'mutex' locked
+    static void releasePage(void *page);
+    static Frames slice(const Archetype *archetype, StateId state, Facing facing);
+    static Frames build(const Archetype *archetype, const std::vector<StateId> &cells, Facing facing,
+                        int horizontalRepeat, int verticalRepeat, unsigned long long &bytes);
+
+    static std::mutex mutex; // Rooms are loaded on another thread
+    static std::string texturesPath;
+    static std::unordered_map<std::string, QImage> files;
+    static TextureAtlas atlas;
+    static std::vector<std::shared_ptr<QImage>> atlasPages; // Loaded when first needed
+    static std::map<ClipKey, Frames> clips;
+    static std::map<AnimationKey, Frames> animations;
+    static std::list<std::pair<TintKey, QImage>> tints; // Most recently used first
+    static std::map<TintKey, std::list<std::pair<TintKey, QImage>>::iterator> tintIndex;
+    static unsigned long long tintBytes;
+    static unsigned long long hits;
+    static unsigned long long misses;
+    static unsigned long long residentBytes;
+};
+
+#endif // ANIMATIONCACHE_H
@@ -0,0 +1,252 @@
+#include "archetype.h"
+#include "animationcache.h"
+
+#include <algorithm>
+
+static double number(const nlohmann::json &json, const char *key, double defaultValue = 0.0)
+{
+    return (json.contains(key) && json[key].is_number()) ? json[key].get<double>() : defaultValue;
+}
+
+static int integer(const nlohmann::json &json, const char *key, int defaultValue = 0)
+{
+    return (json.contains(key) && json[key].is_number()) ? json[key].get<int>() : defaultValue;
+}
+
+static bool boolean(const nlohmann::json &json, const char *key, bool defaultValue = false)
+{
+    return (json.contains(key) && json[key].is_boolean()) ? json[key].get<bool>() : defaultValue;
+}
+
+static std::string text(const nlohmann::json &json, const char *key, const std::string &defaultValue = "")
+{
+    return (json.contains(key) && json[key].is_string()) ? json[key].get<std::string>() : defaultValue;
+}
+
+static AnimationClip compileClip(StateId state, const nlohmann::json &animation, const nlohmann::json &defaults)
+{
+    // Same rule as the runtime used to apply: a missing or null value takes the default one
+    nlohmann::json json = animation.is_object() ? animation : nlohmann::json::object();
+    for (auto value : defaults.items())
+        if (!json.contains(value.key()) || json[value.key()].is_null())
+            json[value.key()] = value.value();
+
+    AnimationClip clip;
+    clip.state = state;
+    clip.file = text(json, "file");
+    clip.x = integer(json, "x");
+    clip.y = integer(json, "y");
+    clip.width = integer(json, "width", 1);
+    clip.height = integer(json, "height", 1);
+    clip.count = integer(json, "count", 1);
+    clip.emptyFrames = integer(json, "emptyFrames");
+    clip.emptyFramesReversed = boolean(json, "emptyFramesReversed");
+    clip.lines = integer(json, "lines", 1);
+    clip.multiDirectional = boolean(json, "multi-directional");
+    for (unsigned int i = 0; i < 2; i++) {
+        clip.xOffset[i] = json["xOffset"].is_array() && json["xOffset"].size() > i ? json["xOffset"][i].get<int>() : 0;
+        clip.yOffset[i] = json["yOffset"].is_array() && json["yOffset"].size() > i ? json["yOffset"][i].get<int>() : 0;
+    }
+    clip.reversed = boolean(json, "reversed");
+    if (json["overlay"].is_array())
+        for (const nlohmann::json &overlay : json["overlay"])
+            clip.overlay.push_back(EntityIds::state(overlay.get<std::string>()));
+    clip.loop = boolean(json, "loop");
+    clip.refreshRate = integer(json, "refreshRate", -1);
+    clip.dontReset = boolean(json, "dontReset");
+    return clip;
+}
+
+static SamosTuning compileSamosTuning(const nlohmann::json &json)
+{
+    SamosTuning tuning;
+    tuning.fastFriction = number(json, "fastFriction");
+    tuning.superFastFriction = number(json, "superFastFriction");
+    tuning.movingFriction = number(json, "movingFriction");
+    tuning.movingFastFriction = number(json, "movingFastFriction");
+    tuning.movingSuperFastFriction = number(json, "movingSuperFastFriction");
+    tuning.groundAcceleration = number(json, "groundAcceleration");
+    tuning.groundMaxSpeed = number(json, "groundMaxSpeed");
+    tuning.groundRunAcceleration = number(json, "groundRunAcceleration");
+    tuning.groundRunMaxSpeedGap = number(json, "groundRunMaxSpeedGap");
+    tuning.groundRunMaxSpeed = number(json, "groundRunMaxSpeed");
+    tuning.airAcceleration = number(json, "airAcceleration");
+    tuning.airMaxSpeed = number(json, "airMaxSpeed");
+    tuning.morphGroundAcceleration = number(json, "morphGroundAcceleration");
+    tuning.morphGroundMaxSpeed = number(json, "morphGroundMaxSpeed");
+    tuning.morphAirAcceleration = number(json, "morphAirAcceleration");
+    tuning.morphAirMaxSpeed = number(json, "morphAirMaxSpeed");
+    tuning.crouchHitboxOffsetX = integer(json, "crouchHitbox_offset_x");
+    tuning.crouchHitboxOffsetY = integer(json, "crouchHitbox_offset_y");
+    tuning.crouchHitboxWidth = integer(json, "crouchHitbox_width");
+    tuning.crouchHitboxHeight = integer(json, "crouchHitbox_height");
+    tuning.fallingHitboxOffsetX = integer(json, "fallingHitbox_offset_x");
+    tuning.fallingHitboxOffsetY = integer(json, "fallingHitbox_offset_y");
+    tuning.fallingHitboxWidth = integer(json, "fallingHitbox_width");
+    tuning.fallingHitboxHeight = integer(json, "fallingHitbox_height");
+    tuning.spinJumpHitboxOffsetX = integer(json, "spinJumpHitbox_offset_x");
+    tuning.spinJumpHitboxOffsetY = integer(json, "spinJumpHitbox_offset_y");
+    tuning.spinJumpHitboxWidth = integer(json, "spinJumpHitbox_width");
+    tuning.spinJumpHitboxHeight = integer(json, "spinJumpHitbox_height");
+    tuning.morphBallHitboxOffsetX = integer(json, "morphBallHitbox_offset_x");
+    tuning.morphBallHitboxOffsetY = integer(json, "morphBallHitbox_offset_y");
+    tuning.morphBallHitboxWidth = integer(json, "morphBallHitbox_width");
+    tuning.morphBallHitboxHeight = integer(json, "morphBallHitbox_height");
+    tuning.speedRetainWindow = number(json, "speedRetainWindow");
+    tuning.speedRetainWallJumpBonusWindow = number(json, "speedRetainWallJumpBonusWindow");
+    tuning.preJumpWindow = number(json, "preJumpWindow");
+    tuning.jumpPower = number(json, "jumpPower");
+    tuning.jumpTimeMax = number(json, "jumpTimeMax");
+    tuning.jumpFall = number(json, "jumpFall");
+    tuning.postJumpBoost = number(json, "postJumpBoost");
+    tuning.morphJumpPower = number(json, "morphJumpPower");
+    tuning.morphJumpTimeMax = number(json, "morphJumpTimeMax");
+    tuning.morphJumpFall = number(json, "morphJumpFall");
+    tuning.morphPostJumpBoost = number(json, "morphPostJumpBoost");
+    tuning.wallJumpPowerY = number(json, "wallJumpPower_y");
+    tuning.wallJumpPowerX = number(json, "wallJumpPower_x");
+    tuning.wallFriction = number(json, "wallFriction");
+    tuning.slowcap = number(json, "slowcap");
+    tuning.switchDelay = number(json, "switchDelay");
+    tuning.shootTime = number(json, "shootTime");
+    tuning.contactKB = number(json, "contactKB");
+    tuning.lagTime = number(json, "lagTime");
+    tuning.dashTime = number(json, "dashTime");
+    tuning.dashAirCooldown = number(json, "dashAirCooldown");
+    tuning.dashGroundCooldown = number(json, "dashGroundCooldown");
+    tuning.dashBaseSpeed = number(json, "dashBaseSpeed");
+    tuning.dashBonus = number(json, "dashBonus");
+    tuning.dashBaseEndingSpeed = number(json, "dashBaseEndingSpeed");
+    tuning.dashBaseEndingUpSpeed = number(json, "dashBaseEndingUpSpeed");
+
+    tuning.hitboxes[SamosStates::Stand] = CollisionBox(integer(json, "offset_x"), integer(json, "offset_y"), integer(json, "width"), integer(json, "height"));
+    tuning.hitboxes[SamosStates::Crouch] = CollisionBox(tuning.crouchHitboxOffsetX, tuning.crouchHitboxOffsetY, tuning.crouchHitboxWidth, tuning.crouchHitboxHeight);
+    tuning.hitboxes[SamosStates::Fall] = CollisionBox(tuning.fallingHitboxOffsetX, tuning.fallingHitboxOffsetY, tuning.fallingHitboxWidth, tuning.fallingHitboxHeight);
+    tuning.hitboxes[SamosStates::Spin] = CollisionBox(tuning.spinJumpHitboxOffsetX, tuning.spinJumpHitboxOffsetY, tuning.spinJumpHitboxWidth, tuning.spinJumpHitboxHeight);
+    tuning.hitboxes[SamosStates::Morph] = CollisionBox(tuning.morphBallHitboxOffsetX, tuning.morphBallHitboxOffsetY, tuning.morphBallHitboxWidth, tuning.morphBallHitboxHeight);
+
+    int left = tuning.hitboxes[0].getX();
+    int top = tuning.hitboxes[0].getY();
+    int right = left + tuning.hitboxes[0].getWidth();
+    int bottom = top + tuning.hitboxes[0].getHeight();
+    for (unsigned int stance = 1; stance < SamosStates::stanceCount; stance++) {
+        CollisionBox &box = tuning.hitboxes[stance];
+        left = std::min(left, box.getX());
+        top = std::min(top, box.getY());
+        right = std::max(right, box.getX() + box.getWidth());
+        bottom = std::max(bottom, box.getY() + box.getHeight());
+    }
+    tuning.stanceBounds = CollisionBox(left, top, right - left, bottom - top);
+    return tuning;
+}
+
+std::vector<Archetype*> ArchetypeRegistry::archetypes;
+std::unordered_map<std::string, unsigned int> ArchetypeRegistry::ids;
+
+void ArchetypeRegistry::compile(const nlohmann::json &values)
+{
+    // The textures may have changed, the animations are built again when needed
+    AnimationCache::clear();
+
+    const nlohmann::json noJson = nlohmann::json::object();
+    const nlohmann::json &names = values.contains("names") ? values["names"] : noJson;
+    const nlohmann::json &textures = values.contains("textures") ? values["textures"] : noJson;
+    const nlohmann::json &defaults = (values.contains("general") && values["general"].contains("defaultAnimationValues"))
+            ? values["general"]["defaultAnimationValues"] : noJson;
+
+    for (auto entry : names.items()) {
+        const nlohmann::json &json = entry.value();
+        Archetype a;
+        a.name = entry.key();
+        a.type = EntityIds::entityType(text(json, "type"));
+        a.texture = text(json, "texture");
+        a.defaultState = EntityIds::state(text(json, "defaultState", "None"));
+        if (json.contains("randomTexture") && json["randomTexture"].is_array())
+            for (const nlohmann::json &state : json["randomTexture"])
+                a.randomTexture.push_back(EntityIds::state(state.get<std::string>()));
+
+        a.offsetX = integer(json, "offset_x");
+        a.offsetY = integer(json, "offset_y");
+        a.width = integer(json, "width");
+        a.height = integer(json, "height");
+        a.layer = number(json, "layer");
+        a.gravity = boolean(json, "gravity");
+        a.movable = boolean(json, "movable");
+        a.friction = number(json, "friction");
+        a.mass = number(json, "mass");
+
+        a.health = integer(json, "health");
+        a.maxHealth = integer(json, "maxHealth");
+        a.invulnerable = boolean(json, "invulnerable");
+        a.iTime = number(json, "iTime");
+        a.damage = integer(json, "damage");
+
+        a.behavior = text(json, "behavior");
+        a.damageOnContact = boolean(json, "damageOnContact");
+        a.attackSpeed = number(json, "attackSpeed");
+        a.ranged = boolean(json, "ranged");
+
+        a.npcType = text(json, "npcType");
+
+        a.speed = number(json, "speed");
+        a.lifeTime = number(json, "lifeTime");
+        a.knockback = number(json, "knockback");
+        a.hitOffsetX = integer(json, "hit_offset_x");
+        a.hitOffsetY = integer(json, "hit_offset_y");
+        a.hitWidth = integer(json, "hit_width");
+        a.hitHeight = integer(json, "hit_height");
+
+        if (a.type == EntityType::Samos)
+            a.samos = compileSamosTuning(json);
+
+        a.defaultClip = compileClip(State::None, nlohmann::json(), defaults);
+        if (textures.contains(a.texture))
+            for (auto state : textures[a.texture].items()) {
+                AnimationClip clip = compileClip(EntityIds::state(state.key()), state.value(), defaults);
+                clip.id = a.clips.size();
+                if (a.stateClips.size() <= clip.state)
+                    a.stateClips.resize(clip.state + 1, -1);
+                a.stateClips[clip.state] = clip.id;
+                a.clips.push_back(clip);
+            }
+
+        a.json = json;
+
+        std::unordered_map<std::string, unsigned int>::iterator known = ids.find(a.name);
+        if (known == ids.end()) {
+            a.id = archetypes.size();
+            ids[a.name] = a.id;
+            archetypes.push_back(new Archetype(a));
+        } else {
+            a.id = known->second;
+            *archetypes[a.id] = a;
+        }
+    }
+}
+
+const Archetype *ArchetypeRegistry::get(const std::string &name)
+{
+    std::unordered_map<std::string, unsigned int>::const_iterator id = ids.find(name);
+    if (id == ids.end())
+        return nullptr;
+    return archetypes[id->second];
+}
+
+const Archetype *ArchetypeRegistry::get(unsigned int id)
+{
+    if (id >= archetypes.size())
+        return nullptr;
+    return archetypes[id];
+}
+
+unsigned int ArchetypeRegistry::getCount()
+{
+    return archetypes.size();
+}
+
+const AnimationClip &Archetype::getClip(StateId state) const
+{
+    if (state >= stateClips.size() || stateClips[state] < 0)
+        return defaultClip;
+    return clips[stateClips[state]];
+}
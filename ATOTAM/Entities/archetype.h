@@ -0,0 +1,176 @@
+#ifndef ARCHETYPE_H
+#define ARCHETYPE_H
+
+#define JSON_DIAGNOSTICS 1 // Json extended error messages
+#include "../nlohmann/json.hpp"
+#include "collisionbox.h"
+#include "entityids.h"
+#include "samosstates.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One animation of a texture, with the default animation values already applied
+struct AnimationClip
+{
+    unsigned int id = 0; // Index in the Archetype's clips
+    StateId state = State::None;
+    std::string file = "";
+    int x = 0; // in px
+    int y = 0; // in px
+    int width = 1; // in px
+    int height = 1; // in px
+    unsigned int count = 1; // Number of frames
+    int emptyFrames = 0;
+    bool emptyFramesReversed = false;
+    int lines = 1;
+    bool multiDirectional = false;
+    int xOffset[2] = {0, 0}; // When facing left, then right
+    int yOffset[2] = {0, 0}; // When facing left, then right
+    bool reversed = false;
+    std::vector<StateId> overlay; // States of the clips drawn on top of this one
+    bool loop = false;
+    int refreshRate = -1; // Frames between two animation frames, no animation if not positive
+    bool dontReset = false;
+};
+
+// Samos movement values
+struct SamosTuning
+{
+    double fastFriction = 0;
+    double superFastFriction = 0;
+    double movingFriction = 0;
+    double movingFastFriction = 0;
+    double movingSuperFastFriction = 0;
+    double groundAcceleration = 0;
+    double groundMaxSpeed = 0;
+    double groundRunAcceleration = 0;
+    double groundRunMaxSpeedGap = 0;
+    double groundRunMaxSpeed = 0;
+    double airAcceleration = 0;
+    double airMaxSpeed = 0;
+    double morphGroundAcceleration = 0;
+    double morphGroundMaxSpeed = 0;
+    double morphAirAcceleration = 0;
+    double morphAirMaxSpeed = 0;
+    int crouchHitboxOffsetX = 0;
+    int crouchHitboxOffsetY = 0;
+    int crouchHitboxWidth = 0;
+    int crouchHitboxHeight = 0;
+    int fallingHitboxOffsetX = 0;
+    int fallingHitboxOffsetY = 0;
+    int fallingHitboxWidth = 0;
+    int fallingHitboxHeight = 0;
+    int spinJumpHitboxOffsetX = 0;
+    int spinJumpHitboxOffsetY = 0;
+    int spinJumpHitboxWidth = 0;
+    int spinJumpHitboxHeight = 0;
+    int morphBallHitboxOffsetX = 0;
+    int morphBallHitboxOffsetY = 0;
+    int morphBallHitboxWidth = 0;
+    int morphBallHitboxHeight = 0;
+    CollisionBox hitboxes[SamosStates::stanceCount]; // Hitbox of each SamosStates::Stance
+    CollisionBox stanceBounds; // Smallest box containing every hitbox
+    double speedRetainWindow = 0;
+    double speedRetainWallJumpBonusWindow = 0;
+    double preJumpWindow = 0;
+    double jumpPower = 0;
+    double jumpTimeMax = 0;
+    double jumpFall = 0;
+    double postJumpBoost = 0;
+    double morphJumpPower = 0;
+    double morphJumpTimeMax = 0;
+    double morphJumpFall = 0;
+    double morphPostJumpBoost = 0;
+    double wallJumpPowerY = 0;
+    double wallJumpPowerX = 0;
+    double wallFriction = 0;
+    double slowcap = 0;
+    double switchDelay = 0;
+    double shootTime = 0;
+    double contactKB = 0;
+    double lagTime = 0;
+    double dashTime = 0;
+    double dashAirCooldown = 0;
+    double dashGroundCooldown = 0;
+    double dashBaseSpeed = 0;
+    double dashBonus = 0;
+    double dashBaseEndingSpeed = 0;
+    double dashBaseEndingUpSpeed = 0;
+};
+
+// Everything entities.json says about an entity name, compiled into typed fields.
+// Values that aren't read on the frame path are only kept in 'json'
+struct Archetype
+{
+    unsigned int id = 0;
+    std::string name = "";
+    EntityType type = EntityType::Null;
+    std::string texture = "";
+    StateId defaultState = State::None;
+    std::vector<StateId> randomTexture; // States among which a stateless entity picks its texture
+
+    int offsetX = 0; // in px
+    int offsetY = 0; // in px
+    int width = 0; // in px
+    int height = 0; // in px
+    float layer = 0.0;
+    bool gravity = false;
+    bool movable = false;
+    double friction = 0.0;
+    double mass = 0.0;
+
+    // Living
+    int health = 0;
+    int maxHealth = 0;
+    bool invulnerable = false;
+    double iTime = 0.0; // Invulnerability given to the entity hit by this one, in s
+    int damage = 0;
+
+    // Monster
+    std::string behavior = "";
+    bool damageOnContact = false;
+    double attackSpeed = 0.0;
+    bool ranged = false;
+
+    // NPC
+    std::string npcType = "";
+
+    // Projectile
+    double speed = 0.0;
+    double lifeTime = 0.0;
+    double knockback = 0.0;
+    int hitOffsetX = 0; // in px
+    int hitOffsetY = 0; // in px
+    int hitWidth = 0; // in px
+    int hitHeight = 0; // in px
+
+    SamosTuning samos; // Only filled for Samos
+
+    std::vector<AnimationClip> clips;
+    std::vector<int> stateClips; // Clip index by StateId, -1 if the texture doesn't have the state
+    AnimationClip defaultClip; // Returned for unknown states, like the default animation values
+
+    nlohmann::json json; // Copy of the entities.json node
+
+    const AnimationClip &getClip(StateId state) const;
+};
+
+// Compiles entities.json once, so that the game never has to index it on the frame path
+class ArchetypeRegistry
+{
+public:
+    // Compiles the names and textures of 'values'. Already known names keep their Archetype
+    // (and its address), so it can be called again when entities.json is reloaded
+    static void compile(const nlohmann::json &values);
+    static const Archetype *get(const std::string &name); // nullptr if the name is unknown
+    static const Archetype *get(unsigned int id);
+    static unsigned int getCount();
+
+private:
+    static std::vector<Archetype*> archetypes;
+    static std::unordered_map<std::string, unsigned int> ids;
+};
+
+#endif // ARCHETYPE_H
@@ -1,17 +1,17 @@
 #include "area.h"
 
 Area::Area(double x, double y, CollisionBox* box, QImage* texture, std::string name)
-    : Entity(x, y, box, texture, "Area", false, "None", 0.0, name, false)
+    : Entity(x, y, box, texture, EntityType::Area, false, Facing::None, 0.0, name, false)
 {
-    setLastFrameFacing("None");
+    setLastFrameFacing(Facing::None);
 }
 
 Area::Area(double x, double y, std::string name) :
-    Entity(x, y, "None", name)
+    Entity(x, y, Facing::None, name)
 {
-    setLastFrameFacing("None");
-    setLastFrameState("None");
-    setState("Normal");
+    setLastFrameFacing(Facing::None);
+    setLastFrameState(State::None);
+    setState(State::Normal);
 }
 
 Area::Area(const Area &area)
@@ -0,0 +1,109 @@
+#include "bodystore.h"
+
+#include <cstring>
+#include <stdexcept>
+
+BodyStore::Chunk* BodyStore::chunks[BodyStore::maxChunks] = {};
+unsigned int BodyStore::chunkCount = 0;
+unsigned int BodyStore::bodyCount = 0;
+BodyStore::Handle BodyStore::nextHandle = 0;
+std::vector<BodyStore::Handle> BodyStore::freeHandles;
+std::mutex BodyStore::mutex;
+
+BodyStore::Handle BodyStore::create(double x, double y)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Handle h;
+    if (!freeHandles.empty()) {
+        h = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        h = nextHandle;
+        if (h / chunkSize >= chunkCount) {
+            if (chunkCount == maxChunks)
+                throw std::length_error("BodyStore is full");
+            // Chunks are never freed nor moved: handles and box pointers stay valid
+            chunks[chunkCount++] = new Chunk();
+        }
+        nextHandle++;
+    }
+
+    Chunk* c = chunks[h / chunkSize];
+    unsigned int i = h % chunkSize;
+    c->x[i] = x;
+    c->y[i] = y;
+    c->vX[i] = 0;
+    c->vY[i] = 0;
+    // A new body isn't interpolated from wherever the previous owner of the slot was
+    c->previousX[i] = x;
+    c->previousY[i] = y;
+    c->box[i] = CollisionBox();
+    c->groundBox[i] = CollisionBox();
+    c->flags[i] = alive;
+    bodyCount++;
+    return h;
+}
+
+void BodyStore::destroy(Handle h)
+{
+    if (h == invalidHandle)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    chunks[h / chunkSize]->flags[h % chunkSize] = 0;
+    freeHandles.push_back(h);
+    bodyCount--;
+}
+
+void BodyStore::storePreviousPositions()
+{
+    // Locked: the room streamer may be adding a chunk or setting up a new body meanwhile
+    std::lock_guard<std::mutex> lock(mutex);
+    // Dead slots are copied too, it is cheaper than checking their flags
+    for (unsigned int i = 0; i < chunkCount; i++) {
+        std::memcpy(chunks[i]->previousX, chunks[i]->x, sizeof(chunks[i]->x));
+        std::memcpy(chunks[i]->previousY, chunks[i]->y, sizeof(chunks[i]->y));
+    }
+}
+
+void BodyStore::setBox(Handle h, const CollisionBox &newBox)
+{
+    Chunk* c = chunkOf(h);
+    c->box[h % chunkSize] = newBox;
+    c->flags[h % chunkSize] |= hasBox;
+}
+
+void BodyStore::removeBox(Handle h)
+{
+    chunkOf(h)->flags[h % chunkSize] &= ~hasBox;
+}
+
+void BodyStore::setGroundBox(Handle h, const CollisionBox &newGroundBox)
+{
+    Chunk* c = chunkOf(h);
+    c->groundBox[h % chunkSize] = newGroundBox;
+    c->flags[h % chunkSize] |= hasGroundBox;
+}
+
+void BodyStore::removeGroundBox(Handle h)
+{
+    chunkOf(h)->flags[h % chunkSize] &= ~hasGroundBox;
+}
+
+unsigned int BodyStore::getBodyCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return bodyCount;
+}
+
+std::size_t BodyStore::getSlotBytes()
+{
+    return sizeof(Chunk) / chunkSize;
+}
+
+unsigned int BodyStore::getCapacity()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return chunkCount * chunkSize;
+}
@@ -0,0 +1,151 @@
+#ifndef BODYSTORE_H
+#define BODYSTORE_H
+
+#include "collisionbox.h"
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Structure of arrays holding the physical state of every Entity: position, velocity, collision boxes and flags.
+// Entities only keep a handle to their body. Bodies are allocated in fixed size chunks that never move,
+// so an entity can be created on the room loading thread while the game thread reads other bodies.
+// create, destroy, storePreviousPositions, getBodyCount and getCapacity lock 'mutex' and can be called while
+// another thread loads a room. The other accessors don't lock: a body is only read and written by the thread
+// owning its entity, the loading thread only sets the position of its bodies through create
+class BodyStore
+{
+public:
+    typedef unsigned int Handle;
+    static const Handle invalidHandle = static_cast<Handle>(-1);
+    static const unsigned int chunkSize = 1024;
+    static const unsigned int maxChunks = 1024;
+
+    enum Flags : unsigned char {
+        alive = 1,
+        hasBox = 2,
+        hasGroundBox = 4
+    };
+
+    static Handle create(double x, double y);
+    static void destroy(Handle h);
+
+    static double getX(Handle h);
+    static void setX(Handle h, double newX);
+    static double getY(Handle h);
+    static void setY(Handle h, double newY);
+    static double getVX(Handle h);
+    static void setVX(Handle h, double newVX);
+    static double getVY(Handle h);
+    static void setVY(Handle h, double newVY);
+    // Position interpolated between the previous simulation step (alpha = 0) and the current one (alpha = 1)
+    static double getRenderX(Handle h, double alpha);
+    static double getRenderY(Handle h, double alpha);
+    // Remembers the position of every body, called before each simulation step
+    static void storePreviousPositions();
+
+    // Returns nullptr if the body has no box. The pointer stays valid until the body is destroyed
+    static CollisionBox *getBox(Handle h);
+    static void setBox(Handle h, const CollisionBox &newBox);
+    static void removeBox(Handle h);
+    static CollisionBox *getGroundBox(Handle h);
+    static void setGroundBox(Handle h, const CollisionBox &newGroundBox);
+    static void removeGroundBox(Handle h);
+
+    static unsigned int getBodyCount(); // Number of living bodies
+    static unsigned int getCapacity(); // Number of allocated body slots
+    static std::size_t getSlotBytes(); // Memory taken by one body
+
+private:
+    struct Chunk {
+        double x[chunkSize];
+        double y[chunkSize];
+        double vX[chunkSize];
+        double vY[chunkSize];
+        double previousX[chunkSize]; // Position before the last simulation step, for rendering
+        double previousY[chunkSize];
+        CollisionBox box[chunkSize];
+        CollisionBox groundBox[chunkSize];
+        unsigned char flags[chunkSize];
+    };
+
+    static Chunk *chunkOf(Handle h);
+
+    static Chunk* chunks[maxChunks];
+    static unsigned int chunkCount;
+    static unsigned int bodyCount;
+    static Handle nextHandle; // First never used slot
+    static std::vector<Handle> freeHandles; // Slots of destroyed bodies, reused first
+    static std::mutex mutex; // Guards the slots list, the counts and the positions copied by storePreviousPositions
+};
+
+inline BodyStore::Chunk *BodyStore::chunkOf(Handle h)
+{
+    return chunks[h / chunkSize];
+}
+
+inline double BodyStore::getX(Handle h)
+{
+    return chunkOf(h)->x[h % chunkSize];
+}
+
+inline void BodyStore::setX(Handle h, double newX)
+{
+    chunkOf(h)->x[h % chunkSize] = newX;
+}
+
+inline double BodyStore::getY(Handle h)
+{
+    return chunkOf(h)->y[h % chunkSize];
+}
+
+inline void BodyStore::setY(Handle h, double newY)
+{
+    chunkOf(h)->y[h % chunkSize] = newY;
+}
+
+inline double BodyStore::getVX(Handle h)
+{
+    return chunkOf(h)->vX[h % chunkSize];
+}
+
+inline void BodyStore::setVX(Handle h, double newVX)
+{
+    chunkOf(h)->vX[h % chunkSize] = newVX;
+}
+
+inline double BodyStore::getVY(Handle h)
+{
+    return chunkOf(h)->vY[h % chunkSize];
+}
+
+inline void BodyStore::setVY(Handle h, double newVY)
+{
+    chunkOf(h)->vY[h % chunkSize] = newVY;
+}
+
+inline double BodyStore::getRenderX(Handle h, double alpha)
+{
+    Chunk* c = chunkOf(h);
+    return c->previousX[h % chunkSize] + (c->x[h % chunkSize] - c->previousX[h % chunkSize]) * alpha;
+}
+
+inline double BodyStore::getRenderY(Handle h, double alpha)
+{
+    Chunk* c = chunkOf(h);
+    return c->previousY[h % chunkSize] + (c->y[h % chunkSize] - c->previousY[h % chunkSize]) * alpha;
+}
+
+inline CollisionBox *BodyStore::getBox(Handle h)
+{
+    Chunk* c = chunkOf(h);
+    return (c->flags[h % chunkSize] & hasBox) ? &c->box[h % chunkSize] : nullptr;
+}
+
+inline CollisionBox *BodyStore::getGroundBox(Handle h)
+{
+    Chunk* c = chunkOf(h);
+    return (c->flags[h % chunkSize] & hasGroundBox) ? &c->groundBox[h % chunkSize] : nullptr;
+}
+
+#endif // BODYSTORE_H
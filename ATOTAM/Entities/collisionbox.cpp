@@ -1,5 +1,10 @@
 #include "collisionbox.h"
 
+CollisionBox::CollisionBox()
+{
+
+}
+
 CollisionBox::CollisionBox(int x, int y, int width, int height) : x(x), y(y), width(width), height(height)
 {
 
@@ -5,6 +5,7 @@
 class CollisionBox
 {
 public:
+    CollisionBox();
     CollisionBox(int x, int y, int width, int height);
     CollisionBox(int width, int height);
 
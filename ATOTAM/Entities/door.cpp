@@ -4,7 +4,7 @@ Door::Door(double x, double y, std::string name)
     : Area(x, y, name)
 {
     setAreaType("Door");
-    setState(Entity::values["names"][name]["defaultState"]);
+    setState(getArchetype()->defaultState);
     setLastFrameState(getState());
 }
 
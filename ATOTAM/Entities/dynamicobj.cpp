@@ -1,6 +1,6 @@
 #include "dynamicobj.h"
 
-DynamicObj::DynamicObj(double x, double y, std::string facing, std::string name)
+DynamicObj::DynamicObj(double x, double y, Facing facing, std::string name)
     : Living(x, y, facing, name)
 {
 
@@ -6,7 +6,7 @@
 class DynamicObj : public Living
 {
 public:
-    DynamicObj(double x, double y, std::string facing, std::string name);
+    DynamicObj(double x, double y, Facing facing, std::string name);
     const std::string &getMaterial() const;
     void setMaterial(const std::string &newMaterial);
 
@@ -1,9 +1,14 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
+#include "animationcache.h"
+#include "archetype.h"
+#include "bodystore.h"
 #include "collisionbox.h"
+#include "entityids.h"
 #include <QImage>
 #include <QString>
+#include <atomic>
 #include <string>
 #define JSON_DIAGNOSTICS 1 // Json extended error messages
 #include "../nlohmann/json.hpp"
@@ -16,22 +21,25 @@ public:
     static bool checkCollision(Entity* obj1, CollisionBox* box1, Entity* obj2, CollisionBox* box2);
     static void calcCollisionReplacement(Entity* obj1, Entity* obj2);
     static void calcCollisionReplacementAxis(Entity* obj1, Entity* obj2, bool alongY);
-    //enum EntityType {Null, Terrain, Samos, Monster, Area, DynamicObj, NPC, Projectile};
     static const int unknownEntityType = -1;
     static const int invalidDirection = -2;
     static nlohmann::json values;
     static nlohmann::json loadValues(std::string assetsPath);
-    static unsigned long long lastID;
+    static std::atomic<unsigned long long> lastID; // Entities are also created by the room streamer
+    static unsigned long long collisionChecks; // Number of checkCollision calls, reset every frame
 
-    Entity(double x, double y, CollisionBox* box, QImage* texture, std::string entType, bool isAffectedByGravity, std::string facing, double frictionFactor, std::string name, bool isMovable);
-    Entity(double x, double y, std::string facing, std::string name);
+    Entity(double x, double y, CollisionBox* box, QImage* texture, EntityType entType, bool isAffectedByGravity, Facing facing, double frictionFactor, std::string name, bool isMovable);
+    Entity(double x, double y, Facing facing, std::string name);
     Entity(const Entity&);
     Entity();
     virtual ~Entity();
+    Entity &operator=(const Entity&) = delete; // Two entities can't share a body
+    static void *operator new(std::size_t size); // In the RoomArena of the room being loaded on this thread, if any
+    static void operator delete(void *p);
 
     void updateTexture();
-    std::vector<QImage> updateAnimation(std::string state, std::pair<int, int> repeat);
-    std::vector<QImage> updateAnimation(); // Updates animation using entity's values
+    AnimationCache::Frames updateAnimation(StateId state, std::pair<int, int> repeat); // Shared by every entity with the same animation
+    AnimationCache::Frames updateAnimation(); // Updates animation using entity's values
     void updateV(double framerate);
     void applyKnockback(Entity *e, double kBForce);
     void forceKnockback(Entity *e, double kBForce);
@@ -40,8 +48,13 @@ public:
     virtual void setJsonValues(nlohmann::json);
 
     CollisionBox *getBox();
-    void setBox(CollisionBox *newBox);
-    void setBoxNoDel(CollisionBox *newBox);
+    void setBox(CollisionBox *newBox); // Takes ownership of newBox, nullptr removes the box
+    void setBox(const CollisionBox &newBox);
+    void removeBox();
+
+    BodyStore::Handle getBody() const;
+
+    const Archetype *getArchetype() const; // nullptr if the name isn't in entities.json
 
     double getX() const;
     void setX(double newX);
@@ -49,8 +62,12 @@ public:
     double getY() const;
     void setY(double newY);
 
-    QImage *getTexture() const;
-    void setTexture(QImage *newTexture);
+    // Position between the last two simulation steps, see BodyStore::getRenderX
+    double getRenderX(double alpha) const;
+    double getRenderY(double alpha) const;
+
+    const QImage *getTexture() const;
+    void setTexture(const QImage *newTexture);
 
     double getVX() const;
     void setVX(double newVX);
@@ -61,8 +78,9 @@ public:
     bool getIsAffectedByGravity() const;
     void setIsAffectedByGravity(bool newIsAffectedByGravity);
 
-    std::string getFacing() const;
-    void setFacing(std::string newFacing);
+    Facing getFacing() const;
+    void setFacing(Facing newFacing);
+    const std::string &getFacingName() const; // For json and the editor
 
     double getFrictionFactor() const;
     void setFrictionFactor(double newFrictionFactor);
@@ -70,26 +88,29 @@ public:
     const std::string &getName() const;
     void setName(const std::string &newName);
 
-    std::string getEntType() const;
-    void setEntType(std::string newEntType);
+    EntityType getEntType() const;
+    void setEntType(EntityType newEntType);
+    const std::string &getEntTypeName() const; // For json and the editor
 
     unsigned int getFrame() const;
     void setFrame(unsigned int newFrame);
 
-    const std::string &getState() const;
-    void setState(const std::string &newState);
+    StateId getState() const;
+    void setState(StateId newState);
+    const std::string &getStateName() const; // For json and the editor
 
-    const std::string &getLastFrameState() const;
-    void setLastFrameState(const std::string &newLastFrameState);
+    StateId getLastFrameState() const;
+    void setLastFrameState(StateId newLastFrameState);
 
     const std::vector<QImage> &getCurrentAnimation() const;
-    void setCurrentAnimation(const std::vector<QImage> &newCurrentAnimation);
+    const AnimationCache::Frames &getCurrentAnimationFrames() const; // Only held by this entity when built for its random texture
+    void setCurrentAnimation(const AnimationCache::Frames &newCurrentAnimation);
 
     bool getIsMovable() const;
     void setIsMovable(bool newIsMovable);
 
-    const std::string &getLastFrameFacing() const;
-    void setLastFrameFacing(const std::string &newLastFrameFacing);
+    Facing getLastFrameFacing() const;
+    void setLastFrameFacing(Facing newLastFrameFacing);
 
     double getMass() const;
     void setMass(double newMass);
@@ -115,16 +136,13 @@ public:
     void setLayer(float newLayer);
 
 private:
-    CollisionBox* box = nullptr;
-    QImage* texture = nullptr; // Image to be rendered now
-    double x = 0; //in px
-    double y = 0; //in px
-    double vX = 0; //in px/s
-    double vY = 0; //in px/s
-    std::string entType = "";
+    BodyStore::Handle body = BodyStore::invalidHandle; // Position (in px), velocity (in px/s) and boxes
+    const Archetype *archetype = nullptr; // Compiled entities.json values of 'name'
+    const QImage* texture = nullptr; // Image to be rendered now, in 'currentAnimation' or owned by the renderer
+    EntityType entType = EntityType::Null;
     bool isAffectedByGravity = true;
-    std::string facing = "Right";
-    std::string lastFrameFacing = "Right";
+    Facing facing = Facing::Right;
+    Facing lastFrameFacing = Facing::Right;
     double frictionFactor = 1;
     bool isMovable = true;
     std::string name = "";
@@ -137,9 +155,9 @@ private:
 
     // Rendering
     unsigned int frame = 0;
-    std::vector<QImage> currentAnimation; // Full current animation
-    std::string state = "None"; // Which animation should be rendered
-    std::string lastFrameState = "None"; // Which animation was rendered in the last frame
+    AnimationCache::Frames currentAnimation = AnimationCache::empty(); // Full current animation, owned by the AnimationCache
+    StateId state = State::None; // Which animation should be rendered
+    StateId lastFrameState = State::None; // Which animation was rendered in the last frame
     std::string roomId = "0"; // ID of the room in which this Entity is
     float layer = 0.0; //The bigger layer the later the entity is drawn
 };
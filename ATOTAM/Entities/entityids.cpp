@@ -0,0 +1,92 @@
+#include "entityids.h"
+
+static const std::string entityTypeNames[] = {"", "Terrain", "Samos", "Monster", "Area", "DynamicObj", "NPC", "Projectile"};
+static const std::string facingNames[] = {"None", "Up", "UpRight", "Right", "DownRight", "Down", "DownLeft", "Left", "UpLeft"};
+// Same order as the State enum
+static const char *knownStateNames[] = {
+    "None", "Normal", "Hit", "Death",
+    "Up", "UpRight", "Right", "DownRight", "Down", "DownLeft", "Left", "UpLeft",
+    "Standing", "StandingAimUp", "StandingAimUpDiag", "StandingAimDownDiag",
+    "Walking", "WalkingAimForward", "WalkingAimUp", "WalkingAimDown",
+    "Running", "RunningAimForward", "RunningAimUp", "RunningAimDown",
+    "Crouching", "IdleCrouch", "CrouchAimUp", "CrouchAimUpDiag", "CrouchAimDownDiag", "UnCrouching",
+    "Jumping", "JumpEnd", "SpinJump", "WallJump", "Landing",
+    "Falling", "FallingAimUp", "FallingAimUpDiag", "FallingAimDown", "FallingAimDownDiag",
+    "Dash", "DashUp", "DashUpDiag", "DashDown", "DashDownDiag",
+    "MorphBalling", "UnMorphBalling", "MorphBall", "MorphBallDash", "MorphBallSlow", "MorphBallSuperSlow", "MorphBallStop",
+    "Uncrouching", "morphBalling"
+};
+static_assert(sizeof(knownStateNames) / sizeof(knownStateNames[0]) == State::knownCount, "knownStateNames doesn't match the State enum");
+
+std::deque<std::string> EntityIds::stateNames;
+std::unordered_map<std::string, StateId> EntityIds::stateIds;
+std::mutex EntityIds::stateMutex;
+
+EntityType EntityIds::entityType(const std::string &name)
+{
+    for (unsigned int i = 1; i < sizeof(entityTypeNames) / sizeof(entityTypeNames[0]); i++)
+        if (entityTypeNames[i] == name)
+            return static_cast<EntityType>(i);
+    return EntityType::Null;
+}
+
+const std::string &EntityIds::entityTypeName(EntityType type)
+{
+    return entityTypeNames[static_cast<int>(type)];
+}
+
+Facing EntityIds::facing(const std::string &name)
+{
+    for (unsigned int i = 1; i < sizeof(facingNames) / sizeof(facingNames[0]); i++)
+        if (facingNames[i] == name)
+            return static_cast<Facing>(i);
+    return Facing::None;
+}
+
+const std::string &EntityIds::facingName(Facing facing)
+{
+    return facingNames[static_cast<int>(facing)];
+}
+
+StateId EntityIds::state(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    registerKnownStates();
+
+    std::unordered_map<std::string, StateId>::const_iterator id = stateIds.find(name);
+    if (id != stateIds.end())
+        return id->second;
+
+    StateId newId = static_cast<StateId>(stateNames.size());
+    stateNames.push_back(name);
+    stateIds[name] = newId;
+    return newId;
+}
+
+const std::string &EntityIds::stateName(StateId state)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    registerKnownStates();
+
+    if (state >= stateNames.size())
+        return stateNames[State::None];
+    return stateNames[state];
+}
+
+unsigned int EntityIds::getStateCount()
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    registerKnownStates();
+    return stateNames.size();
+}
+
+void EntityIds::registerKnownStates()
+{
+    // Called with stateMutex locked
+    if (!stateNames.empty())
+        return;
+    for (unsigned int i = 0; i < State::knownCount; i++) {
+        stateNames.push_back(knownStateNames[i]);
+        stateIds[knownStateNames[i]] = static_cast<StateId>(i);
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef ENTITYIDS_H
+#define ENTITYIDS_H
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Kind of an Entity, "type" in entities.json
+enum class EntityType : unsigned char {Null, Terrain, Samos, Monster, Area, DynamicObj, NPC, Projectile};
+
+// Direction an Entity faces, a canon aims or a dash goes to
+enum class Facing : unsigned char {None, Up, UpRight, Right, DownRight, Down, DownLeft, Left, UpLeft};
+
+// Interned animation state name
+typedef unsigned short StateId;
+
+// States used by the code, their ids are fixed.
+// The other states of entities.json are appended after them when the archetypes are compiled
+namespace State {
+enum : StateId {
+    None, Normal, Hit, Death,
+    // Facing named states of the projectiles, in the order of Facing
+    Up, UpRight, Right, DownRight, Down, DownLeft, Left, UpLeft,
+    Standing, StandingAimUp, StandingAimUpDiag, StandingAimDownDiag,
+    Walking, WalkingAimForward, WalkingAimUp, WalkingAimDown,
+    Running, RunningAimForward, RunningAimUp, RunningAimDown,
+    Crouching, IdleCrouch, CrouchAimUp, CrouchAimUpDiag, CrouchAimDownDiag, UnCrouching,
+    Jumping, JumpEnd, SpinJump, WallJump, Landing,
+    Falling, FallingAimUp, FallingAimUpDiag, FallingAimDown, FallingAimDownDiag,
+    Dash, DashUp, DashUpDiag, DashDown, DashDownDiag,
+    MorphBalling, UnMorphBalling, MorphBall, MorphBallDash, MorphBallSlow, MorphBallSuperSlow, MorphBallStop,
+    Uncrouching, morphBalling, // Misspelt names the physics has always used, they have no animation
+    knownCount
+};
+}
+
+// String <-> id conversions. Names are only needed to read and write json and in the editor
+class EntityIds
+{
+public:
+    static EntityType entityType(const std::string &name); // EntityType::Null if unknown
+    static const std::string &entityTypeName(EntityType type);
+
+    static Facing facing(const std::string &name); // Facing::None if unknown
+    static const std::string &facingName(Facing facing);
+    static bool isLeft(Facing facing); // Left, UpLeft or DownLeft
+    static bool isRight(Facing facing); // Right, UpRight or DownRight
+
+    static StateId state(const std::string &name); // Interns 'name' if it is new
+    static const std::string &stateName(StateId state);
+    static StateId facingState(Facing facing); // State named after 'facing'
+    static unsigned int getStateCount();
+
+private:
+    static void registerKnownStates();
+
+    static std::deque<std::string> stateNames; // Indexed by StateId, elements never move
+    static std::unordered_map<std::string, StateId> stateIds;
+    static std::mutex stateMutex; // States can be interned by the room loading thread
+};
+
+inline bool EntityIds::isLeft(Facing facing)
+{
+    return facing == Facing::Left || facing == Facing::UpLeft || facing == Facing::DownLeft;
+}
+
+inline bool EntityIds::isRight(Facing facing)
+{
+    return facing == Facing::Right || facing == Facing::UpRight || facing == Facing::DownRight;
+}
+
+inline StateId EntityIds::facingState(Facing facing)
+{
+    return facing == Facing::None ? static_cast<StateId>(State::None)
+                                  : static_cast<StateId>(State::Up + static_cast<int>(facing) - static_cast<int>(Facing::Up));
+}
+
+#endif // ENTITYIDS_H
@@ -1,21 +1,20 @@
 #include "living.h"
 
-Living::Living(double x, double y, CollisionBox* box, QImage* texture, std::string entityType, int health, int maxHealth, bool isAffectedByGravity, std::string facing, double frictionFactor, std::string name, bool isMovable)
+Living::Living(double x, double y, CollisionBox* box, QImage* texture, EntityType entityType, int health, int maxHealth, bool isAffectedByGravity, Facing facing, double frictionFactor, std::string name, bool isMovable)
     : Entity(x, y, box, texture, entityType, isAffectedByGravity, facing, frictionFactor, name, isMovable),
-      health(health), maxHealth(maxHealth), groundBox(new CollisionBox(box->getX(), box->getY() + box->getHeight(), box->getWidth(), 2)), onGround(false)
+      health(health), maxHealth(maxHealth), onGround(false)
 {
-
+    setGroundBox(CollisionBox(getBox()->getX(), getBox()->getY() + getBox()->getHeight(), getBox()->getWidth(), 2));
 }
 
-Living::Living(double x, double y, std::string facing, std::string name)
+Living::Living(double x, double y, Facing facing, std::string name)
     : Entity(x, y, facing, name)
 {
-    //fast constructor using the json file
-    nlohmann::json livJson = values["names"][name];
-    health = livJson["maxHealth"];
-    maxHealth = livJson["maxHealth"];
-    invulnerable = livJson["invulnerable"];
-    groundBox = new CollisionBox(getBox()->getX(), getBox()->getY() + getBox()->getHeight(), getBox()->getWidth(), 1);
+    //fast constructor using the compiled json file
+    health = getArchetype()->maxHealth;
+    maxHealth = getArchetype()->maxHealth;
+    invulnerable = getArchetype()->invulnerable;
+    setGroundBox(CollisionBox(getBox()->getX(), getBox()->getY() + getBox()->getHeight(), getBox()->getWidth(), 1));
 }
 
 Living::Living(const Living &living)
@@ -26,16 +25,13 @@ Living::Living(const Living &living)
 
 Living::~Living()
 {
-    if (groundBox != nullptr) {
-        delete groundBox;
-        groundBox = nullptr;
-    }
+
 }
 
 bool Living::hit(int damage, Entity *origin, double kb, bool forced)
 {
     if (damage != 0)
-        iTime = Entity::values["names"][origin->getName()]["iTime"];
+        iTime = origin->getArchetype() != nullptr ? origin->getArchetype()->iTime : 0.0;
     health -= damage;
     if (origin != nullptr && kb != 0.0) {
         if (forced)
@@ -68,19 +64,22 @@ void Living::setMaxHealth(int newMaxHealth)
 
 CollisionBox *Living::getGroundBox() const
 {
-    return groundBox;
+    return BodyStore::getGroundBox(getBody());
 }
 
 void Living::setGroundBox(CollisionBox *newGroundBox)
 {
-    if (groundBox != nullptr)
-        delete groundBox;
-    groundBox = newGroundBox;
+    if (newGroundBox == nullptr)
+        BodyStore::removeGroundBox(getBody());
+    else {
+        BodyStore::setGroundBox(getBody(), *newGroundBox);
+        delete newGroundBox;
+    }
 }
 
-void Living::setGroundBoxNoDel(CollisionBox *newGroundBox)
+void Living::setGroundBox(const CollisionBox &newGroundBox)
 {
-    groundBox = newGroundBox;
+    BodyStore::setGroundBox(getBody(), newGroundBox);
 }
 
 bool Living::getOnGround() const
@@ -8,8 +8,8 @@ class Living : public Entity
 public:
     //enum State {Idle, Walking, Attacking, Crouching, Jumping, MorphBall};
 
-    Living(double x, double y, CollisionBox* box, QImage* texture, std::string entityType, int health, int maxHealth, bool isAffectedByGravity, std::string facing, double frictionFactor, std::string name, bool isMovable);
-    Living(double x, double y, std::string facing, std::string name);
+    Living(double x, double y, CollisionBox* box, QImage* texture, EntityType entityType, int health, int maxHealth, bool isAffectedByGravity, Facing facing, double frictionFactor, std::string name, bool isMovable);
+    Living(double x, double y, Facing facing, std::string name);
     Living(const Living&);
     ~Living();
 
@@ -22,8 +22,8 @@ public:
     void setMaxHealth(int newMaxHealth);
 
     CollisionBox *getGroundBox() const;
-    void setGroundBox(CollisionBox *newGroundBox);
-    void setGroundBoxNoDel(CollisionBox *newGroundBox);
+    void setGroundBox(CollisionBox *newGroundBox); // Takes ownership of the box
+    void setGroundBox(const CollisionBox &newGroundBox);
 
     bool getOnGround() const;
     void setOnGround(bool newOnGround);
@@ -43,7 +43,6 @@ private:
     bool invulnerable = false;
     double iTime = 0.0;
 
-    CollisionBox *groundBox = nullptr;
     bool onGround = false;
 
     Entity *standingOn = nullptr;
@@ -1,15 +1,14 @@
 #include "monster.h"
 
-Monster::Monster(double x, double y, std::string facing, std::string name)
+Monster::Monster(double x, double y, Facing facing, std::string name)
     : Living(x, y, facing, name)
 {
     // Json initialization
-    nlohmann::json monsterJson = values["names"][name];
-    behavior = monsterJson["behavior"];
-    damage = monsterJson["damage"];
-    damageOnContact = monsterJson["damageOnContact"];
-    attackSpeed = monsterJson["attackSpeed"];
-    ranged = monsterJson["ranged"];
+    behavior = getArchetype()->behavior;
+    damage = getArchetype()->damage;
+    damageOnContact = getArchetype()->damageOnContact;
+    attackSpeed = getArchetype()->attackSpeed;
+    ranged = getArchetype()->ranged;
 }
 
 Monster::Monster(const Monster &m)
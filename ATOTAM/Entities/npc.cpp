@@ -1,10 +1,10 @@
 #include "npc.h"
 
-NPC::NPC(double x, double y, std::string facing, std::string name)
+NPC::NPC(double x, double y, Facing facing, std::string name)
     : Living(x, y, facing, name)
 {
-    json = values["names"][name];
-    npcType = json["npcType"];
+    json = getArchetype()->json;
+    npcType = getArchetype()->npcType;
 }
 
 NPC::NPC(const NPC &n)
@@ -6,7 +6,7 @@
 class NPC : public Living
 {
 public:
-    NPC(double x, double y, std::string facing, std::string name);
+    NPC(double x, double y, Facing facing, std::string name);
     NPC(const NPC&);
     ~NPC();
 
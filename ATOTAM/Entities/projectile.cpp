@@ -1,63 +1,65 @@
 #include "projectile.h"
 
-Projectile::Projectile(double x, double y, std::string facing, std::string type, std::string name, std::string ownerType)
-    : Entity(x, y, nullptr, nullptr, "Projectile", false, facing, 0, name, true), projectileType(type), ownerType(ownerType)
+Projectile::Projectile(double x, double y, Facing facing, std::string type, std::string name, EntityType ownerType)
+    : Entity(x, y, nullptr, nullptr, EntityType::Projectile, false, facing, 0, name, true), projectileType(type), ownerType(ownerType)
 {
     //Because animations are buggy
-    setLastFrameState("None");
-    setLastFrameFacing("None");
+    setLastFrameState(State::None);
+    setLastFrameFacing(Facing::None);
 
-    nlohmann::json proJson = Entity::values["names"][name];
-    setBox(new CollisionBox(proJson["width"], proJson["width"]));
+    const Archetype *proType = getArchetype();
+    if (proType == nullptr)
+        throw unknownProjectileType;
+    setBox(CollisionBox(proType->width, proType->width));
 
     //Setting the speed depending on the direction
-    if (facing == "None") {
+    if (facing == Facing::None) {
         setVX(0);
         setVY(0);
-    } else if (facing == "Up") {
+    } else if (facing == Facing::Up) {
         setVX(0);
-        setVY(-static_cast<double>(proJson["speed"]));
-    } else if (facing == "UpRight") {
-        setVX(static_cast<double>(proJson["speed"]) * 0.707);
-        setVY(-static_cast<double>(proJson["speed"]) * 0.707);
-    } else if (facing == "Right") {
-        setVX(static_cast<double>(proJson["speed"]));
+        setVY(-proType->speed);
+    } else if (facing == Facing::UpRight) {
+        setVX(proType->speed * 0.707);
+        setVY(-proType->speed * 0.707);
+    } else if (facing == Facing::Right) {
+        setVX(proType->speed);
         setVY(0);
-    } else if (facing == "DownRight") {
-        setVX(static_cast<double>(proJson["speed"]) * 0.707);
-        setVY(static_cast<double>(proJson["speed"]) * 0.707);
-    } else if (facing == "Down") {
+    } else if (facing == Facing::DownRight) {
+        setVX(proType->speed * 0.707);
+        setVY(proType->speed * 0.707);
+    } else if (facing == Facing::Down) {
         setVX(0);
-        setVY(static_cast<double>(proJson["speed"]) );
-    } else if (facing == "DownLeft") {
-        setVX(-static_cast<double>(proJson["speed"]) * 0.707);
-        setVY(static_cast<double>(proJson["speed"]) * 0.707);
-    } else if (facing == "Left") {
-        setVX(-static_cast<double>(proJson["speed"]) );
+        setVY(proType->speed );
+    } else if (facing == Facing::DownLeft) {
+        setVX(-proType->speed * 0.707);
+        setVY(proType->speed * 0.707);
+    } else if (facing == Facing::Left) {
+        setVX(-proType->speed );
         setVY(0);
-    } else if (facing == "UpLeft") {
-        setVX(-static_cast<double>(proJson["speed"]) * 0.707);
-        setVY(-static_cast<double>(proJson["speed"]) * 0.707);
+    } else if (facing == Facing::UpLeft) {
+        setVX(-proType->speed * 0.707);
+        setVY(-proType->speed * 0.707);
     } else {
         throw Entity::invalidDirection;
     }
 
     //Setting the damage and adjusting the speed depending on the projectile type
-    damage = proJson["damage"];
-    lifeTime = proJson["lifeTime"];
-    kb = proJson["knockback"];
-    setLayer(proJson["layer"]);
+    damage = proType->damage;
+    lifeTime = proType->lifeTime;
+    kb = proType->knockback;
+    setLayer(proType->layer);
 
     if (type == "Beam") {
-        setState(facing);
+        setState(EntityIds::facingState(facing));
     } else if (type == "Missile") {
-        setState(facing);
+        setState(EntityIds::facingState(facing));
     } else if (type == "Grenade") {
-        setIsAffectedByGravity(proJson["gravity"]);
-        setFrictionFactor(proJson["friction"]);
-        setState(facing);
+        setIsAffectedByGravity(proType->gravity);
+        setFrictionFactor(proType->friction);
+        setState(EntityIds::facingState(facing));
     } else if (type == "Bomb") {
-        setState("Normal");
+        setState(State::Normal);
     } else {
         throw unknownProjectileType;
     }
@@ -65,15 +67,15 @@ Projectile::Projectile(double x, double y, std::string facing, std::string type,
 
 bool Projectile::hitting(Entity* ent)
 {
-    if (getState() != "Hit") {
+    if (getState() != State::Hit) {
         if (getProjectileType() != "Bomb") {
             setLifeTime(0.0);
             setVX(0.0);
             setVY(0.0);
         }
-    } else if (ent->getEntType() == "Samos" || ent->getEntType() == "Monster" || ent->getEntType() == "NPC" || ent->getEntType() == "DynamicObj") {
+    } else if (ent->getEntType() == EntityType::Samos || ent->getEntType() == EntityType::Monster || ent->getEntType() == EntityType::NPC || ent->getEntType() == EntityType::DynamicObj) {
         Living* liv = static_cast<Living*>(ent);
-        if (getProjectileType() != "Bomb" || ent->getEntType() != "Samos") {
+        if (getProjectileType() != "Bomb" || ent->getEntType() != EntityType::Samos) {
             if ((liv->getITime() <= 0.0) && !liv->getInvulnerable()) {
                 return liv->hit(damage, this, kb);
             }
@@ -87,9 +89,9 @@ void Projectile::timeOut()
 {
     setVX(0);
     setVY(0);
-    setState("Hit");
-    nlohmann::json pj = Entity::values["names"][getName()];
-    setBox(new CollisionBox(pj["hit_offset_x"], pj["hit_offset_y"], pj["hit_width"], pj["hit_height"]));
+    setState(State::Hit);
+    const Archetype *proType = getArchetype();
+    setBox(CollisionBox(proType->hitOffsetX, proType->hitOffsetY, proType->hitWidth, proType->hitHeight));
 }
 
 int Projectile::getDamage() const
@@ -132,12 +134,12 @@ void Projectile::setKb(double newKb)
     kb = newKb;
 }
 
-const std::string &Projectile::getOwnerType() const
+EntityType Projectile::getOwnerType() const
 {
     return ownerType;
 }
 
-void Projectile::setOwnerType(const std::string &newOwnerType)
+void Projectile::setOwnerType(EntityType newOwnerType)
 {
     ownerType = newOwnerType;
 }
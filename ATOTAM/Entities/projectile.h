@@ -9,7 +9,7 @@ class Projectile : public Entity
 public:
     static const int unknownProjectileType = -3;
     //enum ProjectileType {Beam, Missile, Grenade, Bomb};
-    Projectile(double x, double y, std::string facing, std::string type, std::string name, std::string ownerType);
+    Projectile(double x, double y, Facing facing, std::string type, std::string name, EntityType ownerType);
 
     bool hitting(Entity* ent);
     void timeOut();
@@ -26,15 +26,15 @@ public:
     double getKb() const;
     void setKb(double newKb);
 
-    const std::string &getOwnerType() const;
-    void setOwnerType(const std::string &newOwnerType);
+    EntityType getOwnerType() const;
+    void setOwnerType(EntityType newOwnerType);
 
 private:
     int damage = 0;
     double kb = 0;
     double lifeTime = 1; // in s, starts with a positive value, destroys the object when null or negative
     std::string projectileType = "";
-    std::string ownerType;;
+    EntityType ownerType = EntityType::Null;
 };
 
 #endif // PROJECTILE_H
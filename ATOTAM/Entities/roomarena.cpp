@@ -0,0 +1,75 @@
+#include "roomarena.h"
+
+#include <new>
+
+thread_local RoomArena *RoomArena::current = nullptr;
+
+RoomArena::Scope::Scope(RoomArena &arena)
+    : previous(current)
+{
+    current = &arena;
+}
+
+RoomArena::Scope::~Scope()
+{
+    current = previous;
+}
+
+RoomArena::RoomArena()
+{
+
+}
+
+RoomArena::~RoomArena()
+{
+    for (std::vector<char*>::iterator block = blocks.begin(); block != blocks.end(); block++)
+        delete[] *block;
+}
+
+void *RoomArena::allocate(std::size_t size)
+{
+    size += headerSize;
+    char *header = static_cast<char*>(current != nullptr ? current->bump(size) : ::operator new(size));
+    *reinterpret_cast<RoomArena**>(header) = current;
+    return header + headerSize;
+}
+
+void RoomArena::release(void *p)
+{
+    if (p == nullptr)
+        return;
+    char *header = static_cast<char*>(p) - headerSize;
+    if (*reinterpret_cast<RoomArena**>(header) == nullptr)
+        ::operator delete(header);
+}
+
+std::size_t RoomArena::getUsedBytes() const
+{
+    return usedBytes;
+}
+
+std::size_t RoomArena::getBlockCount() const
+{
+    return blocks.size();
+}
+
+void *RoomArena::bump(std::size_t size)
+{
+    // Keeps every allocation aligned like the heap would
+    size = (size + headerSize - 1) / headerSize * headerSize;
+    usedBytes += size;
+
+    if (size > blockSize) {
+        // Inserted before the last block, so that its free space can still be used
+        char *block = new char[size];
+        blocks.insert(blocks.empty() ? blocks.end() : blocks.end() - 1, block);
+        return block;
+    }
+    if (blockUsed + size > blockSize) {
+        blocks.push_back(new char[blockSize]);
+        blockUsed = 0;
+    }
+    char *p = blocks.back() + blockUsed;
+    blockUsed += size;
+    return p;
+}
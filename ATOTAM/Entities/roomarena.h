@@ -0,0 +1,54 @@
+#ifndef ROOMARENA_H
+#define ROOMARENA_H
+
+#include <cstddef>
+#include <vector>
+
+// Memory of the entities of one loaded room. While a Scope is open on a thread, every Entity created
+// on it is bumped into the arena's blocks instead of being allocated on its own, and deleting it only
+// runs its destructor. The blocks are all freed at once when the arena is deleted, with the room.
+// Entities created outside of a Scope (Samos, projectiles, the editor's) are allocated on the heap as before
+class RoomArena
+{
+public:
+    static const std::size_t blockSize = 64 * 1024; // in bytes, bigger allocations get a block of their own
+
+    // Makes 'arena' the one the entities created on this thread go into, until destroyed
+    class Scope
+    {
+    public:
+        Scope(RoomArena &arena);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope &operator=(const Scope&) = delete;
+
+    private:
+        RoomArena *previous;
+    };
+
+    RoomArena();
+    ~RoomArena(); // Every entity allocated in it must have been deleted
+    RoomArena(const RoomArena&) = delete;
+    RoomArena &operator=(const RoomArena&) = delete;
+
+    // Used by Entity::operator new and delete
+    static void *allocate(std::size_t size); // In the arena of this thread's Scope, on the heap without one
+    static void release(void *p); // Does nothing for arena memory
+
+    std::size_t getUsedBytes() const;
+    std::size_t getBlockCount() const;
+
+private:
+    // Each allocation starts with the arena owning it, nullptr for the heap, padded to keep the alignment
+    static const std::size_t headerSize = alignof(std::max_align_t);
+
+    void *bump(std::size_t size);
+
+    static thread_local RoomArena *current;
+
+    std::vector<char*> blocks;
+    std::size_t blockUsed = blockSize; // in bytes, in the last block
+    std::size_t usedBytes = 0;
+};
+
+#endif // ROOMARENA_H
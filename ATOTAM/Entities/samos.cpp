@@ -2,36 +2,29 @@
 #include <iostream>
 
 Samos::Samos(double x, double y, int health, int maxHealth, int grenadeCount, int maxGrenadeCount, int missileCount, int maxMissileCount)
-    : Living(x, y, "Right", "Samos"),
+    : Living(x, y, Facing::Right, "Samos"),
       isInAltForm(false), grenadeCount(grenadeCount), maxGrenadeCount(maxGrenadeCount), missileCount(missileCount), maxMissileCount(maxMissileCount),
-      wallBoxR(new CollisionBox(getBox()->getX() + getBox()->getWidth(), getBox()->getY(), 1, getBox()->getHeight())),
-      wallBoxL(new CollisionBox(getBox()->getX() - 1, getBox()->getY(), 1, getBox()->getHeight()))
+      wallBoxR(getBox()->getX() + getBox()->getWidth(), getBox()->getY(), 1, getBox()->getHeight()),
+      wallBoxL(getBox()->getX() - 1, getBox()->getY(), 1, getBox()->getHeight())
 {
     setMaxHealth(maxHealth);
     setHealth(health);
-    setState("Standing");
+    setState(State::Standing);
 }
 
-Samos::Samos(double x, double y, int maxHealth, int maxGrenadeCount, int maxMissileCount, CollisionBox *box, QImage *texture, std::string entityType, int health, bool isAffectedByGravity, std::string facing, double frictionFactor, std::string name, bool isMovable)
+Samos::Samos(double x, double y, int maxHealth, int maxGrenadeCount, int maxMissileCount, CollisionBox *box, QImage *texture, EntityType entityType, int health, bool isAffectedByGravity, Facing facing, double frictionFactor, std::string name, bool isMovable)
     : Living(x, y, box, texture, entityType, health, maxHealth, isAffectedByGravity, facing, frictionFactor, name, isMovable),
       maxGrenadeCount(maxGrenadeCount),
       maxMissileCount(maxMissileCount),
-      wallBoxR(new CollisionBox(box->getX() + box->getWidth(), box->getY(), 1, box->getHeight())),
-      wallBoxL(new CollisionBox(box->getX() - 1, box->getY(), 1, box->getHeight()))
+      wallBoxR(getBox()->getX() + getBox()->getWidth(), getBox()->getY(), 1, getBox()->getHeight()),
+      wallBoxL(getBox()->getX() - 1, getBox()->getY(), 1, getBox()->getHeight())
 {
-    setState("Standing");
+    setState(State::Standing);
 }
 
 Samos::~Samos()
 {
-    if (wallBoxL) {
-        delete wallBoxL;
-        wallBoxL = nullptr;
-    }
-    if (wallBoxR) {
-        delete wallBoxR;
-        wallBoxR = nullptr;
-    }
+
 }
 
 Projectile* Samos::shoot(std::string type)
@@ -52,53 +45,46 @@ Projectile* Samos::shoot(std::string type)
     }
 
 
-    std::string shootState;
-    if (getState() == "Falling" || getState() == "FallingAimUpDiag" || getState() == "FallingAimDownDiag" || getState() == "FallingAimUp" || getState() == "FallingAimDown"
-            || getState() == "SpinJump" || getState() == "WallJump" || getState() == "Jumping" || getState() == "JumpEnd")
-        shootState = "Falling";
-    else if (getState() == "IdleCrouch" || getState() == "CrouchAimUp" || getState() == "CrouchAimUpDiag" || getState() == "CrouchAimDownDiag" || getState() == "Crouching")
-        shootState = "Crouching";
-    else if (getState() == "Walking" || getState() == "WalkingAimForward" || getState() == "WalkingAimDown" || getState() == "WalkingAimUp"
-             || getState() == "Running" || getState() == "RunningAimForward" || getState() == "RunningAimDown" || getState() == "RunningAimUp")
-        shootState = "Walking";
-    else if (getState() == "MorphBall")
-        shootState = "Morph";
-    else
-        shootState = "Standing";
+    const std::string &shootState = SamosStates::shootStanceName(SamosStates::get(getState()).shootStance);
 
-    if (canonDirection == "None")
-        canonDirection = "Right";
+    if (canonDirection == Facing::None)
+        canonDirection = Facing::Right;
 
-    if (canonDirection == "Right" || canonDirection == "UpRight" || canonDirection == "DownRight")
-        setFacing("Right");
-    if (canonDirection == "Left" || canonDirection == "UpLeft" || canonDirection == "DownLeft")
-        setFacing("Left");
+    if (EntityIds::isRight(canonDirection))
+        setFacing(Facing::Right);
+    if (EntityIds::isLeft(canonDirection))
+        setFacing(Facing::Left);
 
-    nlohmann::json offsetJson = values["names"]["Samos"]["shootOffset"][getFacing()][shootState][canonDirection];
-    nlohmann::json pOffsetJson = values["names"][type];
+    // Read without operator[] on missing keys, the compiled json is shared
+    nlohmann::json offsetJson;
+    const nlohmann::json &shootOffsets = getArchetype()->json["shootOffset"];
+    const std::string &facingName = getFacingName();
+    if (shootOffsets.contains(facingName) && shootOffsets[facingName].contains(shootState))
+        offsetJson = shootOffsets[facingName][shootState].value(EntityIds::facingName(canonDirection), nlohmann::json());
+    const Archetype *pType = ArchetypeRegistry::get(type);
     int offset_x = offsetJson.is_null() ? 0 : static_cast<int>(offsetJson["x"]);
     int offset_y = offsetJson.is_null() ? 0 : static_cast<int>(offsetJson["y"]);
 
     if (isInAltForm) {
-        offset_x -= static_cast<int>(pOffsetJson["width"]) / 2;
-        offset_y -= static_cast<int>(pOffsetJson["height"]) / 2;
-    } else if (canonDirection == "Up") {
-        offset_x -= static_cast<int>(pOffsetJson["width"]) / 2;
-        offset_y -= static_cast<int>(pOffsetJson["height"]);
-    } else if (canonDirection == "UpRight") {
-        offset_y -= static_cast<int>(pOffsetJson["height"]);
-    } else if (canonDirection == "Right") {
-        offset_y -= static_cast<int>(pOffsetJson["height"]) / 2;
-    } else if (canonDirection == "Down") {
-        offset_x -= static_cast<int>(pOffsetJson["width"]) / 2;
-    } else if (canonDirection == "DownLeft") {
-        offset_x -= static_cast<int>(pOffsetJson["width"]);
-    } else if (canonDirection == "Left") {
-        offset_x -= static_cast<int>(pOffsetJson["width"]);
-        offset_y -= static_cast<int>(pOffsetJson["height"]) / 2;
-    } else if (canonDirection == "UpLeft") {
-        offset_x -= static_cast<int>(pOffsetJson["width"]);
-        offset_y -= static_cast<int>(pOffsetJson["height"]);
+        offset_x -= pType->width / 2;
+        offset_y -= pType->height / 2;
+    } else if (canonDirection == Facing::Up) {
+        offset_x -= pType->width / 2;
+        offset_y -= pType->height;
+    } else if (canonDirection == Facing::UpRight) {
+        offset_y -= pType->height;
+    } else if (canonDirection == Facing::Right) {
+        offset_y -= pType->height / 2;
+    } else if (canonDirection == Facing::Down) {
+        offset_x -= pType->width / 2;
+    } else if (canonDirection == Facing::DownLeft) {
+        offset_x -= pType->width;
+    } else if (canonDirection == Facing::Left) {
+        offset_x -= pType->width;
+        offset_y -= pType->height / 2;
+    } else if (canonDirection == Facing::UpLeft) {
+        offset_x -= pType->width;
+        offset_y -= pType->height;
     }
 
     //Spawn the projectile at certain coordinates to match the sprite
@@ -172,44 +158,32 @@ void Samos::setJumpTime(double newJumpTime)
     jumpTime = newJumpTime;
 }
 
-CollisionBox *Samos::getWallBoxR() const
-{
-    return wallBoxR;
-}
-
-void Samos::setWallBoxR(CollisionBox *newWallBoxR)
+CollisionBox *Samos::getWallBoxR()
 {
-    delete wallBoxR;
-    wallBoxR = newWallBoxR;
+    return &wallBoxR;
 }
 
-void Samos::setWallBoxRNoDel(CollisionBox *newWallBoxR)
+void Samos::setWallBoxR(const CollisionBox &newWallBoxR)
 {
     wallBoxR = newWallBoxR;
 }
 
-CollisionBox *Samos::getWallBoxL() const
-{
-    return wallBoxL;
-}
-
-void Samos::setWallBoxL(CollisionBox *newWallBoxL)
+CollisionBox *Samos::getWallBoxL()
 {
-    delete wallBoxL;
-    wallBoxL = newWallBoxL;
+    return &wallBoxL;
 }
 
-void Samos::setWallBoxLNoDel(CollisionBox *newWallBoxL)
+void Samos::setWallBoxL(const CollisionBox &newWallBoxL)
 {
     wallBoxL = newWallBoxL;
 }
 
-const std::string &Samos::getCanonDirection() const
+Facing Samos::getCanonDirection() const
 {
     return canonDirection;
 }
 
-void Samos::setCanonDirection(const std::string &newCanonDirection)
+void Samos::setCanonDirection(Facing newCanonDirection)
 {
     canonDirection = newCanonDirection;
 }
@@ -302,12 +276,12 @@ void Samos::setDashTime(double newDashTime)
     dashTime = newDashTime;
 }
 
-const std::string &Samos::getDashDirection() const
+Facing Samos::getDashDirection() const
 {
     return dashDirection;
 }
 
-void Samos::setDashDirection(const std::string &newDashDirection)
+void Samos::setDashDirection(Facing newDashDirection)
 {
     dashDirection = newDashDirection;
 }
@@ -8,7 +8,7 @@ class Samos : public Living
 {
 public:
     Samos(double x, double y, int health, int maxHealth, int grenadeCount, int maxGrenadeCount, int missileCount, int maxMissileCount);
-    Samos(double x, double y, int maxHealth, int maxGrenadeCount, int maxMissileCount, CollisionBox* box, QImage* texture, std::string entityType, int health, bool isAffectedByGravity, std::string facing, double frictionFactor, std::string name, bool isMovable);
+    Samos(double x, double y, int maxHealth, int maxGrenadeCount, int maxMissileCount, CollisionBox* box, QImage* texture, EntityType entityType, int health, bool isAffectedByGravity, Facing facing, double frictionFactor, std::string name, bool isMovable);
     ~Samos();
 
     Projectile* shoot(std::string type);
@@ -31,16 +31,14 @@ public:
     double getJumpTime() const;
     void setJumpTime(double newJumpTime);
 
-    CollisionBox *getWallBoxR() const;
-    void setWallBoxR(CollisionBox *newWallBoxR);
-    void setWallBoxRNoDel(CollisionBox *newWallBoxR);
+    CollisionBox *getWallBoxR();
+    void setWallBoxR(const CollisionBox &newWallBoxR);
 
-    CollisionBox *getWallBoxL() const;
-    void setWallBoxL(CollisionBox *newWallBoxL);
-    void setWallBoxLNoDel(CollisionBox *newWallBoxL);
+    CollisionBox *getWallBoxL();
+    void setWallBoxL(const CollisionBox &newWallBoxL);
 
-    const std::string &getCanonDirection() const;
-    void setCanonDirection(const std::string &newCanonDirection);
+    Facing getCanonDirection() const;
+    void setCanonDirection(Facing newCanonDirection);
 
     double getShootTime() const;
     void setShootTime(double newShootTime);
@@ -67,8 +65,8 @@ public:
     double getDashTime() const;
     void setDashTime(double newDashTime);
 
-    const std::string &getDashDirection() const;
-    void setDashDirection(const std::string &newDashDirection);
+    Facing getDashDirection() const;
+    void setDashDirection(Facing newDashDirection);
 
     const std::pair<double, double> &getSpeedPriorDash() const;
     void setSpeedPriorDash(const std::pair<double, double> &newSpeedPriorDash);
@@ -89,10 +87,10 @@ private:
     double shootTime = 0.0;
     double switchDelay = 0.0;
     double lagTime = 0.0;
-    std::string canonDirection = "Right";
+    Facing canonDirection = Facing::Right;
     std::string selectedWeapon = "Beam";
-    CollisionBox* wallBoxR = nullptr;
-    CollisionBox* wallBoxL = nullptr;
+    CollisionBox wallBoxR;
+    CollisionBox wallBoxL;
     double speedRetained = 0.0;
     double retainTime = 0.0;
     bool fastFalling = false;
@@ -100,7 +98,7 @@ private:
     double dashTime = 0.0;
     double dashCoolDown = 0.0;
     std::string dashCoolDownType = "Grounded";
-    std::string dashDirection = "";
+    Facing dashDirection = Facing::None; // None when not dashing
 };
 
 #endif // SAMOS_H
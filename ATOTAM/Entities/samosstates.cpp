@@ -0,0 +1,143 @@
+#include "samosstates.h"
+
+static const StateId keep = SamosStates::keepState;
+static const Facing N = Facing::None;
+
+// Indexed by horizontal input (none, left, right) * 3 + vertical input (none, up, down)
+static const SamosStates::Aim aimTable[SamosStates::aimGroupCount][9] = {
+    // NoAim, never read
+    {},
+    // CrouchAim
+    {{N, State::IdleCrouch, Facing::Left, Facing::Right}, {N, State::CrouchAimUp, Facing::Up, Facing::Up}, {N, State::IdleCrouch, Facing::Left, Facing::Right},
+     {Facing::Left, State::IdleCrouch, Facing::Left, Facing::Left}, {Facing::Left, State::CrouchAimUpDiag, Facing::UpLeft, Facing::UpLeft}, {Facing::Left, State::CrouchAimDownDiag, Facing::DownLeft, Facing::DownLeft},
+     {Facing::Right, State::IdleCrouch, Facing::Right, Facing::Right}, {Facing::Right, State::CrouchAimUpDiag, Facing::UpRight, Facing::UpRight}, {Facing::Right, State::CrouchAimDownDiag, Facing::DownRight, Facing::DownRight}},
+    // StandAim
+    {{N, State::Standing, Facing::Left, Facing::Right}, {N, State::StandingAimUp, Facing::Up, Facing::Up}, {N, State::Standing, Facing::Left, Facing::Right},
+     {Facing::Left, State::Standing, Facing::Left, Facing::Left}, {Facing::Left, State::StandingAimUpDiag, Facing::UpLeft, Facing::UpLeft}, {Facing::Left, State::StandingAimDownDiag, Facing::DownLeft, Facing::DownLeft},
+     {Facing::Right, State::Standing, Facing::Right, Facing::Right}, {Facing::Right, State::StandingAimUpDiag, Facing::UpRight, Facing::UpRight}, {Facing::Right, State::StandingAimDownDiag, Facing::DownRight, Facing::DownRight}},
+    // FallAim
+    {{N, State::Falling, Facing::Left, Facing::Right}, {N, State::FallingAimUp, Facing::Up, Facing::Up}, {N, State::FallingAimDown, Facing::Down, Facing::Down},
+     {Facing::Left, State::Falling, Facing::Left, Facing::Left}, {Facing::Left, State::FallingAimUpDiag, Facing::UpLeft, Facing::UpLeft}, {Facing::Left, State::FallingAimDownDiag, Facing::DownLeft, Facing::DownLeft},
+     {Facing::Right, State::Falling, Facing::Right, Facing::Right}, {Facing::Right, State::FallingAimUpDiag, Facing::UpRight, Facing::UpRight}, {Facing::Right, State::FallingAimDownDiag, Facing::DownRight, Facing::DownRight}},
+    // WalkAim
+    {{N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right},
+     {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right},
+     {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right}},
+    // WalkUpAim
+    {{N, keep, Facing::UpLeft, Facing::UpRight}, {N, keep, Facing::UpLeft, Facing::UpRight}, {N, keep, Facing::UpLeft, Facing::UpRight},
+     {N, keep, Facing::UpLeft, Facing::UpRight}, {N, keep, Facing::UpLeft, Facing::UpRight}, {N, keep, Facing::UpLeft, Facing::UpRight},
+     {N, keep, Facing::UpLeft, Facing::UpRight}, {N, keep, Facing::UpLeft, Facing::UpRight}, {N, keep, Facing::UpLeft, Facing::UpRight}},
+    // WalkDownAim
+    {{N, keep, Facing::DownLeft, Facing::DownRight}, {N, keep, Facing::DownLeft, Facing::DownRight}, {N, keep, Facing::DownLeft, Facing::DownRight},
+     {N, keep, Facing::DownLeft, Facing::DownRight}, {N, keep, Facing::DownLeft, Facing::DownRight}, {N, keep, Facing::DownLeft, Facing::DownRight},
+     {N, keep, Facing::DownLeft, Facing::DownRight}, {N, keep, Facing::DownLeft, Facing::DownRight}, {N, keep, Facing::DownLeft, Facing::DownRight}},
+    // MorphAim
+    {{N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right},
+     {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right},
+     {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Left, Facing::Right}},
+    // JumpAim, the canon moves but the body keeps its facing
+    {{N, keep, Facing::Left, Facing::Right}, {N, keep, Facing::Up, Facing::Up}, {N, keep, Facing::Down, Facing::Down},
+     {N, keep, Facing::Left, Facing::Left}, {N, keep, Facing::UpLeft, Facing::UpLeft}, {N, keep, Facing::DownLeft, Facing::DownLeft},
+     {N, keep, Facing::Right, Facing::Right}, {N, keep, Facing::UpRight, Facing::UpRight}, {N, keep, Facing::DownRight, Facing::DownRight}}
+};
+
+static const std::string shootStanceNames[] = {"Standing", "Crouching", "Walking", "Falling", "Morph"};
+
+const SamosStates::StateInfo &SamosStates::get(StateId state)
+{
+    static const std::vector<StateInfo> states = compile();
+    static const StateInfo unknown;
+    return state < states.size() ? states[state] : unknown;
+}
+
+const SamosStates::Aim *SamosStates::aim(StateId state, unsigned char input)
+{
+    AimGroup group = get(state).aimGroup;
+    if (group == NoAim)
+        return nullptr;
+
+    unsigned int horizontal = (input & (inputLeft | inputRight)) == inputLeft ? 1 : (input & (inputLeft | inputRight)) == inputRight ? 2 : 0;
+    unsigned int vertical = (input & (inputUp | inputDown)) == inputUp ? 1 : (input & (inputUp | inputDown)) == inputDown ? 2 : 0;
+    return &aimTable[group][horizontal * 3 + vertical];
+}
+
+unsigned char SamosStates::inputMask(bool left, bool right, bool up, bool down)
+{
+    return (left ? inputLeft : 0) | (right ? inputRight : 0) | (up ? inputUp : 0) | (down ? inputDown : 0);
+}
+
+const std::string &SamosStates::shootStanceName(ShootStance shootStance)
+{
+    return shootStanceNames[shootStance];
+}
+
+std::vector<SamosStates::StateInfo> SamosStates::compile()
+{
+    std::vector<StateInfo> s(State::knownCount);
+
+    // Standing
+    for (StateId id : {State::Standing, State::StandingAimUp, State::StandingAimUpDiag, State::StandingAimDownDiag})
+        s[id].aimGroup = StandAim;
+
+    // Walking and running
+    for (StateId id : {State::Walking, State::WalkingAimForward, State::WalkingAimUp, State::WalkingAimDown,
+                       State::Running, State::RunningAimForward, State::RunningAimUp, State::RunningAimDown})
+        s[id].shootStance = ShootWalking;
+    s[State::Walking].aimGroup = WalkAim;
+    s[State::WalkingAimForward].aimGroup = WalkAim;
+    s[State::WalkingAimUp].aimGroup = WalkUpAim;
+    s[State::WalkingAimDown].aimGroup = WalkDownAim;
+    s[State::Walking].runState = State::Running;
+    s[State::WalkingAimForward].runState = State::RunningAimForward;
+    s[State::WalkingAimUp].runState = State::RunningAimUp;
+    s[State::WalkingAimDown].runState = State::RunningAimDown;
+    s[State::Running].calmState = State::Walking;
+    s[State::RunningAimForward].calmState = State::WalkingAimForward;
+    s[State::RunningAimUp].calmState = State::WalkingAimUp;
+    s[State::RunningAimDown].calmState = State::WalkingAimDown;
+    s[State::Walking].shootState = State::WalkingAimForward;
+
+    // Crouching
+    for (StateId id : {State::IdleCrouch, State::Crouching, State::CrouchAimUp, State::CrouchAimUpDiag, State::CrouchAimDownDiag}) {
+        s[id].flags |= crouched;
+        s[id].shootStance = ShootCrouching;
+    }
+    for (StateId id : {State::IdleCrouch, State::Crouching, State::CrouchAimUp, State::CrouchAimUpDiag, State::CrouchAimDownDiag,
+                       State::UnCrouching, State::UnMorphBalling})
+        s[id].stance = Crouch;
+    for (StateId id : {State::IdleCrouch, State::CrouchAimUp, State::CrouchAimUpDiag, State::CrouchAimDownDiag})
+        s[id].aimGroup = CrouchAim;
+    s[State::Crouching].shootState = State::IdleCrouch;
+    s[State::UnMorphBalling].shootState = State::IdleCrouch;
+    s[State::Uncrouching].shootState = State::Standing;
+    s[State::Landing].shootState = State::Standing;
+
+    // In the air
+    for (StateId id : {State::Falling, State::FallingAimUp, State::FallingAimUpDiag, State::FallingAimDown, State::FallingAimDownDiag}) {
+        s[id].flags |= airborne;
+        s[id].stance = Fall;
+        s[id].shootStance = ShootFalling;
+        s[id].aimGroup = FallAim;
+    }
+    for (StateId id : {State::Jumping, State::JumpEnd, State::SpinJump, State::WallJump}) {
+        s[id].flags |= airborne | jump;
+        s[id].shootStance = ShootFalling;
+        s[id].aimGroup = JumpAim;
+        s[id].shootState = State::Falling;
+    }
+    s[State::SpinJump].stance = Spin;
+    s[State::WallJump].stance = Spin;
+
+    // Morph ball
+    for (StateId id : {State::MorphBall, State::MorphBalling, State::MorphBallDash, State::MorphBallStop, State::MorphBallSlow, State::MorphBallSuperSlow})
+        s[id].stance = Morph;
+    s[State::MorphBall].shootStance = ShootMorph;
+    for (StateId id : {State::MorphBall, State::MorphBalling, State::UnMorphBalling})
+        s[id].aimGroup = MorphAim;
+    s[State::MorphBalling].flags |= morphTransition;
+    s[State::UnMorphBalling].flags |= morphTransition;
+    for (StateId id : {State::MorphBallStop, State::MorphBallSlow, State::MorphBallSuperSlow})
+        s[id].calmState = State::MorphBall;
+
+    return s;
+}
@@ -0,0 +1,63 @@
+#ifndef SAMOSSTATES_H
+#define SAMOSSTATES_H
+
+#include "entityids.h"
+
+#include <string>
+#include <vector>
+
+// Compiled Samos state machine: what each state is, which hitbox it uses,
+// which state it turns into on common events and how it aims depending on the inputs.
+// Everything is a table lookup, adding a state only means filling its row
+class SamosStates
+{
+public:
+    // Hitbox used by a state, index of SamosTuning::hitboxes
+    enum Stance : unsigned char {Stand, Crouch, Fall, Spin, Morph, stanceCount};
+    // Key of the "shootOffset" values of entities.json
+    enum ShootStance : unsigned char {ShootStanding, ShootCrouching, ShootWalking, ShootFalling, ShootMorph};
+    enum AimGroup : unsigned char {NoAim, CrouchAim, StandAim, FallAim, WalkAim, WalkUpAim, WalkDownAim, MorphAim, JumpAim, aimGroupCount};
+    enum Flags : unsigned char {
+        airborne = 1, // Lands when touching the ground
+        jump = 2, // Rising or spinning, doesn't turn into Falling in the air
+        crouched = 4, // Fully crouched, can aim
+        morphTransition = 8 // Rolling into or out of the morph ball
+    };
+    enum Input : unsigned char {inputLeft = 1, inputRight = 2, inputUp = 4, inputDown = 8};
+
+    static const StateId keepState = static_cast<StateId>(-1);
+
+    struct StateInfo {
+        unsigned char flags = 0;
+        Stance stance = Stand;
+        ShootStance shootStance = ShootStanding;
+        AimGroup aimGroup = NoAim;
+        StateId calmState = keepState; // State at the start of a tick: Running becomes Walking, a slowed morph ball MorphBall
+        StateId runState = keepState; // State when going faster than 1000 px/s
+        StateId shootState = keepState; // State switched to when shooting
+    };
+
+    // Result of the aiming inputs
+    struct Aim {
+        Facing facing; // None keeps the current facing
+        StateId state;
+        Facing canonLeft; // Canon direction when facing left
+        Facing canonRight; // Canon direction otherwise
+    };
+
+    static const StateInfo &get(StateId state);
+    static bool is(StateId state, unsigned char flags); // True if the state has any of 'flags'
+    static const Aim *aim(StateId state, unsigned char input); // nullptr if the state doesn't aim
+    static unsigned char inputMask(bool left, bool right, bool up, bool down);
+    static const std::string &shootStanceName(ShootStance shootStance);
+
+private:
+    static std::vector<StateInfo> compile();
+};
+
+inline bool SamosStates::is(StateId state, unsigned char flags)
+{
+    return (get(state).flags & flags) != 0;
+}
+
+#endif // SAMOSSTATES_H
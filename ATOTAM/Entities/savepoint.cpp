@@ -1,7 +1,7 @@
 #include "savepoint.h"
 
 Savepoint::Savepoint(double x, double y, int spID, std::string mapName)
-    : NPC(x, y, "Right", "Savepoint"),
+    : NPC(x, y, Facing::Right, "Savepoint"),
       savepointID(spID),
       mapName(mapName)
 {
@@ -1,13 +1,13 @@
 #include "terrain.h"
 
 Terrain::Terrain(double x, double y, CollisionBox* box, QImage* texture, std::string name)
-    : Entity(x, y, box, texture, "Terrain", false, "None", 0.0, name, false)
+    : Entity(x, y, box, texture, EntityType::Terrain, false, Facing::None, 0.0, name, false)
 {
-    setLastFrameFacing("None");
+    setLastFrameFacing(Facing::None);
 }
 
 Terrain::Terrain(double x, double y, std::string name) :
-    Entity(x, y, "None", name)
+    Entity(x, y, Facing::None, name)
 {
 
 }
@@ -0,0 +1,220 @@
+#include "textureatlas.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+// The index is little-endian whatever the machine, values are written byte by byte
+
+static const char magic[4] = {'A', 'T', 'L', 'S'};
+
+static void writeUnsigned(std::ostream &out, unsigned long long value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+static unsigned long long readUnsigned(std::istream &in, int bytes)
+{
+    unsigned long long value = 0;
+    for (int i = 0; i < bytes; i++)
+        value |= static_cast<unsigned long long>(static_cast<unsigned char>(in.get())) << (8 * i);
+    return value;
+}
+
+static void writeString(std::ostream &out, const std::string &value)
+{
+    writeUnsigned(out, value.size(), 2);
+    out.write(value.data(), value.size());
+}
+
+static std::string readString(std::istream &in)
+{
+    std::string value(readUnsigned(in, 2), '\0');
+    in.read(&value[0], value.size());
+    return value;
+}
+
+static const unsigned long long fnvOffsetBasis = 14695981039346656037ULL;
+
+// Continues the FNV-1a 'hash' with the bytes of the file, returns false if it can't be read
+static bool hashInto(const std::string &path, unsigned long long &hash)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    for (std::istreambuf_iterator<char> c(file), end; c != end; c++) {
+        hash ^= static_cast<unsigned char>(*c);
+        hash *= 1099511628211ULL;
+    }
+    return true;
+}
+
+unsigned long long TextureAtlas::hashSources(const std::string &assetsPath, const std::vector<std::string> &sourceFiles)
+{
+    unsigned long long hash = fnvOffsetBasis;
+    if (!hashInto(assetsPath + "/entities.json", hash))
+        return 0;
+    // Editing or replacing a texture without touching entities.json makes the packed frames stale too
+    for (std::vector<std::string>::const_iterator file = sourceFiles.begin(); file != sourceFiles.end(); file++)
+        if (!hashInto(assetsPath + "/textures/" + *file, hash))
+            return 0;
+    return hash;
+}
+
+unsigned long long TextureAtlas::hashFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return 0;
+    // FNV-1a
+    unsigned long long hash = fnvOffsetBasis;
+    for (std::istreambuf_iterator<char> c(file), end; c != end; c++) {
+        hash ^= static_cast<unsigned char>(*c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string TextureAtlas::directory(const std::string &texturesPath)
+{
+    return texturesPath + "atlas/";
+}
+
+std::string TextureAtlas::indexPath(const std::string &texturesPath)
+{
+    return directory(texturesPath) + "index.bin";
+}
+
+bool TextureAtlas::load(const std::string &path)
+{
+    clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+
+    char fileMagic[4] = {0, 0, 0, 0};
+    in.read(fileMagic, 4);
+    if (!std::equal(magic, magic + 4, fileMagic) || readUnsigned(in, 4) != version)
+        return false;
+
+    sourceHash = readUnsigned(in, 8);
+    unsigned int sourceFileCount = readUnsigned(in, 4);
+    for (unsigned int i = 0; i < sourceFileCount && in; i++)
+        sourceFiles.push_back(readString(in));
+    unsigned int pageCount = readUnsigned(in, 4);
+    for (unsigned int i = 0; i < pageCount; i++)
+        pages.push_back(readString(in));
+
+    unsigned int entryCount = readUnsigned(in, 4);
+    for (unsigned int i = 0; i < entryCount && in; i++) {
+        std::string texture = readString(in);
+        std::string state = readString(in);
+        int side = readUnsigned(in, 1);
+        std::vector<AtlasFrame> entryFrames(readUnsigned(in, 4));
+        for (std::vector<AtlasFrame>::iterator frame = entryFrames.begin(); frame != entryFrames.end(); frame++) {
+            frame->page = readUnsigned(in, 2);
+            frame->x = readUnsigned(in, 2);
+            frame->y = readUnsigned(in, 2);
+            frame->width = readUnsigned(in, 2);
+            frame->height = readUnsigned(in, 2);
+        }
+        add(texture, state, side, entryFrames);
+    }
+
+    // A truncated file is as good as no file
+    if (!in) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+bool TextureAtlas::save(const std::string &path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+
+    out.write(magic, 4);
+    writeUnsigned(out, version, 4);
+    writeUnsigned(out, sourceHash, 8);
+    writeUnsigned(out, sourceFiles.size(), 4);
+    for (std::vector<std::string>::const_iterator file = sourceFiles.begin(); file != sourceFiles.end(); file++)
+        writeString(out, *file);
+    writeUnsigned(out, pages.size(), 4);
+    for (std::vector<std::string>::const_iterator page = pages.begin(); page != pages.end(); page++)
+        writeString(out, *page);
+
+    writeUnsigned(out, frames.size(), 4);
+    for (std::map<Key, std::vector<AtlasFrame>>::const_iterator entry = frames.begin(); entry != frames.end(); entry++) {
+        writeString(out, std::get<0>(entry->first));
+        writeString(out, std::get<1>(entry->first));
+        writeUnsigned(out, std::get<2>(entry->first), 1);
+        writeUnsigned(out, entry->second.size(), 4);
+        for (std::vector<AtlasFrame>::const_iterator frame = entry->second.begin(); frame != entry->second.end(); frame++) {
+            writeUnsigned(out, frame->page, 2);
+            writeUnsigned(out, frame->x, 2);
+            writeUnsigned(out, frame->y, 2);
+            writeUnsigned(out, frame->width, 2);
+            writeUnsigned(out, frame->height, 2);
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+void TextureAtlas::clear()
+{
+    sourceHash = 0;
+    sourceFiles.clear();
+    pages.clear();
+    frames.clear();
+}
+
+bool TextureAtlas::isEmpty() const
+{
+    return frames.empty();
+}
+
+void TextureAtlas::add(const std::string &texture, const std::string &state, int side, const std::vector<AtlasFrame> &newFrames)
+{
+    frames[Key(texture, state, side)] = newFrames;
+}
+
+const std::vector<AtlasFrame> *TextureAtlas::find(const std::string &texture, const std::string &state, int side) const
+{
+    std::map<Key, std::vector<AtlasFrame>>::const_iterator entry = frames.find(Key(texture, state, side));
+    if (entry == frames.end())
+        return nullptr;
+    return &entry->second;
+}
+
+unsigned long long TextureAtlas::getSourceHash() const
+{
+    return sourceHash;
+}
+
+void TextureAtlas::setSourceHash(unsigned long long newSourceHash)
+{
+    sourceHash = newSourceHash;
+}
+
+const std::vector<std::string> &TextureAtlas::getSourceFiles() const
+{
+    return sourceFiles;
+}
+
+void TextureAtlas::setSourceFiles(const std::vector<std::string> &newSourceFiles)
+{
+    sourceFiles = newSourceFiles;
+}
+
+const std::vector<std::string> &TextureAtlas::getPages() const
+{
+    return pages;
+}
+
+void TextureAtlas::setPages(const std::vector<std::string> &newPages)
+{
+    pages = newPages;
+}
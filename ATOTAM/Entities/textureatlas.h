@@ -0,0 +1,57 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Where a frame is in the atlas pages, in px
+struct AtlasFrame
+{
+    unsigned int page = 0; // Index in TextureAtlas::getPages
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Index of the animation frames packed by ATOTAM_AtlasPacker into a few big images.
+// The frames are already sliced for each side of a clip, see AnimationCache::cut
+class TextureAtlas
+{
+public:
+    static const unsigned int version = 2; // Increased when the file layout changes
+    static unsigned long long hashFile(const std::string &path); // 0 if the file can't be read
+    // Hash of entities.json and of every texture file in 'sourceFiles', 0 if one of them can't be read
+    static unsigned long long hashSources(const std::string &assetsPath, const std::vector<std::string> &sourceFiles);
+    static std::string directory(const std::string &texturesPath); // Where the index and the pages are
+    static std::string indexPath(const std::string &texturesPath);
+
+    bool load(const std::string &path); // The atlas is empty if false is returned
+    bool save(const std::string &path) const;
+    void clear();
+    bool isEmpty() const;
+
+    void add(const std::string &texture, const std::string &state, int side, const std::vector<AtlasFrame> &newFrames);
+    const std::vector<AtlasFrame> *find(const std::string &texture, const std::string &state, int side) const; // nullptr if not packed
+
+    unsigned long long getSourceHash() const;
+    void setSourceHash(unsigned long long newSourceHash);
+
+    const std::vector<std::string> &getSourceFiles() const;
+    void setSourceFiles(const std::vector<std::string> &newSourceFiles);
+
+    const std::vector<std::string> &getPages() const;
+    void setPages(const std::vector<std::string> &newPages);
+
+private:
+    typedef std::tuple<std::string, std::string, int> Key; // Texture, state name, AnimationCache::Side
+
+    unsigned long long sourceHash = 0; // hashSources of the entities.json and textures the atlas was packed from
+    std::vector<std::string> sourceFiles; // Texture files the frames were cut from, relative to assets/textures
+    std::vector<std::string> pages; // Image files, relative to the index file
+    std::map<Key, std::vector<AtlasFrame>> frames;
+};
+
+#endif // TEXTUREATLAS_H
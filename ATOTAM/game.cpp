@@ -1,8 +1,10 @@
 #include "game.h"
 #include "Entities/door.h"
 #include "physics.h"
+#include <algorithm>
 #include <io.h>
 #include <iostream>
+#include <set>
 #include <Entities/savepoint.h>
 
 nlohmann::json Game::loadJson(std::string fileName)
@@ -36,12 +38,21 @@ void Game::loadGeneral()
     renderHitboxes = Entity::values["general"]["renderHitboxes"];
     showFps = params["showFps"];
     fullscreen = params["fullscreen"];
+    integerScaling = params["integerScaling"];
+    roomCacheBudget = params["roomCacheBudget"];
     mapCameraSpeed = Entity::values["general"]["mapCameraSpeed"];
     cameraSize.first = Entity::values["general"]["camera_size_x"];
     cameraSize.second = Entity::values["general"]["camera_size_y"];
     debugEnabled = Entity::values["general"]["debugEnabled"];
     tasToolEnabled = Entity::values["general"]["frameAdvanceEnabled"];
     showDebugInfo = Entity::values["general"]["showDebugInfo"];
+    collisionGridCellSize = Entity::values["general"]["collisionGridCellSize"];
+    maxCatchUpSteps = Entity::values["general"]["maxCatchUpSteps"];
+    roomActivationBudget = Entity::values["general"]["roomActivationBudget"];
+    prefetchLookAhead = Entity::values["general"]["prefetchLookAhead"];
+    prefetchFacingSpeed = Entity::values["general"]["prefetchFacingSpeed"];
+    maxRenderRate = Entity::values["general"]["maxRenderRate"];
+    renderingMultiplier = Entity::values["general"]["renderingMultiplier"];
 }
 
 void Game::loadSave(Save save)
@@ -52,33 +63,9 @@ void Game::loadSave(Save save)
     currentMap = Map::loadMap(save.getSaveMapName(), assetsPath);
     currentMap.setCurrentRoomId(save.getRoomID());
 
-    // Async room loading to avoid segfaults
-    // Unload every room
-    for (auto room = roomEntities.begin(); room != roomEntities.end(); room++)
-        roomsToUnload.push_back(room->first);
-    if (roomWorker) {
-        if (roomWorker->joinable())
-            roomWorker->join();
-        // Reset the worker
-        updateAsyncRoomLoading();
-    }
-    // Unload the rooms
-    updateAsyncRoomLoading();
-    // Wait for the worker to finish the unloading by joining the threads
-    if (roomWorker)
-        if (roomWorker->joinable())
-            roomWorker->join();
-    // Clear the lists to avoid corrupted pointers
-    terrains = {};
-    monsters = {};
-    NPCs = {};
-    projectiles = {};
-    areas = {};
-    dynamicObjs = {};
-    entities = {};
-    // Then load the needed rooms because at this point all the Entities have been deleted
+    unloadAllRooms();
+    // Then load the needed rooms because at this point all the Entities are being deleted
     updateLoadedRooms();
-    updateAsyncRoomLoading();
 
     // Place Samos
     std::pair<int, int> coords = loadRespawnPosition(save, currentMap);
@@ -203,110 +190,315 @@ void Game::updateTas()
         line++;
 }
 
-// Returns whether a worker thread was started. Also returns true if there's nothing to load/unload
 void Game::updateAsyncRoomLoading()
 {
-    if (roomsToLoad.empty() && roomsToUnload.empty())
-        return;
+    std::vector<StreamedRoom> loaded;
+    std::vector<std::string> unloaded;
+    roomStreamer.takeFinished(loaded, unloaded);
 
-    // A worker thread is necessary
-
-    if (roomWorker == nullptr) {
-        roomWorker = new std::thread([this] {
-            // For each room to load
-            for (auto room = roomsToLoad.begin(); room != roomsToLoad.end(); room++) {
-                // Get the room entity vector
-                std::vector<Entity*>* ents = roomEntities[*room];
-
-                if (ents == nullptr)
-                    // Create it if null
-                    ents = new std::vector<Entity*>;
-                else
-                    // If the room is already loaded, don't go any further
-                    if (!ents->empty())
-                        continue;
-
-                // For each entity to load
-                for (Entity* e : currentMap.loadRoom(*room))
-                    // Add it to the vector
-                    ents->push_back(e);
-
-                // Eventually add the vector to the map
-                roomEntities[*room] = ents;
-            }
-            roomsToLoad.clear();
+    for (std::vector<StreamedRoom>::iterator room = loaded.begin(); room != loaded.end(); room++) {
+        std::vector<std::string>::iterator queued = std::find(roomsToLoad.begin(), roomsToLoad.end(), room->id);
+        if (queued != roomsToLoad.end())
+            roomsToLoad.erase(queued);
 
-            // For each room to unload
-            for (auto room = roomsToUnload.begin(); room != roomsToUnload.end(); room++) {
-                // Get the room entity vector
-                std::vector<Entity*>* ents = roomEntities[*room];
+        // Loaded on this thread while the streamer was building it, this copy isn't needed
+        if (roomEntities[room->id] != nullptr) {
+            roomStreamer.unload(*room);
+            continue;
+        }
+        roomEntities[room->id] = room->entities;
+        roomGeometry[room->id] = room->geometry;
+        roomLayers[room->id] = room->layer;
+        roomArenas[room->id] = room->arena;
+        roomFootprints[room->id] = room->bytes;
+    }
 
-                // If null, nothing needs to be unloaded
-                if (ents == nullptr)
-                    continue;
+    for (std::vector<std::string>::iterator room = unloaded.begin(); room != unloaded.end(); room++) {
+        std::vector<std::string>::iterator queued = std::find(roomsToUnload.begin(), roomsToUnload.end(), *room);
+        if (queued != roomsToUnload.end())
+            roomsToUnload.erase(queued);
+    }
+}
 
-                // For each entity to unload
-                for (Entity* e : *ents)
-                    // Delete it
-                    delete e;
+const std::vector<Entity*> &Game::loadRoomNow(const std::string &roomId)
+{
+    // It may have just been finished
+    updateAsyncRoomLoading();
 
-                // Also delete the vector
-                delete ents;
+    if (roomEntities[roomId] == nullptr) {
+        // If it's being built, that copy is given back to the streamer once finished
+        if (roomStreamer.cancel(roomId))
+            roomsToLoad.erase(std::find(roomsToLoad.begin(), roomsToLoad.end(), roomId));
+        roomArenas[roomId] = new RoomArena();
+        {
+            RoomArena::Scope scope(*roomArenas[roomId]);
+            roomEntities[roomId] = new std::vector<Entity*>(currentMap.loadRoom(roomId));
+        }
+        buildStaticGeometry(roomId, *roomEntities[roomId]);
+        roomFootprints[roomId] = RoomStreamer::footprint(loadedRoom(roomId));
+    }
+    return *roomEntities[roomId];
+}
 
-                // Remove the vector from the map
-                roomEntities[*room] = nullptr;
-            }
-            roomsToUnload.clear();
-
-            workerFinished = true;
-        });
-    } else if (workerFinished) {
-        // Thread finished execution
-        if (roomWorker->joinable())
-            roomWorker->join();
-        delete roomWorker;
-        roomWorker = nullptr;
-
-        // Reset value for next thread
-        workerFinished = false;
+const std::vector<Entity*> &Game::enterRoom(const std::string &roomId)
+{
+    // Rooms the streamer finished but that weren't taken yet are hits too
+    updateAsyncRoomLoading();
+    if (roomEntities[roomId] != nullptr)
+        prefetchHits++;
+    else
+        prefetchMisses++;
+    return loadRoomNow(roomId);
+}
+
+// Horizontal and vertical signs of a facing
+static std::pair<int, int> facingDirection(Facing facing)
+{
+    switch (facing) {
+    case Facing::Up: return {0, -1};
+    case Facing::UpRight: return {1, -1};
+    case Facing::Right: return {1, 0};
+    case Facing::DownRight: return {1, 1};
+    case Facing::Down: return {0, 1};
+    case Facing::DownLeft: return {-1, 1};
+    case Facing::Left: return {-1, 0};
+    case Facing::UpLeft: return {-1, -1};
+    default: return {0, 0};
     }
 }
 
+void Game::updatePrefetch()
+{
+    if (s == nullptr)
+        return;
+
+    const RoomInfo &room = currentMap.getCurrentRoomInfo();
+    double x = s->getX() + s->getBox()->getX() + s->getBox()->getWidth() / 2.0;
+    double y = s->getY() + s->getBox()->getY() + s->getBox()->getHeight() / 2.0;
+    std::pair<int, int> facing = facingDirection(s->getFacing());
+
+    // Time Samos needs to reach each door at its current speed, favouring the side it faces
+    std::vector<std::pair<double, const RoomInfo::DoorInfo*>> reached;
+    for (std::vector<RoomInfo::DoorInfo>::const_iterator door = room.doors.begin(); door != room.doors.end(); door++) {
+        double dx = room.x + door->x - x;
+        double dy = room.y + door->y - y;
+        double distance = std::sqrt(dx * dx + dy * dy);
+        if (distance < 1.0) {
+            reached.push_back(std::make_pair(0.0, &*door));
+            continue;
+        }
+        double towards = (s->getVX() * dx + s->getVY() * dy) / distance;
+        if ((facing.first != 0 && (dx > 0) == (facing.first > 0)) || (facing.second != 0 && (dy > 0) == (facing.second > 0)))
+            towards += prefetchFacingSpeed;
+        if (towards > 0.0 && distance / towards <= prefetchLookAhead)
+            reached.push_back(std::make_pair(distance / towards, &*door));
+    }
+    if (reached.empty())
+        return;
+    std::sort(reached.begin(), reached.end(),
+              [](const std::pair<double, const RoomInfo::DoorInfo*> &a, const std::pair<double, const RoomInfo::DoorInfo*> &b) { return a.first < b.first; });
+
+    // The most likely room is needed before the unloads, the others as soon as possible
+    for (std::vector<std::pair<double, const RoomInfo::DoorInfo*>>::iterator door = reached.begin(); door != reached.end(); door++)
+        requestRoom(door->second->endingRoom, door == reached.begin() ? RoomStreamer::Load : RoomStreamer::Prefetch);
+
+    // A dash can cross the next room before its neighbours are asked for after the transition
+    if (s->getDashTime() > 0.0) {
+        const std::vector<std::string> &next = currentMap.getRoomInfo(reached.front().second->endingRoom).neighbours;
+        for (std::vector<std::string>::const_iterator r = next.begin(); r != next.end(); r++)
+            if (*r != room.id)
+                requestRoom(*r, RoomStreamer::Prefetch);
+    }
+}
+
+void Game::requestRoom(const std::string &roomId, RoomStreamer::Priority priority)
+{
+    std::map<std::string, std::vector<Entity*>*>::iterator loaded = roomEntities.find(roomId);
+    if (loaded != roomEntities.end() && loaded->second != nullptr)
+        return;
+
+    if (std::find(roomsToLoad.begin(), roomsToLoad.end(), roomId) == roomsToLoad.end()) {
+        roomStreamer.load(roomId, priority);
+        roomsToLoad.push_back(roomId);
+    } else if (priority == RoomStreamer::Load)
+        roomStreamer.raise(roomId);
+}
+
+void Game::unloadAllRooms()
+{
+    // Unload every room, along with the ones the streamer loaded for the previous map
+    std::vector<StreamedRoom> stale = roomStreamer.restart(currentMap, renderingMultiplier);
+    for (std::vector<StreamedRoom>::iterator room = stale.begin(); room != stale.end(); room++)
+        roomStreamer.unload(*room);
+    for (auto room = roomEntities.begin(); room != roomEntities.end(); room++)
+        if (room->second != nullptr)
+            roomStreamer.unload(takeRoom(room->first));
+    roomEntities.clear();
+    roomGeometry.clear();
+    roomLayers.clear();
+    roomArenas.clear();
+    roomFootprints.clear();
+    roomCache.clear();
+    roomCacheBytes = 0;
+    roomsToLoad.clear();
+    // Clear the lists to avoid corrupted pointers
+    terrains = {};
+    monsters = {};
+    NPCs = {};
+    projectiles = {};
+    areas = {};
+    dynamicObjs = {};
+    entities = {};
+    // The grids still hold the deleted entities and colliders, even when the room stays the same
+    collisionGridsRoom = "";
+}
+
+void Game::reloadCurrentRoom()
+{
+    Samos *samos = s;
+    unloadAllRooms();
+    updateLoadedRooms();
+    if (samos != nullptr)
+        addEntity(samos);
+}
+
 void Game::updateLoadedRooms()
 {
-    std::vector<std::string> loadedRooms = { currentMap.getCurrentRoomId() };
     // If the current room isn't loaded: if the game is starting
-    if (roomEntities[currentMap.getCurrentRoomId()] == nullptr) {
-        roomEntities[currentMap.getCurrentRoomId()] = new std::vector<Entity*>(currentMap.loadRoom());
-        addEntities(*roomEntities[currentMap.getCurrentRoomId()]);
-    }
+    if (roomEntities[currentMap.getCurrentRoomId()] == nullptr)
+        addEntities(loadRoomNow(currentMap.getCurrentRoomId()));
 
+    queueNeighbourRooms();
+    cacheFarRooms();
+}
+
+void Game::queueNeighbourRooms()
+{
     // For each door in the current room, load its ending room
-    for (auto area = areas.begin(); area != areas.end(); area++)
-        if ((*area)->getAreaType() == "Door") {
-            // This shouldn't cause a crash
-            std::string room = dynamic_cast<Door*>(*area)->getEndingRoom();
+    const std::vector<std::string> &neighbours = currentMap.getCurrentRoomInfo().neighbours;
+    for (std::vector<std::string>::const_iterator room = neighbours.begin(); room != neighbours.end(); room++)
+        // If the room isn't loaded yet, ask the streamer for it. updatePrefetch raises the ones Samos is heading to
+        requestRoom(*room, RoomStreamer::Prefetch);
+}
 
-            // If the room isn't loaded yet, add it to the list
-            if (roomEntities[room] == nullptr)
-                roomsToLoad.push_back(room);
+void Game::cacheFarRooms()
+{
+    std::string current = currentMap.getCurrentRoomId();
+    const std::vector<std::string> &neighbours = currentMap.getCurrentRoomInfo().neighbours;
 
-            loadedRooms.push_back(room);
+    // Keep the other rooms ready for when Samos comes back, as long as they fit in the budget
+    for (auto room = roomEntities.begin(); room != roomEntities.end(); room++) {
+        if (room->second == nullptr)
+            continue;
+        bool near = room->first == current || std::find(neighbours.begin(), neighbours.end(), room->first) != neighbours.end();
+        std::list<std::pair<std::string, std::size_t>>::iterator cached = roomCache.begin();
+        while (cached != roomCache.end() && cached->first != room->first)
+            cached++;
+
+        if (near && cached != roomCache.end()) {
+            roomCacheBytes -= cached->second;
+            roomCache.erase(cached);
+        } else if (!near && cached == roomCache.end()) {
+            // Measured when the room was built, so leaving it costs nothing
+            std::size_t bytes = roomFootprints[room->first];
+            roomCache.push_front(std::make_pair(room->first, bytes));
+            roomCacheBytes += bytes;
         }
+    }
 
-    // Unload all the other rooms
-    for (auto room = roomEntities.begin(); room != roomEntities.end(); room++) {
-        bool listed = false;
-        for (const std::string &r : loadedRooms)
-            if (r == room->first) {
-                listed = true;
-                break;
-            }
-        if (!listed)
-            roomsToUnload.push_back(room->first);
+    // Unload the least recently left rooms
+    while (roomCacheBytes > roomCacheBudget) {
+        roomStreamer.unload(takeRoom(roomCache.back().first));
+        roomsToUnload.push_back(roomCache.back().first);
+        roomCacheBytes -= roomCache.back().second;
+        roomCache.pop_back();
+    }
+}
+
+StreamedRoom Game::loadedRoom(const std::string &roomId)
+{
+    StreamedRoom room;
+    room.id = roomId;
+    room.entities = roomEntities[roomId];
+    room.geometry = roomGeometry[roomId];
+    room.layer = roomLayers[roomId];
+    room.arena = roomArenas[roomId];
+    room.bytes = roomFootprints[roomId];
+    return room;
+}
+
+StreamedRoom Game::takeRoom(const std::string &roomId)
+{
+    StreamedRoom room = loadedRoom(roomId);
+    roomEntities[roomId] = nullptr;
+    roomGeometry[roomId] = nullptr;
+    roomLayers[roomId] = nullptr;
+    roomArenas[roomId] = nullptr;
+    roomFootprints.erase(roomId);
+    return room;
+}
+
+void Game::updateCollisionGrids()
+{
+    for (std::vector<Entity*>::iterator ent = entities.begin(); ent != entities.end(); ent++)
+        // Terrain never moves, its merged colliders were inserted once when the grids were fitted
+        if ((*ent)->getEntType() != EntityType::Terrain && (*ent)->getEntType() != EntityType::Samos)
+            collisionGrids[(*ent)->getEntType()].update(*ent);
+}
+
+void Game::updateRenderGrid()
+{
+    for (std::vector<Entity*>::iterator ent = entities.begin(); ent != entities.end(); ent++)
+        placeInRenderGrid(*ent, renderGrid);
+}
+
+void Game::placeInRenderGrid(Entity *e, SpatialGrid &grid)
+{
+    // The area MainWindow::setupToDraw tests against the camera
+    const QImage *texture = e->getTexture();
+    if (texture == nullptr)
+        grid.update(e, e->getX(), e->getY(), 0, 0);
+    else
+        grid.update(e, e->getX() + texture->offset().x(), e->getY() + texture->offset().y(),
+                          texture->width() * renderingMultiplier, texture->height() * renderingMultiplier);
+}
+
+void Game::resizeCollisionGrids()
+{
+    collisionGridsRoom = currentMap.getCurrentRoomId();
+    // An unknown room gives an empty RoomInfo, so the grids shrink to a single cell
+    const RoomInfo &room = currentMap.getRoomInfo(collisionGridsRoom);
+
+    for (EntityType type : {EntityType::Terrain, EntityType::Monster, EntityType::NPC, EntityType::DynamicObj, EntityType::Area, EntityType::Projectile})
+        collisionGrids[type].resize(room.x, room.y, room.width, room.height, collisionGridCellSize);
+    // Entities of the other rooms still shown during a door transition end up in the border cells
+    renderGrid.resize(room.x, room.y, room.width, room.height, collisionGridCellSize);
+
+    // Terrain collides through the merged colliders, not through the rendered entities
+    const std::vector<Terrain*> *colliders = getStaticColliders();
+    for (std::vector<Terrain*>::const_iterator t = colliders->begin(); t != colliders->end(); t++)
+        collisionGrids[EntityType::Terrain].insert(*t);
+
+    for (std::vector<Entity*>::iterator ent = entities.begin(); ent != entities.end(); ent++) {
+        if ((*ent)->getEntType() != EntityType::Samos && (*ent)->getEntType() != EntityType::Terrain)
+            collisionGrids[(*ent)->getEntType()].insert(*ent);
+        placeInRenderGrid(*ent, renderGrid);
     }
 }
 
+void Game::buildStaticGeometry(std::string roomId, const std::vector<Entity *> &roomEnts)
+{
+    StaticGeometry* previous = roomGeometry[roomId];
+    roomGeometry[roomId] = new StaticGeometry(roomEnts);
+    delete roomLayers[roomId];
+    roomLayers[roomId] = new StaticLayer(roomEnts, renderingMultiplier);
+
+    // The grids may still reference the old colliders
+    if (roomId == collisionGridsRoom)
+        resizeCollisionGrids();
+    delete previous;
+}
+
 void Game::updateSpecialInputs()
 {
     if (inputList["SPECIAL_toggleFrameAdvance"] && inputTime["SPECIAL_toggleFrameAdvance"] == 0)
@@ -363,6 +555,7 @@ Game::Game(std::string assetsPath, std::string saveNumber)
 
     // Load map
     currentMap.setCurrentRoomId(currentProgress.getRoomID());
+    roomStreamer.restart(currentMap, renderingMultiplier);
     updateLoadedRooms();
 
     std::pair<int, int> coords = loadRespawnPosition(currentProgress, currentMap);
@@ -529,16 +722,22 @@ void Game::updateMenu()
                  s->setHealth(s->getMaxHealth());
             else if (menuOptions[selectedOption] == "Reload entities.json") {
                 std::string rID = currentMap.getCurrentRoomId();
+                // The streamer builds and deletes entities from the values and archetypes rewritten here.
+                // The render worker only reads the frames copied into the RenderFrame, it doesn't need to wait
+                roomStreamer.pause();
                 Entity::values = Entity::loadValues(assetsPath);
+                ArchetypeRegistry::compile(Entity::values);
                 loadGeneral();
+                roomStreamer.resume();
                 currentMap.setCurrentRoomId(rID);
-            } else if (menuOptions[selectedOption] == "Reload room") {
-                clearEntities("Samos");
-                addEntities(currentMap.loadRoom());
-            } else if (menuOptions[selectedOption] == "Reload map") {
+            } else if (menuOptions[selectedOption] == "Reload room")
+                reloadCurrentRoom();
+            else if (menuOptions[selectedOption] == "Reload map") {
                 std::string mapId = currentMap.getCurrentRoomId();
                 currentMap = Map::loadMap(currentMap.getName(), assetsPath);
                 currentMap.setCurrentRoomId(mapId);
+                // The loaded rooms and the streamer's copy of the map are from the old file
+                reloadCurrentRoom();
             } else if (menuOptions[selectedOption] == "Map viewer mode : ON")
                 mapViewer = false;
             else if (menuOptions[selectedOption] == "Map viewer mode : OFF")
@@ -666,14 +865,12 @@ void Game::updateNPCs()
 
 void Game::updateCamera()
 {
-    nlohmann::json mapJson = (*currentMap.getJson())["rooms"][currentMap.getCurrentRoomId()];
+    const RoomInfo &room = currentMap.getCurrentRoomInfo();
 
-    int roomS_x = mapJson["position"][0];
-    int roomS_y = mapJson["position"][1];
-    int roomE_x = mapJson["size"][0];
-    int roomE_y = mapJson["size"][1];
-    roomE_x += roomS_x;
-    roomE_y += roomS_y;
+    int roomS_x = room.x;
+    int roomS_y = room.y;
+    int roomE_x = room.x + room.width;
+    int roomE_y = room.y + room.height;
 
     int cam_dist_x = s->getX() + static_cast<int>(Entity::values["general"]["camera_rx"]) - camera.x();
     int cam_dist_y = s->getY() + static_cast<int>(Entity::values["general"]["camera_ry"]) - camera.y();
@@ -709,26 +906,25 @@ void Game::updateInventory()
             inInventory = false;
         }
         if (inMap) {
-            nlohmann::json mapJson = *currentMap.getJson();
-            std::vector<std::string> tRooms = currentProgress.getRoomsDiscovered()[currentMap.getName()];
-            nlohmann::json currentRoom = mapJson["rooms"][currentMap.getCurrentRoomId()];
+            std::vector<std::string> &tRooms = currentProgress.getRoomsDiscovered()[currentMap.getName()];
+            const RoomInfo &currentRoom = currentMap.getCurrentRoomInfo();
             int mapScaleDown = Entity::values["general"]["mapScaleDown"].get<int>();
 
-            int x_min = currentRoom["position"][0].get<int>();
-            int x_max = currentRoom["position"][0].get<int>() + currentRoom["size"][0].get<int>();
-            int y_min = currentRoom["position"][1].get<int>();
-            int y_max = currentRoom["position"][1].get<int>() + currentRoom["size"][1].get<int>();
-
-            for (std::string i : tRooms) {
-                nlohmann::json room = mapJson["rooms"][i];
-                if (room["position"][0].get<int>() + room["size"][0].get<int>() > x_max)
-                    x_max = room["position"][0].get<int>() + room["size"][0].get<int>();
-                if (room["position"][0].get<int>() < x_min)
-                    x_min = room["position"][0].get<int>();
-                if (room["position"][1].get<int>() + room["size"][1].get<int>() > y_max)
-                    y_max = room["position"][1].get<int>() + room["size"][1].get<int>();
-                if (room["position"][1].get<int>() < y_min)
-                    y_min = room["position"][0].get<int>();
+            int x_min = currentRoom.x;
+            int x_max = currentRoom.x + currentRoom.width;
+            int y_min = currentRoom.y;
+            int y_max = currentRoom.y + currentRoom.height;
+
+            for (const std::string &i : tRooms) {
+                const RoomInfo &room = currentMap.getRoomInfo(i);
+                if (room.x + room.width > x_max)
+                    x_max = room.x + room.width;
+                if (room.x < x_min)
+                    x_min = room.x;
+                if (room.y + room.height > y_max)
+                    y_max = room.y + room.height;
+                if (room.y < y_min)
+                    y_min = room.x;
             }
 
             x_min += cameraSize.first / 10;
@@ -783,19 +979,19 @@ void Game::updateInventory()
         }
 }
 
-std::pair<int, int> Game::loadRespawnPosition(Save respawnSave, Map respawnMap)
+std::pair<int, int> Game::loadRespawnPosition(const Save &respawnSave, const Map &respawnMap)
 {
-    nlohmann::json mapJson = (*respawnMap.getJson())["rooms"][respawnSave.getRoomID()];
-    nlohmann::json sJson = Entity::values["names"]["Samos"];
-    nlohmann::json spJson = Entity::values["names"]["Savepoint"];
+    const RoomInfo &room = respawnMap.getRoomInfo(respawnSave.getRoomID());
+    const Archetype *sType = ArchetypeRegistry::get("Samos");
+    const Archetype *spType = ArchetypeRegistry::get("Savepoint");
 
-    int x = static_cast<int>(mapJson["position"][0]) + static_cast<int>(spJson["offset_x"]) + static_cast<int>(spJson["width"]) / 2 - static_cast<int>(sJson["offset_x"]) - static_cast<int>(sJson["width"]) / 2;
-    int y = static_cast<int>(mapJson["position"][1]) + static_cast<int>(spJson["offset_y"]) + static_cast<int>(spJson["height"]) - static_cast<int>(sJson["offset_y"]) - static_cast<int>(sJson["height"]);
+    int x = room.x + spType->offsetX + spType->width / 2 - sType->offsetX - sType->width / 2;
+    int y = room.y + spType->offsetY + spType->height - sType->offsetY - sType->height;
 
-    for (nlohmann::json sp : mapJson["content"]["NPC"]["Savepoint"]) {
-        if (static_cast<int>(sp["spID"]) == respawnSave.getSavepointID()) {
-            x += static_cast<int>(sp["x"]);
-            y += static_cast<int>(sp["y"]);
+    for (std::vector<RoomInfo::SavepointInfo>::const_iterator sp = room.savepoints.begin(); sp != room.savepoints.end(); sp++) {
+        if (sp->id == respawnSave.getSavepointID()) {
+            x += sp->x;
+            y += sp->y;
             break;
         }
     }
@@ -809,8 +1005,7 @@ void Game::updateMapViewer()
         std::string mapId = currentMap.getCurrentRoomId();
         currentMap = Map::loadMap(currentMap.getName(), assetsPath);
         currentMap.setCurrentRoomId(mapId);
-        clearEntities("Samos");
-        addEntities(currentMap.loadRoom());
+        reloadCurrentRoom();
     }
 
     if (inputList["down"] && !inputList["up"]) {
@@ -828,59 +1023,69 @@ void Game::updateMapViewer()
 
 void Game::addEntity(Entity *entity)
 {
+    if (collisionGridsRoom != currentMap.getCurrentRoomId())
+        resizeCollisionGrids();
     entities.push_back(entity);
-    if (entity->getEntType() == "Terrain") {
+    if (entity->getEntType() != EntityType::Samos && entity->getEntType() != EntityType::Terrain)
+        collisionGrids[entity->getEntType()].insert(entity);
+    placeInRenderGrid(entity, renderGrid);
+    if (entity->getEntType() == EntityType::Terrain) {
         Terrain* t = static_cast<Terrain*>(entity);
         terrains.push_back(t);
-    } else if (entity->getEntType() == "Projectile") {
+    } else if (entity->getEntType() == EntityType::Projectile) {
         Projectile* p = static_cast<Projectile*>(entity);
         projectiles.push_back(p);
-    } else if (entity->getEntType() == "DynamicObj") {
+    } else if (entity->getEntType() == EntityType::DynamicObj) {
         DynamicObj* d = static_cast<DynamicObj*>(entity);
         dynamicObjs.push_back(d);
-    } else if (entity->getEntType() == "Monster") {
+    } else if (entity->getEntType() == EntityType::Monster) {
         Monster* m = static_cast<Monster*>(entity);
         monsters.push_back(m);
-    } else if (entity->getEntType() == "Area") {
+    } else if (entity->getEntType() == EntityType::Area) {
         Area* a = static_cast<Area*>(entity);
         areas.push_back(a);
-    } else if (entity->getEntType() == "NPC") {
+    } else if (entity->getEntType() == EntityType::NPC) {
         NPC* n = static_cast<NPC*>(entity);
         NPCs.push_back(n);
-    } else if (entity->getEntType() == "Samos") {
+    } else if (entity->getEntType() == EntityType::Samos) {
         s = static_cast<Samos*>(entity);
     }
 }
 
 void Game::addEntities(std::vector<Entity*> es)
 {
+    if (collisionGridsRoom != currentMap.getCurrentRoomId())
+        resizeCollisionGrids();
     for (std::vector<Entity*>::iterator entity = es.begin(); entity != es.end(); entity++) {
         entities.push_back(*entity);
-        if ((*entity)->getEntType() == "Terrain") {
+        if ((*entity)->getEntType() != EntityType::Samos && (*entity)->getEntType() != EntityType::Terrain)
+            collisionGrids[(*entity)->getEntType()].insert(*entity);
+        placeInRenderGrid(*entity, renderGrid);
+        if ((*entity)->getEntType() == EntityType::Terrain) {
             Terrain* t = static_cast<Terrain*>(*entity);
             terrains.push_back(t);
-        } else if ((*entity)->getEntType() == "Projectile") {
+        } else if ((*entity)->getEntType() == EntityType::Projectile) {
             Projectile* p = static_cast<Projectile*>(*entity);
             projectiles.push_back(p);
-        } else if ((*entity)->getEntType() == "DynamicObj") {
+        } else if ((*entity)->getEntType() == EntityType::DynamicObj) {
             DynamicObj* d = static_cast<DynamicObj*>(*entity);
             dynamicObjs.push_back(d);
-        } else if ((*entity)->getEntType() == "Monster") {
+        } else if ((*entity)->getEntType() == EntityType::Monster) {
             Monster* m = static_cast<Monster*>(*entity);
             monsters.push_back(m);
-        } else if ((*entity)->getEntType() == "Area") {
+        } else if ((*entity)->getEntType() == EntityType::Area) {
             Area* a = static_cast<Area*>(*entity);
             areas.push_back(a);
-        } else if ((*entity)->getEntType() == "NPC") {
+        } else if ((*entity)->getEntType() == EntityType::NPC) {
             NPC* n = static_cast<NPC*>(*entity);
             NPCs.push_back(n);
-        } else if ((*entity)->getEntType() == "Samos") {
+        } else if ((*entity)->getEntType() == EntityType::Samos) {
             s = static_cast<Samos*>(*entity);
         }
     }
 }
 
-void Game::clearEntities(std::string excludedType, bool deleteEntities)
+void Game::clearEntities(EntityType excludedType, bool deleteEntities)
 {
     std::vector<Entity*> nextRen;
     for (std::vector<Entity*>::iterator ent = entities.begin(); ent != entities.end(); ent ++)
@@ -897,6 +1102,8 @@ void Game::clearEntities(std::string excludedType, bool deleteEntities)
     areas = {};
     dynamicObjs = {};
     entities = {};
+    // Refit the grids to the current room, addEntities reinserts the kept entities
+    resizeCollisionGrids();
     addEntities(nextRen);
 }
 
@@ -909,87 +1116,232 @@ void Game::removeOtherRoomsEntities()
             newentities.push_back(*ent);
         else
             toDelete.push_back(*ent);
-    clearEntities("", false);
+    clearEntities(EntityType::Null, false);
     addEntities(newentities);
 }
 
-void Game::removeEntities(std::vector<Entity *> es)
+void Game::beginRoomActivation()
 {
-    std::vector<Entity*> newRen;
-    for (std::vector<Entity*>::iterator j = entities.begin(); j != entities.end(); j++) {
-        bool td = false;
-        for (std::vector<Entity*>::iterator i = es.begin(); i != es.end(); i++) {
-            if (*j == *i) {
-                td = true;
-                break;
-            }
+    activation.step = RoomActivation::Fit;
+    activation.roomId = currentMap.getCurrentRoomId();
+    activation.cursor = 0;
+    activation.entities.clear();
+    activation.terrains.clear();
+    activation.monsters.clear();
+    activation.NPCs.clear();
+    activation.projectiles.clear();
+    activation.areas.clear();
+    activation.dynamicObjs.clear();
+}
+
+void Game::updateRoomActivation()
+{
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + roomActivationLeft;
+    while (activation.step != RoomActivation::Idle && activation.step != RoomActivation::Done
+           && std::chrono::steady_clock::now() < end)
+        advanceRoomActivation();
+    roomActivationLeft = std::max(end - std::chrono::steady_clock::now(), std::chrono::steady_clock::duration::zero());
+}
+
+void Game::resetRoomActivationBudget()
+{
+    roomActivationLeft = std::chrono::microseconds(roomActivationBudget);
+}
+
+void Game::finishRoomActivation()
+{
+    if (activation.step == RoomActivation::Idle) {
+        removeOtherRoomsEntities();
+        updateLoadedRooms();
+        return;
+    }
+    // What the budget didn't leave time for, with a very short transition
+    while (activation.step != RoomActivation::Done)
+        advanceRoomActivation();
+
+    // Entities of the other rooms stay in their room's list, the room unloading deletes them
+    entities.swap(activation.entities);
+    terrains.swap(activation.terrains);
+    monsters.swap(activation.monsters);
+    NPCs.swap(activation.NPCs);
+    projectiles.swap(activation.projectiles);
+    areas.swap(activation.areas);
+    dynamicObjs.swap(activation.dynamicObjs);
+    collisionGrids.swap(activation.collisionGrids);
+    std::swap(renderGrid, activation.renderGrid);
+    collisionGridsRoom = activation.roomId;
+    // Moved during the whole transition
+    if (s != nullptr)
+        placeInRenderGrid(s, renderGrid);
+
+    // Only walks the room lists: the footprints were measured when the rooms were built, the unloads are queued
+    cacheFarRooms();
+    activation.step = RoomActivation::Idle;
+}
+
+void Game::advanceRoomActivation()
+{
+    static const EntityType gridTypes[] = {EntityType::Terrain, EntityType::Monster, EntityType::NPC,
+                                           EntityType::DynamicObj, EntityType::Area, EntityType::Projectile};
+    static const unsigned int gridTypeCount = sizeof(gridTypes) / sizeof(gridTypes[0]);
+
+    switch (activation.step) {
+    case RoomActivation::Fit: {
+        // Clearing a grid walks all its cells, so one grid at a time
+        const RoomInfo &room = currentMap.getRoomInfo(activation.roomId);
+        if (activation.cursor < gridTypeCount)
+            activation.collisionGrids[gridTypes[activation.cursor++]].resize(room.x, room.y, room.width, room.height, collisionGridCellSize);
+        else {
+            activation.renderGrid.resize(room.x, room.y, room.width, room.height, collisionGridCellSize);
+            activation.step = RoomActivation::Colliders;
+            activation.cursor = 0;
         }
-        if (!td)
-            newRen.push_back(*j);
+        break;
+    }
+    case RoomActivation::Colliders: {
+        // Terrain collides through the merged colliders, not through the rendered entities
+        std::map<std::string, StaticGeometry*>::iterator geometry = roomGeometry.find(activation.roomId);
+        const std::vector<Terrain*> &colliders = geometry != roomGeometry.end() && geometry->second != nullptr
+                ? geometry->second->getColliders() : noColliders;
+        if (activation.cursor < colliders.size())
+            activation.collisionGrids[EntityType::Terrain].insert(colliders[activation.cursor++]);
+        else {
+            activation.step = RoomActivation::Sort;
+            activation.cursor = 0;
+        }
+        break;
+    }
+    case RoomActivation::Sort:
+        // Nothing is added nor removed during a transition, so the cursor stays valid
+        if (activation.cursor < entities.size()) {
+            Entity *e = entities[activation.cursor++];
+            if (e->getEntType() == EntityType::Samos)
+                activation.entities.push_back(e);
+            else if (e->getRoomId() == activation.roomId)
+                stageEntity(e);
+        } else
+            activation.step = RoomActivation::Queue;
+        break;
+    case RoomActivation::Queue:
+        queueNeighbourRooms();
+        activation.step = RoomActivation::Done;
+        break;
+    default:
+        break;
     }
+}
 
-    monsters = {};
-    terrains = {};
-    s = nullptr;
-    dynamicObjs = {};
-    areas = {};
-    projectiles = {};
-    NPCs = {};
-    entities = {};
-    addEntities(newRen);
-    for (std::vector<Entity*>::iterator i = es.begin(); i != es.end(); i++)
+void Game::stageEntity(Entity *e)
+{
+    // The animation of the new room's entities is built now rather than on the first step after the transition
+    if (e->getArchetype() != nullptr && setupAnimation(e)) {
+        e->updateTexture();
+        e->setLastFrameState(e->getState());
+        e->setLastFrameFacing(e->getFacing());
+    }
+
+    activation.entities.push_back(e);
+    if (e->getEntType() != EntityType::Terrain)
+        activation.collisionGrids[e->getEntType()].insert(e);
+    placeInRenderGrid(e, activation.renderGrid);
+    if (e->getEntType() == EntityType::Terrain)
+        activation.terrains.push_back(static_cast<Terrain*>(e));
+    else if (e->getEntType() == EntityType::Projectile)
+        activation.projectiles.push_back(static_cast<Projectile*>(e));
+    else if (e->getEntType() == EntityType::DynamicObj)
+        activation.dynamicObjs.push_back(static_cast<DynamicObj*>(e));
+    else if (e->getEntType() == EntityType::Monster)
+        activation.monsters.push_back(static_cast<Monster*>(e));
+    else if (e->getEntType() == EntityType::Area)
+        activation.areas.push_back(static_cast<Area*>(e));
+    else if (e->getEntType() == EntityType::NPC)
+        activation.NPCs.push_back(static_cast<NPC*>(e));
+}
+
+// Removes the entities of 'dead' from 'list', keeping the order of the others
+template <typename T>
+static void eraseDead(std::vector<T*> &list, const std::set<Entity*> &dead)
+{
+    list.erase(std::remove_if(list.begin(), list.end(), [&dead](T *e) { return dead.count(e) != 0; }), list.end());
+}
+
+void Game::removeEntities(std::vector<Entity *> es)
+{
+    // Called after every physics step, nothing dies in most of them
+    if (es.empty())
+        return;
+
+    // Only the dead are taken out, the other entities keep their place in the lists and the grids
+    std::set<Entity*> dead(es.begin(), es.end());
+    eraseDead(entities, dead);
+    eraseDead(terrains, dead);
+    eraseDead(monsters, dead);
+    eraseDead(NPCs, dead);
+    eraseDead(projectiles, dead);
+    eraseDead(areas, dead);
+    eraseDead(dynamicObjs, dead);
+    if (dead.count(s) != 0)
+        s = nullptr;
+
+    for (std::set<Entity*>::iterator i = dead.begin(); i != dead.end(); i++) {
+        if ((*i)->getEntType() != EntityType::Samos && (*i)->getEntType() != EntityType::Terrain)
+            collisionGrids[(*i)->getEntType()].remove(*i);
+        renderGrid.remove(*i);
+        // Its room no longer holds it, so it isn't deleted a second time when the room is unloaded
+        std::map<std::string, std::vector<Entity*>*>::iterator room = roomEntities.find((*i)->getRoomId());
+        if (room != roomEntities.end() && room->second != nullptr)
+            room->second->erase(std::remove(room->second->begin(), room->second->end(), *i), room->second->end());
         delete *i;
+    }
+}
+
+void Game::applyPhysicsStep(const PhysicsStepResult &step)
+{
+    setDoorTransition(step.doorTransition);
+    addEntities(step.spawned);
+    removeEntities(step.dead);
+    if (step.enteredRoomId != "")
+        currentMap.setCurrentRoomId(step.enteredRoomId);
+    if (step.damageDone != 0)
+        currentProgress.addDamageDone(step.damageDone);
+    if (step.damageReceived != 0)
+        currentProgress.addDamageReceived(step.damageReceived);
 }
 
 void Game::updateAnimations()
 {
     unsigned long long uC = updateCount;
     for (std::vector<Entity*>::iterator ent = entities.begin(); ent != entities.end(); ent++) {
-        std::string state = (*ent)->getState();
-        std::string facing = (*ent)->getFacing();
+        StateId state = (*ent)->getState();
+        Facing facing = (*ent)->getFacing();
+        const Archetype *archetype = (*ent)->getArchetype();
+        if (archetype == nullptr)
+            continue;
+        const AnimationClip &clip = archetype->getClip(state);
         // Every 'refreshRate' frames
-        if (!Entity::values["textures"][(*ent)->getName()][state]["refreshRate"].is_null())
-            if (uC % static_cast<int>(Entity::values["textures"][(*ent)->getName()][state]["refreshRate"]) == 0)
+        if (clip.refreshRate > 0 && uC % clip.refreshRate == 0)
+            // If the animation index still exists
+            if ((*ent)->getCurrentAnimation().size() > (*ent)->getFrame())
+                // Increment the animation index
+                (*ent)->setFrame((*ent)->getFrame() + 1);
+
+        setupAnimation(*ent);
+
+        // Every 'refreshRate' frames
+        if (clip.refreshRate > 0 && uC % clip.refreshRate == 0) {
+            // If the animation has to loop
+            if (clip.loop) {
                 // If the animation index still exists
-                if ((*ent)->getCurrentAnimation().size() > (*ent)->getFrame())
-                    // Increment the animation index
-                    (*ent)->setFrame((*ent)->getFrame() + 1);
-
-        // If the (*ent) state is different from the last frame
-        if (state != (*ent)->getLastFrameState()
-                || facing != (*ent)->getLastFrameFacing()) {
-            // Update the QImage array representing the animation
-            (*ent)->setCurrentAnimation((*ent)->updateAnimation());
-            // If the animation should reset the next one
-            if (!Entity::values["textures"]
-                    [Entity::values["names"][(*ent)->getName()]["texture"]]
-                    [(*ent)->getLastFrameState()]
-                    ["dontReset"])
-                // Because the animation changed, reset it
-                (*ent)->setFrame(0);
-            else
-                // Else, make sure not to end up with a too high index
-                if ((*ent)->getFrame() >= (*ent)->getCurrentAnimation().size())
+                if ((*ent)->getCurrentAnimation().size() - 1 < (*ent)->getFrame())
+                    // Reset animation
                     (*ent)->setFrame(0);
+            } else
+                // If the animation index still exists
+                if ((*ent)->getCurrentAnimation().size() - 1 < (*ent)->getFrame())
+                    // If the animation doesn't loop, make sure it stays on its last frame
+                    (*ent)->setFrame((*ent)->getFrame() - 1);
         }
 
-        // Every 'refreshRate' frames
-        if (!Entity::values["textures"][(*ent)->getName()][state]["refreshRate"].is_null())
-            if (uC % static_cast<int>(Entity::values["textures"][(*ent)->getName()][state]["refreshRate"]) == 0)
-                // If the animation has to loop
-                if (!Entity::values["textures"][(*ent)->getName()][state]["loop"].is_null()) {
-                    if (Entity::values["textures"][(*ent)->getName()][state]["loop"]) {
-                        // If the animation index still exists
-                        if ((*ent)->getCurrentAnimation().size() - 1 < (*ent)->getFrame())
-                            // Reset animation
-                            (*ent)->setFrame(0);
-                    } else
-                        // If the animation index still exists
-                        if ((*ent)->getCurrentAnimation().size() - 1 < (*ent)->getFrame())
-                            // If the animation doesn't loop, make sure it stays on its last frame
-                            (*ent)->setFrame((*ent)->getFrame() - 1);
-                }
-
         // Update the texture with the animation index
         (*ent)->updateTexture();
 
@@ -997,6 +1349,28 @@ void Game::updateAnimations()
         (*ent)->setLastFrameState(state);
         (*ent)->setLastFrameFacing(facing);
     }
+
+    // The textures are final for this step
+    updateRenderGrid();
+}
+
+bool Game::setupAnimation(Entity *e)
+{
+    // If the entity state is different from the last frame
+    if (e->getState() == e->getLastFrameState() && e->getFacing() == e->getLastFrameFacing())
+        return false;
+
+    // Update the QImage array representing the animation
+    e->setCurrentAnimation(e->updateAnimation());
+    // If the animation should reset the next one
+    if (!e->getArchetype()->getClip(e->getLastFrameState()).dontReset)
+        // Because the animation changed, reset it
+        e->setFrame(0);
+    else
+        // Else, make sure not to end up with a too high index
+        if (e->getFrame() >= e->getCurrentAnimation().size())
+            e->setFrame(0);
+    return true;
 }
 
 std::vector<Entity *> *Game::getEntities()
@@ -1049,6 +1423,18 @@ void Game::setCamera(QPoint newCamera)
     camera = newCamera;
 }
 
+QPoint Game::getRenderCamera(double alpha) const
+{
+    return QPoint(std::round(previousCamera.x() + (camera.x() - previousCamera.x()) * alpha),
+                  std::round(previousCamera.y() + (camera.y() - previousCamera.y()) * alpha));
+}
+
+void Game::storePreviousState()
+{
+    BodyStore::storePreviousPositions();
+    previousCamera = camera;
+}
+
 std::vector<Terrain *>* Game::getTerrains()
 {
     return &terrains;
@@ -1229,22 +1615,22 @@ void Game::setInputTime(const std::map<std::string, double> &newInputTime)
     inputTime = newInputTime;
 }
 
-std::chrono::system_clock::time_point Game::getLastFpsShown() const
+std::chrono::steady_clock::time_point Game::getLastFpsShown() const
 {
     return lastFpsShown;
 }
 
-void Game::setLastFpsShown(std::chrono::system_clock::time_point newLastFpsShown)
+void Game::setLastFpsShown(std::chrono::steady_clock::time_point newLastFpsShown)
 {
     lastFpsShown = newLastFpsShown;
 }
 
-std::chrono::system_clock::time_point Game::getLastFrameTime() const
+std::chrono::steady_clock::time_point Game::getLastFrameTime() const
 {
     return lastFrameTime;
 }
 
-void Game::setLastFrameTime(std::chrono::system_clock::time_point newLastFrameTime)
+void Game::setLastFrameTime(std::chrono::steady_clock::time_point newLastFrameTime)
 {
     lastFrameTime = newLastFrameTime;
 }
@@ -1384,6 +1770,16 @@ void Game::setFullscreen(bool newFullscreen)
     fullscreen = newFullscreen;
 }
 
+bool Game::getIntegerScaling() const
+{
+    return integerScaling;
+}
+
+void Game::setIntegerScaling(bool newIntegerScaling)
+{
+    integerScaling = newIntegerScaling;
+}
+
 Save &Game::getCurrentProgress()
 {
     return currentProgress;
@@ -1594,6 +1990,26 @@ void Game::setRoomEntities(const std::map<std::string, std::vector<Entity *> *>
     roomEntities = newRoomEntities;
 }
 
+unsigned long long Game::getPrefetchHits() const
+{
+    return prefetchHits;
+}
+
+unsigned long long Game::getPrefetchMisses() const
+{
+    return prefetchMisses;
+}
+
+const std::list<std::pair<std::string, std::size_t>> &Game::getRoomCache() const
+{
+    return roomCache;
+}
+
+std::size_t Game::getRoomCacheBytes() const
+{
+    return roomCacheBytes;
+}
+
 std::vector<std::string> *Game::getRoomsToUnload()
 {
     return &roomsToUnload;
@@ -1613,3 +2029,69 @@ void Game::setRoomsToLoad(std::vector<std::string> &newRoomsToLoad)
 {
     roomsToLoad = newRoomsToLoad;
 }
+
+SpatialGrid *Game::getCollisionGrid(EntityType entType)
+{
+    return &collisionGrids[entType];
+}
+
+SpatialGrid *Game::getRenderGrid()
+{
+    return &renderGrid;
+}
+
+const std::vector<Terrain *> *Game::getStaticColliders()
+{
+    StaticGeometry* geometry = roomGeometry[currentMap.getCurrentRoomId()];
+    if (geometry == nullptr)
+        return &noColliders;
+    return &geometry->getColliders();
+}
+
+const StaticLayer *Game::getStaticLayer() const
+{
+    std::map<std::string, StaticLayer*>::const_iterator layer = roomLayers.find(currentMap.getCurrentRoomId());
+    if (layer == roomLayers.end())
+        return nullptr;
+    return layer->second;
+}
+
+unsigned int Game::getMaxCatchUpSteps() const
+{
+    return maxCatchUpSteps;
+}
+
+void Game::setMaxCatchUpSteps(unsigned int newMaxCatchUpSteps)
+{
+    maxCatchUpSteps = newMaxCatchUpSteps;
+}
+
+double Game::getMaxRenderRate() const
+{
+    return maxRenderRate;
+}
+
+void Game::setMaxRenderRate(double newMaxRenderRate)
+{
+    maxRenderRate = newMaxRenderRate;
+}
+
+int Game::getRenderingMultiplier() const
+{
+    return renderingMultiplier;
+}
+
+void Game::setRenderingMultiplier(int newRenderingMultiplier)
+{
+    renderingMultiplier = newRenderingMultiplier;
+}
+
+unsigned long long Game::getNarrowphaseChecks() const
+{
+    return narrowphaseChecks;
+}
+
+void Game::setNarrowphaseChecks(unsigned long long newNarrowphaseChecks)
+{
+    narrowphaseChecks = newNarrowphaseChecks;
+}
@@ -7,6 +7,11 @@
 
 #include "dialogue.h"
 #include "map.h"
+#include "physicsstepresult.h"
+#include "roomstreamer.h"
+#include "spatialgrid.h"
+#include "staticgeometry.h"
+#include "staticlayer.h"
 #include "Entities/area.h"
 #include "Entities/dynamicobj.h"
 #include "Entities/entity.h"
@@ -16,6 +21,7 @@
 #include "Entities/terrain.h"
 
 #include <QString>
+#include <list>
 class Game
 {
 public:
@@ -23,9 +29,16 @@ public:
 
     void addEntity(Entity *entity);
     void addEntities(std::vector<Entity*> es);
-    void clearEntities(std::string excludeType = "", bool deleteEntities = true);
+    void clearEntities(EntityType excludeType = EntityType::Null, bool deleteEntities = true);
     void removeOtherRoomsEntities();
+    // The room entered through a door is activated during the transition instead of in its last step:
+    // its lists and grids are built aside, a few entities per step, then swapped in at once
+    void beginRoomActivation();
+    void updateRoomActivation(); // Works for what is left of roomActivationBudget in this rendered frame
+    void resetRoomActivationBudget(); // Called for each rendered frame, the catch-up steps share one budget
+    void finishRoomActivation(); // Completes what is left, the room is then the only one updated
     void removeEntities(std::vector<Entity*> es);
+    void applyPhysicsStep(const PhysicsStepResult &step); // Applies what a physics step requested, in place
     void updateAnimations();
     void updateMapViewer();
     void updateMenu();
@@ -33,7 +46,7 @@ public:
     void updateCamera();
     void updateProgress();
     void updateInventory();
-    std::pair<int,int> loadRespawnPosition(Save respawnSave, Map respawnMap);
+    std::pair<int,int> loadRespawnPosition(const Save &respawnSave, const Map &respawnMap);
     nlohmann::json loadJson(std::string fileName); // Loads the given file name's json starting in the assets folder and returns it
     void saveJson(nlohmann::json json, std::string fileName); // Saves the json to the given location starting in the assets folder
     QString translate(std::string text, std::vector<std::string> subCategories);
@@ -42,9 +55,16 @@ public:
     void addRoomDiscovered(std::string mapName, std::string roomID);
     void die();
     void updateTas();
-    void updateAsyncRoomLoading();
+    void updateAsyncRoomLoading(); // Takes the rooms the streamer finished, where no room is being used
     void updateLoadedRooms();
+    const std::vector<Entity*> &loadRoomNow(const std::string &roomId); // Loads 'roomId' on this thread if the streamer hasn't brought it yet
+    const std::vector<Entity*> &enterRoom(const std::string &roomId); // loadRoomNow for a room entered through a door, counted as a prefetch hit or miss
+    void updatePrefetch(); // Asks the streamer first for the rooms behind the doors Samos is heading to
     void updateSpecialInputs();
+    void updateCollisionGrids(); // Moves every non-Terrain entity to its current cells
+    void updateRenderGrid(); // Moves every entity to the cells its texture now covers
+    void resizeCollisionGrids(); // Fits the grids to the current room and reinserts every entity, the render grid included
+    void buildStaticGeometry(std::string roomId, const std::vector<Entity*> &roomEnts); // (Re)builds the merged Terrain colliders and the StaticLayer of a room
 
     std::vector<Entity *> *getEntities();
     void setEntities(const std::vector<Entity *> &newRendering);
@@ -56,6 +76,8 @@ public:
     void setMenuOptions(const std::vector<std::string> &newMenuOptions);
     QPoint getCamera();
     void setCamera(QPoint newCamera);
+    QPoint getRenderCamera(double alpha) const; // Camera between the last two simulation steps
+    void storePreviousState(); // Called before each simulation step, for the interpolated rendering
     std::vector<Terrain *> *getTerrains();
     void setTerrains(const std::vector<Terrain *> &newTerrains);
     std::vector<Monster *> *getMonsters();
@@ -92,10 +114,10 @@ public:
     void setInputList(const std::map<std::string, bool> &newInputList);
     std::map<std::string, double> *getInputTime();
     void setInputTime(const std::map<std::string, double> &newInputTime);
-    std::chrono::system_clock::time_point getLastFpsShown() const;
-    void setLastFpsShown(std::chrono::system_clock::time_point newLastFpsShown);
-    std::chrono::system_clock::time_point getLastFrameTime() const;
-    void setLastFrameTime(std::chrono::system_clock::time_point newLastFrameTime);
+    std::chrono::steady_clock::time_point getLastFpsShown() const;
+    void setLastFpsShown(std::chrono::steady_clock::time_point newLastFpsShown);
+    std::chrono::steady_clock::time_point getLastFrameTime() const;
+    void setLastFrameTime(std::chrono::steady_clock::time_point newLastFrameTime);
     unsigned int getFps() const;
     void setFps(unsigned int newFps);
     unsigned int getShowFpsUpdateRate() const;
@@ -123,6 +145,8 @@ public:
     void setShowFps(bool newShowFps);
     bool getFullscreen() const;
     void setFullscreen(bool newFullscreen);
+    bool getIntegerScaling() const;
+    void setIntegerScaling(bool newIntegerScaling);
 
     Save &getCurrentProgress();
     void setCurrentProgress(const Save &newCurrentProgress);
@@ -193,14 +217,57 @@ public:
     std::vector<std::string> *getRoomsToLoad();
     void setRoomsToLoad(std::vector<std::string> &newRoomsToLoad);
 
+    SpatialGrid *getCollisionGrid(EntityType entType);
+    SpatialGrid *getRenderGrid(); // Entities by the area their texture covers, for the view culling
+    const std::vector<Terrain*> *getStaticColliders(); // Merged Terrain colliders of the current room
+    const StaticLayer *getStaticLayer() const; // Still scenery of the current room, nullptr if it isn't built
+
+    unsigned long long getNarrowphaseChecks() const;
+    unsigned long long getPrefetchHits() const;
+    unsigned long long getPrefetchMisses() const;
+    const std::list<std::pair<std::string, std::size_t>> &getRoomCache() const;
+    std::size_t getRoomCacheBytes() const;
+    void setNarrowphaseChecks(unsigned long long newNarrowphaseChecks);
+
+    unsigned int getMaxCatchUpSteps() const;
+    void setMaxCatchUpSteps(unsigned int newMaxCatchUpSteps);
+    double getMaxRenderRate() const;
+    void setMaxRenderRate(double newMaxRenderRate);
+    int getRenderingMultiplier() const;
+    void setRenderingMultiplier(int newRenderingMultiplier);
+
 private:
+    void placeInRenderGrid(Entity* e, SpatialGrid &grid); // Inserts 'e' or moves it to the cells its texture covers
+    bool setupAnimation(Entity* e); // Gives 'e' the animation of its state and facing if they changed since the last update
+    void advanceRoomActivation(); // One unit of work of the activation: a grid, a collider or an entity
+    void stageEntity(Entity* e); // Adds 'e' to the activation's lists and grids
+    void queueNeighbourRooms();
+    void cacheFarRooms(); // Puts the rooms away from the current one in the cache, unloads the ones beyond the budget
+    StreamedRoom loadedRoom(const std::string &roomId); // Every part of a loaded room, still held by the Game
+    StreamedRoom takeRoom(const std::string &roomId); // Forgets every part of a loaded room, to hand it to the streamer
+    void requestRoom(const std::string &roomId, RoomStreamer::Priority priority); // Queues 'roomId' unless it is loaded, raises it if needed
+    // Unloads every room and empties the lists, the streamer loads from 'currentMap' from now on. Samos isn't deleted
+    void unloadAllRooms();
+    void reloadCurrentRoom(); // Loads the current room of 'currentMap' again, keeping Samos
+
     std::string assetsPath;
 
-    std::thread* roomWorker = nullptr;
-    std::atomic<bool> workerFinished{false};
-    std::vector<std::string> roomsToLoad;
+    RoomStreamer roomStreamer;
+    std::vector<std::string> roomsToLoad; // Asked to the streamer and not taken back yet
     std::vector<std::string> roomsToUnload;
+    double prefetchLookAhead = 1.0; // in s, doors Samos reaches within this time get their room loaded first
+    double prefetchFacingSpeed = 200.0; // in px/s, added to the speed towards the doors Samos faces, as it is likely to go there
+    unsigned long long prefetchHits = 0; // Rooms entered through a door that were already loaded
+    unsigned long long prefetchMisses = 0; // Rooms entered through a door that had to be loaded on the game thread
     std::map<std::string, std::vector<Entity*>*> roomEntities; // map<roomId, entities>, used to get the entities of a room using its id
+    std::map<std::string, StaticGeometry*> roomGeometry; // map<roomId, geometry>, built along with roomEntities
+    std::map<std::string, StaticLayer*> roomLayers; // map<roomId, layer>, built along with roomGeometry
+    std::map<std::string, RoomArena*> roomArenas; // map<roomId, arena>, memory of the entities in roomEntities
+    std::map<std::string, std::size_t> roomFootprints; // map<roomId, bytes>, RoomStreamer::footprint once the room was built
+    std::list<std::pair<std::string, std::size_t>> roomCache; // Loaded rooms away from the current one with their footprint, the most recently left first
+    std::size_t roomCacheBytes = 0; // Sum of the footprints in roomCache
+    std::size_t roomCacheBudget = 64 * 1024 * 1024; // in bytes, the least recently left rooms are unloaded beyond it
+    std::vector<Terrain*> noColliders; // Returned when the current room has no geometry
     std::vector<Entity*> entities;
     std::vector<Terrain*> terrains;
     std::vector<Monster*> monsters;
@@ -209,15 +276,42 @@ private:
     std::vector<Area*> areas;
     std::vector<DynamicObj*> dynamicObjs;
     Samos* s = nullptr;
+    std::map<EntityType, SpatialGrid> collisionGrids; // map<entType, grid>, broadphase used by the physics
+    struct RoomActivation {
+        enum Step { Idle, Fit, Colliders, Sort, Queue, Done };
+        Step step = Idle;
+        std::string roomId;
+        unsigned int cursor = 0; // In the current step
+        std::vector<Entity*> entities; // Those of 'roomId' and Samos, the other rooms' are left out
+        std::vector<Terrain*> terrains;
+        std::vector<Monster*> monsters;
+        std::vector<NPC*> NPCs;
+        std::vector<Projectile*> projectiles;
+        std::vector<Area*> areas;
+        std::vector<DynamicObj*> dynamicObjs;
+        std::map<EntityType, SpatialGrid> collisionGrids; // Swapped with the game's, so the previous ones are reused next time
+        SpatialGrid renderGrid;
+    };
+    RoomActivation activation;
+    unsigned int roomActivationBudget = 2000; // in µs, of work done by updateRoomActivation in each rendered frame of a door transition
+    std::chrono::steady_clock::duration roomActivationLeft = std::chrono::steady_clock::duration::zero(); // Of the budget, in this rendered frame
+    std::string collisionGridsRoom = ""; // ID of the room the grids are currently fitted to
+    int collisionGridCellSize = SpatialGrid::defaultCellSize;
+    SpatialGrid renderGrid; // Every entity by the area its texture covers, kept along with the collision grids
+    unsigned long long narrowphaseChecks = 0; // Entity::checkCollision calls made during the last frame
     int selectedOption = 0;
     std::string menu;
     std::vector<std::string> menuOptions;
     QPoint camera = QPoint(0,0);
+    QPoint previousCamera = QPoint(0,0); // Camera before the last simulation step
 
     bool mapViewer = false; // Whether the game the game was launched as a map viewer
     bool running = true;
     double updateRate = 60.0; // How many animation updates in one second
     double gameSpeed = 1.0;
+    unsigned int maxCatchUpSteps = 5; // Simulation steps run at most between two rendered frames, the late time is dropped
+    double maxRenderRate = 240.0; // Rendered frames per second at most
+    int renderingMultiplier = 1; // Textures are rendered with their size multiplied by this value, used to bake the StaticLayers
     unsigned long long frameCount = 0;
     unsigned long long updateCount = 0;
     nlohmann::json keyCodes;
@@ -225,8 +319,8 @@ private:
     nlohmann::json stringsJson;
     std::map<std::string, bool> inputList;
     std::map<std::string, double> inputTime;
-    std::chrono::system_clock::time_point lastFpsShown; // Time of the last frame in which the shown fps were updated
-    std::chrono::system_clock::time_point lastFrameTime; // Time of the last frame in which the shown fps were updated
+    std::chrono::steady_clock::time_point lastFpsShown; // Time of the last frame in which the shown fps were updated
+    std::chrono::steady_clock::time_point lastFrameTime; // Time of the last frame in which the shown fps were updated
     unsigned int fps = 0; // Fps count when 'lastFpsShown' was updated
     unsigned int showFpsUpdateRate = 500000000; // Time (in ns) between each fps update
     bool isPaused = false;
@@ -240,6 +334,7 @@ private:
     bool renderHitboxes = false; // Render hitboxes as rectangles
     bool showFps = true; // Whether to show fps in-game
     bool fullscreen = true;
+    bool integerScaling = false; // Upscale the rendered frame by a whole factor only, with black bars around it
     Save currentProgress;
     Save lastSave;
     Save lastCheckpoint;
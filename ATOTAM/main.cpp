@@ -4,6 +4,7 @@
 
 #include <QApplication>
 #include <QImage>
+#include <algorithm>
 #include <unistd.h>
 #include <future>
 #include <iostream>
@@ -17,213 +18,254 @@
 
 #include <Easing/Cubic.h>
 
-void gameClock(MainWindow* w) {
-    long waitTime;
-    unsigned long long prevCount;
-    double timeLeftCameraMove;
+// Where the camera and Samos are going while passing through a door, kept from one simulation step to the next
+struct DoorTransitionState {
+    double timeLeftCameraMove = 0.0;
     QPoint* startingCameraPos = nullptr;
     QPoint startingSamosPos;
     QPoint cameraDist;
+};
+
+// Runs one simulation step. Returns false if nothing was simulated because the TAS waits for a frame advance
+bool stepGame(MainWindow* w, DoorTransitionState &door) {
     const double cameraMoveTime = 0.75;
     const int samosDoorMove = 100;
 
     Game* g = w->getGame();
-    while (g->getRunning()) {
-        waitTime = 1000000.0/(Physics::frameRate * g->getGameSpeed());
-        if ((*g->getInputList())["SPECIAL_fastForward"])
-            waitTime /= 4;
-        else if ((*g->getInputList())["SPECIAL_slowForward"])
-            waitTime *= 4;
-        auto end = std::chrono::high_resolution_clock::now() + std::chrono::microseconds(waitTime);
-
-        if (g->getTasToolEnabled()) {
-            w->getSpecialInputs();
-            g->updateSpecialInputs();
-            if ((!((*g->getInputList())["SPECIAL_frameAdvance"]
-                    && (*g->getInputTime())["SPECIAL_frameAdvance"] == 0)
-                    && g->getFrameAdvance())
-                    && !(*g->getInputList())["SPECIAL_slowForward"]
-                    && !(*g->getInputList())["SPECIAL_fastForward"]) {
-                // Wait between frames
-                while (std::chrono::high_resolution_clock::now() < end) {
-                    std::this_thread::sleep_for(std::chrono::microseconds(999));
-                }
-                continue;
-            }
-
-            g->updateTas();
-        }
-        if (!g->getTas()) {
-            w->getInputs();
+    if (g->getTasToolEnabled()) {
+        w->getSpecialInputs();
+        g->updateSpecialInputs();
+        if ((!((*g->getInputList())["SPECIAL_frameAdvance"]
+                && (*g->getInputTime())["SPECIAL_frameAdvance"] == 0)
+                && g->getFrameAdvance())
+                && !(*g->getInputList())["SPECIAL_slowForward"]
+                && !(*g->getInputList())["SPECIAL_fastForward"]) {
+            // Waiting for a frame advance
+            return false;
         }
 
-        // Update FPS if it has to
-        if ((std::chrono::high_resolution_clock::now() - g->getLastFpsShown()).count() > g->getShowFpsUpdateRate())
-            g->setFps(1000000000 / (std::chrono::high_resolution_clock::now() - g->getLastFrameTime()).count());
-
-        // And update the last frame time
-        g->setLastFrameTime(std::chrono::high_resolution_clock::now());
-
-        prevCount = std::round(g->getFrameCount() * 60.0 / Physics::frameRate);
-        g->setFrameCount(g->getFrameCount() + 1);
-        g->setUpdateCount(std::round(g->getFrameCount() * 60.0 / Physics::frameRate));
-
-        if (g->getDoorTransition() == "") {
-
-            g->updateAsyncRoomLoading();
-
-            if (!g->getIsPaused()) {
-                if (!g->getInInventory() && !g->getInMap()) {
-                    if (!g->getMapViewer()) {
-                        // Update physics
-                        if (g->getS() != nullptr) {
-                            g->addEntities(Physics::updateSamos(g));
-                            g->updateNPCs();
-                            g->updateCamera();
-                        }
-                        std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> physicsOutput
-                                = Physics::updatePhysics(g);
-                        g->setDoorTransition(std::get<0>(physicsOutput));
-                        g->addEntities(std::get<1>(physicsOutput));
-                        g->removeEntities(std::get<2>(physicsOutput));
-                        g->setCurrentMap(std::get<3>(physicsOutput));
-                        g->setCurrentProgress(std::get<4>(physicsOutput));
-
-                        if (g->getS()->getHealth() <= 0) {
-                            g->die();
-                        }
-                    } else {
-                        g->updateMapViewer();
+        g->updateTas();
+    }
+    if (!g->getTas()) {
+        w->getInputs();
+    }
+
+    unsigned long long prevCount = std::round(g->getFrameCount() * 60.0 / Physics::frameRate);
+    g->setFrameCount(g->getFrameCount() + 1);
+    g->setUpdateCount(std::round(g->getFrameCount() * 60.0 / Physics::frameRate));
+
+    if (g->getDoorTransition() == "") {
+
+        g->updateAsyncRoomLoading();
+        g->updatePrefetch();
+
+        if (!g->getIsPaused()) {
+            if (!g->getInInventory() && !g->getInMap()) {
+                if (!g->getMapViewer()) {
+                    Entity::collisionChecks = 0;
+                    // Update physics
+                    if (g->getS() != nullptr) {
+                        g->addEntities(Physics::updateSamos(g));
+                        g->updateNPCs();
+                        g->updateCamera();
                     }
+                    g->applyPhysicsStep(Physics::updatePhysics(g));
+                    g->setNarrowphaseChecks(Entity::collisionChecks);
 
-                    if (prevCount != g->getUpdateCount())
-                        g->updateAnimations();
+                    if (g->getS()->getHealth() <= 0) {
+                        g->die();
+                    }
+                } else {
+                    g->updateMapViewer();
                 }
 
-                g->updateInventory();
-            }
-            if (!g->getInInventory() && !g->getInMap())
-                g->updateMenu();
-
-            // Fullscreen update
-            if (w->isFullScreen()) {
-                if (!g->getFullscreen())
-                    w->showNormal();
-            } else {
-                if (g->getFullscreen())
-                    w->showFullScreen();
+                if (prevCount != g->getUpdateCount())
+                    g->updateAnimations();
             }
+
+            g->updateInventory();
+        }
+        if (!g->getInInventory() && !g->getInMap())
+            g->updateMenu();
+
+        // Fullscreen update
+        if (w->isFullScreen()) {
+            if (!g->getFullscreen())
+                w->showNormal();
         } else {
-            if (g->getS() != nullptr) {
-                // Make sure we can't pause while changing room
-                g->setInInventory(false);
-                g->setInMap(false);
-                g->setIsPaused(false);
-
-                nlohmann::json roomJson = (*g->getCurrentMap().getJson())["rooms"][g->getCurrentMap().getCurrentRoomId()];
-
-                int roomS_x = roomJson["position"][0];
-                int roomS_y = roomJson["position"][1];
-                int roomE_x = roomJson["size"][0];
-                int roomE_y = roomJson["size"][1];
-                roomE_x += roomS_x;
-                roomE_y += roomS_y;
-
-                // Set starting values
-
-                if (startingCameraPos == nullptr) {
-                    startingCameraPos = new QPoint(g->getCamera());
-                    startingSamosPos = QPoint(g->getS()->getX(), g->getS()->getY());
-                    timeLeftCameraMove = cameraMoveTime;
-                    if (g->getDoorTransition() == "Right") {
-                        cameraDist.setX(roomS_x);
-                        cameraDist.setY(g->getS()->getY() + static_cast<int>(Entity::values["general"]["camera_ry"]));
-                    } else if (g->getDoorTransition() == "Left") {
-                        cameraDist.setX(roomE_x - g->getCameraSize().first);
-                        cameraDist.setY(g->getS()->getY() + static_cast<int>(Entity::values["general"]["camera_ry"]));
-                    } else if (g->getDoorTransition() == "Up") {
-                        cameraDist.setX(g->getS()->getX() + static_cast<int>(Entity::values["general"]["camera_rx"]));
-                        cameraDist.setY(roomE_y - g->getCameraSize().second);
-                    } else if (g->getDoorTransition() == "Down") {
-                        cameraDist.setX(g->getS()->getX() + static_cast<int>(Entity::values["general"]["camera_rx"]));
-                        cameraDist.setY(roomS_y);
-                    }
-                    if (cameraDist.x() < roomS_x)
-                        cameraDist.setX(roomS_x);
-                    else if (cameraDist.x() + g->getCameraSize().first > roomE_x)
-                        cameraDist.setX(roomE_x - g->getCameraSize().first);
-                    if (cameraDist.y() < roomS_y)
-                        cameraDist.setY(roomS_y);
-                    else if (cameraDist.y() + g->getCameraSize().second > roomE_y)
-                        cameraDist.setY(roomE_y - g->getCameraSize().second);
-
-                    cameraDist.setX(cameraDist.x() - startingCameraPos->x());
-                    cameraDist.setY(cameraDist.y() - startingCameraPos->y());
-                } else
-                    // Set time left
-                    timeLeftCameraMove -= 1 / Physics::frameRate;
-
-                // Set camera position
-                QPoint camera = g->getCamera();
-
-                camera.setX(Cubic::easeInOut(cameraMoveTime - timeLeftCameraMove, startingCameraPos->x(), cameraDist.x(), cameraMoveTime));
-                camera.setY(Cubic::easeInOut(cameraMoveTime - timeLeftCameraMove, startingCameraPos->y(), cameraDist.y(), cameraMoveTime));
-
-                g->setCamera(camera);
-
-                // Set Samos position
-                int samosPos = 0;
+            if (g->getFullscreen())
+                w->showFullScreen();
+        }
+    } else {
+        if (g->getS() != nullptr) {
+            // Make sure we can't pause while changing room
+            g->setInInventory(false);
+            g->setInMap(false);
+            g->setIsPaused(false);
+
+            const RoomInfo &room = g->getCurrentMap().getCurrentRoomInfo();
+
+            int roomS_x = room.x;
+            int roomS_y = room.y;
+            int roomE_x = room.x + room.width;
+            int roomE_y = room.y + room.height;
+
+            // Set starting values
+
+            if (door.startingCameraPos == nullptr) {
+                door.startingCameraPos = new QPoint(g->getCamera());
+                door.startingSamosPos = QPoint(g->getS()->getX(), g->getS()->getY());
+                door.timeLeftCameraMove = cameraMoveTime;
+                g->beginRoomActivation();
                 if (g->getDoorTransition() == "Right") {
-                    samosPos = Cubic::easeOut(cameraMoveTime - timeLeftCameraMove, startingSamosPos.x(), samosDoorMove, cameraMoveTime);
-                    g->getS()->setX(samosPos);
+                    door.cameraDist.setX(roomS_x);
+                    door.cameraDist.setY(g->getS()->getY() + static_cast<int>(Entity::values["general"]["camera_ry"]));
                 } else if (g->getDoorTransition() == "Left") {
-                    samosPos = Cubic::easeOut(cameraMoveTime - timeLeftCameraMove, startingSamosPos.x(), -samosDoorMove, cameraMoveTime);
-                    g->getS()->setX(samosPos);
+                    door.cameraDist.setX(roomE_x - g->getCameraSize().first);
+                    door.cameraDist.setY(g->getS()->getY() + static_cast<int>(Entity::values["general"]["camera_ry"]));
                 } else if (g->getDoorTransition() == "Up") {
-                    samosPos = Cubic::easeOut(cameraMoveTime - timeLeftCameraMove, startingSamosPos.y(), -1.5*samosDoorMove, cameraMoveTime);
-                    g->getS()->setY(samosPos);
+                    door.cameraDist.setX(g->getS()->getX() + static_cast<int>(Entity::values["general"]["camera_rx"]));
+                    door.cameraDist.setY(roomE_y - g->getCameraSize().second);
                 } else if (g->getDoorTransition() == "Down") {
-                    samosPos = Cubic::easeOut(cameraMoveTime - timeLeftCameraMove, startingSamosPos.y(), 1.25*samosDoorMove, cameraMoveTime);
-                    g->getS()->setY(samosPos);
+                    door.cameraDist.setX(g->getS()->getX() + static_cast<int>(Entity::values["general"]["camera_rx"]));
+                    door.cameraDist.setY(roomS_y);
                 }
+                if (door.cameraDist.x() < roomS_x)
+                    door.cameraDist.setX(roomS_x);
+                else if (door.cameraDist.x() + g->getCameraSize().first > roomE_x)
+                    door.cameraDist.setX(roomE_x - g->getCameraSize().first);
+                if (door.cameraDist.y() < roomS_y)
+                    door.cameraDist.setY(roomS_y);
+                else if (door.cameraDist.y() + g->getCameraSize().second > roomE_y)
+                    door.cameraDist.setY(roomE_y - g->getCameraSize().second);
+
+                door.cameraDist.setX(door.cameraDist.x() - door.startingCameraPos->x());
+                door.cameraDist.setY(door.cameraDist.y() - door.startingCameraPos->y());
+            } else
+                // Set time left
+                door.timeLeftCameraMove -= 1 / Physics::frameRate;
+
+            // Set camera position
+            QPoint camera = g->getCamera();
+
+            camera.setX(Cubic::easeInOut(cameraMoveTime - door.timeLeftCameraMove, door.startingCameraPos->x(), door.cameraDist.x(), cameraMoveTime));
+            camera.setY(Cubic::easeInOut(cameraMoveTime - door.timeLeftCameraMove, door.startingCameraPos->y(), door.cameraDist.y(), cameraMoveTime));
+
+            g->setCamera(camera);
+
+            // Set Samos position
+            int samosPos = 0;
+            if (g->getDoorTransition() == "Right") {
+                samosPos = Cubic::easeOut(cameraMoveTime - door.timeLeftCameraMove, door.startingSamosPos.x(), samosDoorMove, cameraMoveTime);
+                g->getS()->setX(samosPos);
+            } else if (g->getDoorTransition() == "Left") {
+                samosPos = Cubic::easeOut(cameraMoveTime - door.timeLeftCameraMove, door.startingSamosPos.x(), -samosDoorMove, cameraMoveTime);
+                g->getS()->setX(samosPos);
+            } else if (g->getDoorTransition() == "Up") {
+                samosPos = Cubic::easeOut(cameraMoveTime - door.timeLeftCameraMove, door.startingSamosPos.y(), -1.5*samosDoorMove, cameraMoveTime);
+                g->getS()->setY(samosPos);
+            } else if (g->getDoorTransition() == "Down") {
+                samosPos = Cubic::easeOut(cameraMoveTime - door.timeLeftCameraMove, door.startingSamosPos.y(), 1.25*samosDoorMove, cameraMoveTime);
+                g->getS()->setY(samosPos);
+            }
 
-                // When the move is over
-                if (timeLeftCameraMove <= 0) {
-                    delete startingCameraPos;
-                    startingCameraPos = nullptr;
-                    g->setDoorTransition("");
-                    g->getS()->setRoomId(g->getCurrentMap().getCurrentRoomId());
+            // Spread the entered room's activation over the transition
+            g->updateRoomActivation();
 
-                    g->addRoomDiscovered(g->getCurrentMap().getName(), g->getCurrentMap().getCurrentRoomId());
+            // When the move is over
+            if (door.timeLeftCameraMove <= 0) {
+                delete door.startingCameraPos;
+                door.startingCameraPos = nullptr;
+                g->setDoorTransition("");
+                g->getS()->setRoomId(g->getCurrentMap().getCurrentRoomId());
 
-                    // Stop updating the last room
-                    g->removeOtherRoomsEntities();
-                    g->updateLoadedRooms();
+                g->addRoomDiscovered(g->getCurrentMap().getName(), g->getCurrentMap().getCurrentRoomId());
 
-                    g->updateAnimations();
-                }
+                // Stop updating the last room, its lists were built during the transition
+                g->finishRoomActivation();
             }
         }
+    }
 
-        // Only paint if not in ultra fast forward or every 60 frames
-        if (!g->getUltraFastForward() || g->getFrameCount() % 60 == 0) {
-            // Eventually render the game
-            if (!w->getCopyingToDraw()) {
-                w->setRender(false);
-                w->setupToDraw();
-            }
-            w->setRender(true);
-            w->update();
-        }
+    return true;
+}
+
+// Sends the state 'alpha' of the way between the last two simulation steps to the GUI thread
+void renderFrame(MainWindow* w, double alpha) {
+    Game* g = w->getGame();
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    // Update FPS if it has to
+    if (std::chrono::duration_cast<std::chrono::nanoseconds>(now - g->getLastFpsShown()).count() > g->getShowFpsUpdateRate())
+        g->setFps(1000000000 / std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(now - g->getLastFrameTime()).count(), static_cast<std::chrono::nanoseconds::rep>(1)));
+
+    // And update the last frame time
+    g->setLastFrameTime(now);
+
+    // Publish a new frame, the render worker rasterizes it and asks the GUI thread to present it
+    w->setupToDraw(alpha);
+    // The steps until the next frame share the room activation budget
+    g->resetRoomActivationBudget();
+}
+
+void gameClock(MainWindow* w) {
+    DoorTransitionState door;
+    Game* g = w->getGame();
+
+    // The simulation always advances by steps of 1 / Physics::frameRate, whatever the rendering rate is.
+    // 'lag' is the game time (in s) that went by but isn't simulated yet, the rendering interpolates inside it
+    double lag = 0.0;
+    std::chrono::steady_clock::time_point previousTime = std::chrono::steady_clock::now();
 
-        // Only wait if not in ultra fast forward
-        if (!g->getUltraFastForward())
-            // Wait between frames
-            while (std::chrono::high_resolution_clock::now() < end) {
+    while (g->getRunning()) {
+        double step = 1.0 / Physics::frameRate;
+        double speed = g->getGameSpeed();
+        if ((*g->getInputList())["SPECIAL_fastForward"])
+            speed *= 4;
+        else if ((*g->getInputList())["SPECIAL_slowForward"])
+            speed /= 4;
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        lag += std::chrono::duration<double>(now - previousTime).count() * speed;
+        previousTime = now;
+
+        if (g->getUltraFastForward()) {
+            // As fast as possible, only painting every 60 frames
+            g->storePreviousState();
+            lag = 0.0;
+            if (stepGame(w, door)) {
+                if (g->getFrameCount() % 60 == 0)
+                    renderFrame(w, 1.0);
+                continue;
+            }
+            // The TAS waits for a frame advance: paint once and wait for a step like the normal path
+            renderFrame(w, 1.0);
+            std::chrono::steady_clock::time_point end = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(step / speed));
+            while (std::chrono::steady_clock::now() < end) {
                 std::this_thread::sleep_for(std::chrono::microseconds(999));
             }
+            continue;
+        }
+
+        // After a hitch, only catch up a few steps instead of falling further and further behind
+        if (lag > step * g->getMaxCatchUpSteps())
+            lag = step * g->getMaxCatchUpSteps();
+        while (lag >= step) {
+            g->storePreviousState();
+            stepGame(w, door);
+            lag -= step;
+        }
+
+        renderFrame(w, lag / step);
+
+        // Wait for the next simulation step or the next frame, whichever comes first
+        std::chrono::steady_clock::time_point end = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(std::min((step - lag) / speed, 1.0 / g->getMaxRenderRate())));
+        while (std::chrono::steady_clock::now() < end) {
+            std::this_thread::sleep_for(std::chrono::microseconds(999));
+        }
     }
-    w->setRender(true);
 
     // Close the window
     if (w != nullptr) {
@@ -231,8 +273,8 @@ void gameClock(MainWindow* w) {
         w->close();
     }
 
-    // Just in case but at this point 'startingCameraPos' should be a nullptr anyway
-    delete startingCameraPos;
+    // Just in case but at this point 'door.startingCameraPos' should be a nullptr anyway
+    delete door.startingCameraPos;
 }
 
 int main(int argc, char *argv[])
@@ -243,6 +285,7 @@ int main(int argc, char *argv[])
     std::srand(time(NULL));
     std::string assetsPath = "../ATOTAM/assets";
     Entity::values = Entity::loadValues(assetsPath);
+    ArchetypeRegistry::compile(Entity::values);
     MainWindow w(&a, assetsPath);
 
     // Start the game update clock
@@ -9,16 +9,24 @@
 #include <Entities/door.h>
 #include <Entities/npc.h>
 #include <QSplitter>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 MainWindow::MainWindow(QApplication *app, std::string assetsPath)
     : m_qApp(app)
     , game(new Game(assetsPath, "1"))
-    , errorTexture(QString::fromStdString(game->getAssetsPath() + "/textures/error.png"))
-    , emptyTexture(QString::fromStdString(game->getAssetsPath() + "/textures/empty.png"))
+    , errorTexture(AnimationCache::displayReady(QImage(QString::fromStdString(game->getAssetsPath() + "/textures/error.png"))))
+    , emptyTexture(AnimationCache::displayReady(QImage(QString::fromStdString(game->getAssetsPath() + "/textures/empty.png"))))
+    , minimosTexture(AnimationCache::displayReady(QImage(QString::fromStdString(game->getAssetsPath() + "/textures/"
+                                                                                + Entity::values["textures"]["Map"]["Samos"]["file"].get<std::string>()))))
 {
     setFixedSize(game->getResolution().first, game->getResolution().second);
 
+    // Before showing the window, which resizes it
+    renderWorker = new RenderWorker(frames, this, minimosTexture, palette().color(QPalette::Window));
+    renderWorker->setOutputSize(width(), height());
+
     renderingMultiplier = Entity::values["general"]["renderingMultiplier"];
 
     if (game->getFullscreen())
@@ -31,15 +39,12 @@ MainWindow::MainWindow(QApplication *app, std::string assetsPath)
 
 MainWindow::~MainWindow()
 {
+    delete renderWorker;
     delete game;
 }
 
 bool MainWindow::eventFilter(QObject* object, QEvent* event) {
-     if (event->type() == QEvent::Paint && !render && object == this) {
-         render = false;
-         return true;
-     }
-     else if (event->type() == QEvent::KeyPress && object == this) {
+     if (event->type() == QEvent::KeyPress && object == this) {
          QKeyEvent * keyEvent = dynamic_cast<QKeyEvent*>(event);
          if (keyEvent->key() == Qt::Key_Tab)
              return true;
@@ -47,36 +52,6 @@ bool MainWindow::eventFilter(QObject* object, QEvent* event) {
      return false;
 }
 
-bool MainWindow::getCopyingToDraw() const
-{
-    return copyingToDraw;
-}
-
-void MainWindow::setCopyingToDraw(bool newCopyingToDraw)
-{
-    copyingToDraw = newCopyingToDraw;
-}
-
-const std::map<int, QImage> &MainWindow::getToDrawTextures() const
-{
-    return toDrawTextures;
-}
-
-void MainWindow::setToDrawTextures(const std::map<int, QImage> &newToDrawTextures)
-{
-    toDrawTextures = newToDrawTextures;
-}
-
-const nlohmann::json &MainWindow::getToDraw() const
-{
-    return toDraw;
-}
-
-void MainWindow::setToDraw(const nlohmann::json &newToDraw)
-{
-    toDraw = newToDraw;
-}
-
 void MainWindow::getInputs()
 {
     for (std::map<std::string, bool>::iterator i = game->getInputList()->begin(); i != game->getInputList()->end(); i ++) {
@@ -133,33 +108,62 @@ void MainWindow::getSpecialInputs()
     }
 }
 
-void MainWindow::setupToDraw()
+void MainWindow::setupToDraw(double alpha)
 {
-    toDrawTextures.clear();
-    toDraw.clear();
-
-    toDraw["camera_position_x"] = game->getCamera().x();
-    toDraw["camera_position_y"] = game->getCamera().y();
-    toDraw["camera_size_x"] = game->getCameraSize().first;
-    toDraw["camera_size_y"] = game->getCameraSize().second;
-    toDraw["renderingMultiplier"] = renderingMultiplier;
-
-    toDraw["inInventory"] = game->getInInventory();
-    toDraw["inMap"] = game->getInMap();
-    toDraw["renderHitboxes"] = game->getRenderHitboxes();
-    toDraw["showFps"] = game->getShowFps();
-    toDraw["showHUD"] = game->getShowHUD();
-    toDraw["inDialogue"] = !game->getCurrentDialogue().isNull();
-    toDraw["isPaused"] = game->getIsPaused();
-    toDraw["updateCount"] = game->getUpdateCount();
-    toDraw["showDebugInfo"] = game->getShowDebugInfo();
-
-
-    if (!game->getInInventory() && !game->getInMap()) {
-        std::map<float, std::vector<nlohmann::json>> entitiesInfo;
-        for (std::vector<Entity*>::iterator ent = game->getEntities()->begin(); ent != game->getEntities()->end(); ent++) {
-            // Make sure not to use a null pointer in case there is one
-            if (*ent == nullptr)
+    RenderFrame &frame = frames.getBackFrame();
+    frame.clear();
+
+    QPoint camera = game->getRenderCamera(alpha);
+    frame.cameraX = camera.x();
+    frame.cameraY = camera.y();
+    frame.cameraWidth = game->getCameraSize().first;
+    frame.cameraHeight = game->getCameraSize().second;
+    frame.backbufferWidth = frame.cameraWidth / renderingMultiplier;
+    frame.backbufferHeight = frame.cameraHeight / renderingMultiplier;
+    frame.integerScaling = game->getIntegerScaling();
+    frame.inMap = game->getInInventory() || game->getInMap();
+    frame.isPaused = game->getIsPaused();
+    frame.inDialogue = !game->getCurrentDialogue().isNull();
+    frame.showDebugInfo = game->getShowDebugInfo() && game->getS() != nullptr;
+
+    if (!frame.inMap) {
+        // Sprites, ordered by layer, then by room priority and texture, see RenderQueue
+        renderQueue.clear();
+        queuedSprites.clear();
+        std::string currentRoomId = game->getCurrentMap().getCurrentRoomId();
+
+        // The backbuffer is the camera at the logical resolution. Every position is rounded down
+        // to a logical pixel the same way, so that the sprites and the chunks stay aligned
+        int cameraX = StaticLayer::toLogical(camera.x(), renderingMultiplier);
+        int cameraY = StaticLayer::toLogical(camera.y(), renderingMultiplier);
+
+        // The room's still scenery comes first in its layer, as a few chunks,
+        // under the current room's other entities but over the other rooms' ones
+        const StaticLayer *staticLayer = game->getStaticLayer();
+        if (staticLayer != nullptr)
+            for (std::map<float, std::vector<StaticLayer::Chunk>>::const_iterator layer = staticLayer->getChunks().begin(); layer != staticLayer->getChunks().end(); layer++)
+                for (std::vector<StaticLayer::Chunk>::const_iterator chunk = layer->second.begin(); chunk != layer->second.end(); chunk++) {
+                    if (chunk->x + StaticLayer::chunkSize < cameraX || chunk->x > cameraX + frame.backbufferWidth
+                            || chunk->y + StaticLayer::chunkSize < cameraY || chunk->y > cameraY + frame.backbufferHeight)
+                        continue;
+                    RenderFrame::Sprite sprite;
+                    sprite.x = chunk->x - cameraX;
+                    sprite.y = chunk->y - cameraY;
+                    sprite.texture = frame.textures.size();
+                    frame.textures.push_back(chunk->image);
+                    renderQueue.push(layer->first, 1, RenderQueue::textureKey(chunk->image.cacheKey()), queuedSprites.size());
+                    queuedSprites.push_back(sprite);
+                }
+
+        // Only the entities around the camera, the grid holds the simulated positions and the sprites are drawn
+        // at interpolated ones, hence the margin
+        visibleEntities.clear();
+        game->getRenderGrid()->queryArea(camera.x() - cullingMargin, camera.y() - cullingMargin,
+                                         game->getCameraSize().first + 2 * cullingMargin, game->getCameraSize().second + 2 * cullingMargin,
+                                         visibleEntities);
+        for (std::vector<Entity*>::iterator ent = visibleEntities.begin(); ent != visibleEntities.end(); ent++) {
+            // Already drawn in a chunk, entity IDs are unique across rooms
+            if (staticLayer != nullptr && staticLayer->isBaked(*ent))
                 continue;
 
             // If the texture is null, set it to the empty texture
@@ -167,364 +171,241 @@ void MainWindow::setupToDraw()
                 (*ent)->setTexture(&emptyTexture);
             }
 
+            const QImage* texture = (*ent)->getTexture();
+            double x = (*ent)->getRenderX(alpha);
+            double y = (*ent)->getRenderY(alpha);
+
             // Make sure not to draw the Entities that aren't visible
-            if ((*ent)->getX() + (*ent)->getTexture()->offset().x() + (*ent)->getTexture()->width() * renderingMultiplier < game->getCamera().x() // If too much on the left
-                    || (*ent)->getX() + (*ent)->getTexture()->offset().x() > game->getCamera().x() + game->getCameraSize().first // If too much on the right
-                    || (*ent)->getY() + (*ent)->getTexture()->offset().y() + (*ent)->getTexture()->height() * renderingMultiplier < game->getCamera().y() // If too high
-                    || (*ent)->getY() + (*ent)->getTexture()->offset().y() > game->getCamera().y() + game->getCameraSize().second) { // If too low
+            if (x + texture->offset().x() + texture->width() * renderingMultiplier < camera.x() // If too much on the left
+                    || x + texture->offset().x() > camera.x() + game->getCameraSize().first // If too much on the right
+                    || y + texture->offset().y() + texture->height() * renderingMultiplier < camera.y() // If too high
+                    || y + texture->offset().y() > camera.y() + game->getCameraSize().second) { // If too low
                 continue;
             }
 
-            nlohmann::json entityInfo;
-
-            entityInfo["x"] = (*ent)->getX();
-            entityInfo["y"] = (*ent)->getY();
-            entityInfo["entityType"] = (*ent)->getEntType();
-            entityInfo["entityID"] = (*ent)->getEntityID();
-
-            toDrawTextures[(*ent)->getEntityID()] = *(*ent)->getTexture();
-
-            if ((*ent)->getEntType() == "Samos" || (*ent)->getEntType() == "NPC" || (*ent)->getEntType() == "Monster" || (*ent)->getEntType() == "DynamicObj") {
-                    Living* liv = static_cast<Living*>(*ent);
-                    entityInfo["iTime"] = liv->getITime();
+            RenderFrame::Sprite sprite;
+            sprite.x = StaticLayer::toLogical(static_cast<int>(x) + texture->offset().x(), renderingMultiplier) - cameraX;
+            sprite.y = StaticLayer::toLogical(static_cast<int>(y) + texture->offset().y(), renderingMultiplier) - cameraY;
+            sprite.texture = frame.textures.size();
+
+            // Invincible entities flash every other frame
+            AnimationCache::Tint tint = AnimationCache::NoTint;
+            if ((*ent)->getEntType() == EntityType::Samos || (*ent)->getEntType() == EntityType::NPC || (*ent)->getEntType() == EntityType::Monster || (*ent)->getEntType() == EntityType::DynamicObj) {
+                Living* liv = static_cast<Living*>(*ent);
+                if (liv->getITime() > 0.0 && game->getUpdateCount() % 2 == 0)
+                    tint = AnimationCache::Flash;
             }
+            frame.textures.push_back(AnimationCache::tinted(*texture, tint));
 
-            entitiesInfo[(*ent)->getLayer()].push_back(entityInfo);
-        }
-        std::vector<std::string> layers;
-        for (std::map<float, std::vector<nlohmann::json>>::iterator i = entitiesInfo.begin(); i != entitiesInfo.end(); i++) {
-            layers.push_back(std::to_string(i->first));
-            toDraw["entitiesInfo"][std::to_string(i->first)] = i->second;
+            // The other rooms are drawn under the current one, entities without a room belong to it
+            unsigned int priority = (*ent)->getRoomId().empty() || (*ent)->getRoomId() == currentRoomId ? 2 : 0;
+            renderQueue.push((*ent)->getLayer(), priority, RenderQueue::textureKey(frame.textures.back().cacheKey()), queuedSprites.size());
+            queuedSprites.push_back(sprite);
         }
-        std::sort(layers.begin(), layers.end());
-        toDraw["layers"] = layers;
+        renderQueue.sort();
+        for (std::vector<RenderQueue::Command>::const_iterator command = renderQueue.getCommands().begin(); command != renderQueue.getCommands().end(); command++)
+            frame.sprites.push_back(queuedSprites[command->item]);
 
 
         //Draw hitboxes if necessary
         if (game->getRenderHitboxes()) {
 
-            nlohmann::json roomJson = (*game->getCurrentMap().getJson())["rooms"][game->getCurrentMap().getCurrentRoomId()];
-            toDraw["room_position_x"] = roomJson["position"][0];
-            toDraw["room_position_y"] = roomJson["position"][1];
-            toDraw["room_size_x"] = roomJson["size"][0];
-            toDraw["room_size_y"] = roomJson["size"][1];
-
-            std::vector<nlohmann::json> hitboxesInfo;
-
             for (std::vector<NPC*>::iterator ent = game->getNPCs()->begin(); ent != game->getNPCs()->end(); ent++) {
-                nlohmann::json hitboxInfo;
-                hitboxInfo["entityType"] = (*ent)->getEntType();
-
-                if ((*ent)->getBox() != nullptr) {
-                    hitboxInfo["box_x"] = (*ent)->getBox()->getX() + (*ent)->getX();
-                    hitboxInfo["box_y"] = (*ent)->getBox()->getY() + (*ent)->getY();
-                    hitboxInfo["box_w"] = (*ent)->getBox()->getWidth();
-                    hitboxInfo["box_h"] = (*ent)->getBox()->getHeight();
-                }
-
-                if ((*ent)->getGroundBox() != nullptr) {
-                    hitboxInfo["groundBox_x"] = (*ent)->getGroundBox()->getX() + (*ent)->getX();
-                    hitboxInfo["groundBox_y"] = (*ent)->getGroundBox()->getY() + (*ent)->getY();
-                    hitboxInfo["groundBox_w"] = (*ent)->getGroundBox()->getWidth();
-                    hitboxInfo["groundBox_h"] = (*ent)->getGroundBox()->getHeight();
-                }
-
-                hitboxesInfo.push_back(hitboxInfo);
-
+                addHitbox(frame, *ent, (*ent)->getBox(), alpha, QColor("blue"));
+                addHitbox(frame, *ent, (*ent)->getGroundBox(), alpha, QColor("green"));
             }
 
             if (game->getS() != nullptr) {
                 Samos* s = game->getS();
-
-                nlohmann::json hitboxInfo;
-                hitboxInfo["entityType"] = s->getEntType();
-
-                if (s->getBox() != nullptr) {
-                    hitboxInfo["box_x"] = s->getBox()->getX() + s->getX();
-                    hitboxInfo["box_y"] = s->getBox()->getY() + s->getY();
-                    hitboxInfo["box_w"] = s->getBox()->getWidth();
-                    hitboxInfo["box_h"] = s->getBox()->getHeight();
-                }
-
-                if (s->getGroundBox() != nullptr) {
-                    hitboxInfo["groundBox_x"] = s->getGroundBox()->getX() + s->getX();
-                    hitboxInfo["groundBox_y"] = s->getGroundBox()->getY() + s->getY();
-                    hitboxInfo["groundBox_w"] = s->getGroundBox()->getWidth();
-                    hitboxInfo["groundBox_h"] = s->getGroundBox()->getHeight();
-                }
-
-                if (s->getWallBoxL() != nullptr) {
-                    hitboxInfo["wallBoxL_x"] = s->getWallBoxL()->getX() + s->getX();
-                    hitboxInfo["wallBoxL_y"] = s->getWallBoxL()->getY() + s->getY();
-                    hitboxInfo["wallBoxL_w"] = s->getWallBoxL()->getWidth();
-                    hitboxInfo["wallBoxL_h"] = s->getWallBoxL()->getHeight();
-                }
-
-                if (s->getWallBoxR() != nullptr) {
-                    hitboxInfo["wallBoxR_x"] = s->getWallBoxR()->getX() + s->getX();
-                    hitboxInfo["wallBoxR_y"] = s->getWallBoxR()->getY() + s->getY();
-                    hitboxInfo["wallBoxR_w"] = s->getWallBoxR()->getWidth();
-                    hitboxInfo["wallBoxR_h"] = s->getWallBoxR()->getHeight();
-                }
-
-                hitboxesInfo.push_back(hitboxInfo);
+                addHitbox(frame, s, s->getBox(), alpha, QColor("orange"));
+                addHitbox(frame, s, s->getGroundBox(), alpha, QColor("green"));
+                addHitbox(frame, s, s->getWallBoxL(), alpha, QColor("green"));
+                addHitbox(frame, s, s->getWallBoxR(), alpha, QColor("green"));
             }
 
             for (std::vector<Monster*>::iterator ent = game->getMonsters()->begin(); ent != game->getMonsters()->end(); ent++) {
-                nlohmann::json hitboxInfo;
-                hitboxInfo["entityType"] = (*ent)->getEntType();
-
-                if ((*ent)->getBox() != nullptr) {
-                    hitboxInfo["box_x"] = (*ent)->getBox()->getX() + (*ent)->getX();
-                    hitboxInfo["box_y"] = (*ent)->getBox()->getY() + (*ent)->getY();
-                    hitboxInfo["box_w"] = (*ent)->getBox()->getWidth();
-                    hitboxInfo["box_h"] = (*ent)->getBox()->getHeight();
-                }
-
-                if ((*ent)->getGroundBox() != nullptr) {
-                    hitboxInfo["groundBox_x"] = (*ent)->getGroundBox()->getX() + (*ent)->getX();
-                    hitboxInfo["groundBox_y"] = (*ent)->getGroundBox()->getY() + (*ent)->getY();
-                    hitboxInfo["groundBox_w"] = (*ent)->getGroundBox()->getWidth();
-                    hitboxInfo["groundBox_h"] = (*ent)->getGroundBox()->getHeight();
-                }
-
-                hitboxesInfo.push_back(hitboxInfo);
+                addHitbox(frame, *ent, (*ent)->getBox(), alpha, QColor("red"));
+                addHitbox(frame, *ent, (*ent)->getGroundBox(), alpha, QColor("green"));
             }
 
             for (std::vector<DynamicObj*>::iterator ent = game->getDynamicObjs()->begin(); ent != game->getDynamicObjs()->end(); ent++) {
-                nlohmann::json hitboxInfo;
-                hitboxInfo["entityType"] = (*ent)->getEntType();
-
-                if ((*ent)->getBox() != nullptr) {
-                    hitboxInfo["box_x"] = (*ent)->getBox()->getX() + (*ent)->getX();
-                    hitboxInfo["box_y"] = (*ent)->getBox()->getY() + (*ent)->getY();
-                    hitboxInfo["box_w"] = (*ent)->getBox()->getWidth();
-                    hitboxInfo["box_h"] = (*ent)->getBox()->getHeight();
-                }
-
-                if ((*ent)->getGroundBox() != nullptr) {
-                    hitboxInfo["groundBox_x"] = (*ent)->getGroundBox()->getX() + (*ent)->getX();
-                    hitboxInfo["groundBox_y"] = (*ent)->getGroundBox()->getY() + (*ent)->getY();
-                    hitboxInfo["groundBox_w"] = (*ent)->getGroundBox()->getWidth();
-                    hitboxInfo["groundBox_h"] = (*ent)->getGroundBox()->getHeight();
-                }
-
-                hitboxesInfo.push_back(hitboxInfo);
-            }
-
-            for (std::vector<Terrain*>::iterator ent = game->getTerrains()->begin(); ent != game->getTerrains()->end(); ent++) {
-                nlohmann::json hitboxInfo;
-                hitboxInfo["entityType"] = (*ent)->getEntType();
-
-                if ((*ent)->getBox() != nullptr) {
-                    hitboxInfo["box_x"] = (*ent)->getBox()->getX() + (*ent)->getX();
-                    hitboxInfo["box_y"] = (*ent)->getBox()->getY() + (*ent)->getY();
-                    hitboxInfo["box_w"] = (*ent)->getBox()->getWidth();
-                    hitboxInfo["box_h"] = (*ent)->getBox()->getHeight();
-                }
-
-                hitboxesInfo.push_back(hitboxInfo);
-            }
-
-            for (std::vector<Projectile*>::iterator ent = game->getProjectiles()->begin(); ent != game->getProjectiles()->end(); ent++) {
-                nlohmann::json hitboxInfo;
-                hitboxInfo["entityType"] = (*ent)->getEntType();
-
-                if ((*ent)->getBox() != nullptr) {
-                    hitboxInfo["box_x"] = (*ent)->getBox()->getX() + (*ent)->getX();
-                    hitboxInfo["box_y"] = (*ent)->getBox()->getY() + (*ent)->getY();
-                    hitboxInfo["box_w"] = (*ent)->getBox()->getWidth();
-                    hitboxInfo["box_h"] = (*ent)->getBox()->getHeight();
-                }
-
-                hitboxesInfo.push_back(hitboxInfo);
+                addHitbox(frame, *ent, (*ent)->getBox(), alpha, QColor("blue"));
+                addHitbox(frame, *ent, (*ent)->getGroundBox(), alpha, QColor("green"));
             }
 
-            for (std::vector<Area*>::iterator ent = game->getAreas()->begin(); ent != game->getAreas()->end(); ent++) {
-                nlohmann::json hitboxInfo;
-                hitboxInfo["entityType"] = (*ent)->getEntType();
+            for (std::vector<Terrain*>::iterator ent = game->getTerrains()->begin(); ent != game->getTerrains()->end(); ent++)
+                addHitbox(frame, *ent, (*ent)->getBox(), alpha, QColor("blue"));
 
-                if ((*ent)->getBox() != nullptr) {
-                    hitboxInfo["box_x"] = (*ent)->getBox()->getX() + (*ent)->getX();
-                    hitboxInfo["box_y"] = (*ent)->getBox()->getY() + (*ent)->getY();
-                    hitboxInfo["box_w"] = (*ent)->getBox()->getWidth();
-                    hitboxInfo["box_h"] = (*ent)->getBox()->getHeight();
-                }
+            for (std::vector<Projectile*>::iterator ent = game->getProjectiles()->begin(); ent != game->getProjectiles()->end(); ent++)
+                addHitbox(frame, *ent, (*ent)->getBox(), alpha, QColor("blue"));
 
-                hitboxesInfo.push_back(hitboxInfo);
-            }
+            for (std::vector<Area*>::iterator ent = game->getAreas()->begin(); ent != game->getAreas()->end(); ent++)
+                addHitbox(frame, *ent, (*ent)->getBox(), alpha, QColor("gray"));
 
-            toDraw["hitboxesInfo"] = hitboxesInfo;
+            const RoomInfo &room = game->getCurrentMap().getCurrentRoomInfo();
+            RenderFrame::Rect roomRect;
+            roomRect.x = room.x - camera.x();
+            roomRect.y = room.y - camera.y();
+            roomRect.width = room.width;
+            roomRect.height = room.height;
+            roomRect.color = QColor("magenta");
+            frame.hitboxes.push_back(roomRect);
         }
 
         // Draw fps if necessary
         if (game->getShowFps()) {
-            if ((std::chrono::high_resolution_clock::now() - game->getLastFpsShown()).count() > game->getShowFpsUpdateRate()) {
-                game->setLastFpsShown(std::chrono::high_resolution_clock::now());
+            if ((std::chrono::steady_clock::now() - game->getLastFpsShown()).count() > game->getShowFpsUpdateRate()) {
+                game->setLastFpsShown(std::chrono::steady_clock::now());
             }
-            toDraw["fps"] = game->getFps();
+            frame.showFps = true;
+            frame.fps = game->getFps();
         }
 
         //HUD
         if (game->getS() != nullptr && game->getShowHUD()) {
-
-            toDraw["hud_selectedWeapon"] = game->translate(game->getS()->getSelectedWeapon(), std::vector<std::string>({"ui", "selectedWeapon"})).toStdString();
-            toDraw["hud_health"] = game->getS()->getHealth();
-            toDraw["hud_missileCount"] = game->getS()->getMissileCount();
-            toDraw["hud_grenadeCount"] = game->getS()->getGrenadeCount();
-
-            if (game->getS()->getDashDirection() != "") {
-                toDraw["hud_dashBar"] = game->getS()->getDashTime() >= 0.0 ? game->getS()->getDashTime() / Entity::values["names"]["Samos"]["dashTime"].get<double>() : 0.0;
+            frame.showHud = true;
+            frame.hud.selectedWeapon = game->translate(game->getS()->getSelectedWeapon(), std::vector<std::string>({"ui", "selectedWeapon"})).toStdString();
+            frame.hud.health = game->getS()->getHealth();
+            frame.hud.missileCount = game->getS()->getMissileCount();
+            frame.hud.grenadeCount = game->getS()->getGrenadeCount();
+
+            if (game->getS()->getDashDirection() != Facing::None) {
+                frame.hud.dashBar = game->getS()->getDashTime() >= 0.0 ? game->getS()->getDashTime() / game->getS()->getArchetype()->samos.dashTime : 0.0;
             } else if (game->getS()->getDashCoolDownType() == "Air") {
-                toDraw["hud_dashBar"] = game->getS()->getDashCoolDown() >= 0.0 ? (1 - game->getS()->getDashCoolDown() / Entity::values["names"]["Samos"]["dashAirCooldown"].get<double>()) : 1.0;
+                frame.hud.dashBar = game->getS()->getDashCoolDown() >= 0.0 ? (1 - game->getS()->getDashCoolDown() / game->getS()->getArchetype()->samos.dashAirCooldown) : 1.0;
             } else {
-                toDraw["hud_dashBar"] = game->getS()->getDashCoolDown() >= 0.0 ? (1 - game->getS()->getDashCoolDown() / Entity::values["names"]["Samos"]["dashGroundCooldown"].get<double>()) : 1.0;
+                frame.hud.dashBar = game->getS()->getDashCoolDown() >= 0.0 ? (1 - game->getS()->getDashCoolDown() / game->getS()->getArchetype()->samos.dashGroundCooldown) : 1.0;
             }
         }
 
         // Dialogue
-        if (!game->getCurrentDialogue().isNull()) {
-            toDraw["talkingName"] = game->getCurrentDialogue().getTalkingName();
-            toDraw["dialogueText"] = game->getCurrentDialogue().getText()[game->getCurrentDialogue().getTextAdvancement()];
+        if (frame.inDialogue) {
+            frame.talkingName = game->getCurrentDialogue().getTalkingName();
+            frame.dialogueText = game->getCurrentDialogue().getText()[game->getCurrentDialogue().getTextAdvancement()];
         }
 
         //Menu
-        if (game->getIsPaused()) {
-            toDraw["menuOptions"] = game->getMenuOptions();
-            toDraw["selectedOption"] = game->getSelectedOption();
+        if (frame.isPaused) {
+            frame.menuOptions = game->getMenuOptions();
+            frame.selectedOption = game->getSelectedOption();
         }
 
     } else {
-        nlohmann::json tMap = *game->getCurrentMap().getJson();
-        std::vector<std::string> tRooms = game->getCurrentProgress().getRoomsDiscovered()[game->getCurrentMap().getName()];
+        const Map &tMap = game->getCurrentMap();
+        std::vector<std::string> &tRooms = game->getCurrentProgress().getRoomsDiscovered()[game->getCurrentMap().getName()];
         QPoint tempMC = game->getMapCameraPosition();
         int mapScaleDown = Entity::values["general"]["mapScaleDown"].get<int>();
 
-        toDraw["mapScaleDown"]  = mapScaleDown;
-        toDraw["mapCamera_position_x"] = game->getMapCameraPosition().x();
-        toDraw["mapCamera_position_y"] = game->getMapCameraPosition().y();
-        toDraw["mapCamera_size_x"] = game->getCameraSize().first / mapScaleDown;
-        toDraw["mapCamera_size_y"] = game->getCameraSize().second / mapScaleDown;
-
-        std::vector<nlohmann::json> roomsInfo;
-
-        for (std::string i : tRooms) {
-            nlohmann::json room = tMap["rooms"][i];
-            if (room["position"][0].get<int>() + room["size"][0].get<int>() < tempMC.x() // If too much on the left
-                    || room["position"][0].get<int>() > tempMC.x() + game->getCameraSize().first * mapScaleDown // If too much on the right
-                    || room["position"][1].get<int>() + room["size"][1].get<int>() < tempMC.y() // If too high
-                    || room["position"][1].get<int>() > tempMC.y() + game->getCameraSize().second * mapScaleDown) { // If too low
+        frame.mapScaleDown = mapScaleDown;
+        frame.mapCameraX = tempMC.x();
+        frame.mapCameraY = tempMC.y();
+        frame.mapCameraWidth = game->getCameraSize().first / mapScaleDown;
+        frame.mapCameraHeight = game->getCameraSize().second / mapScaleDown;
+
+        for (const std::string &i : tRooms) {
+            const RoomInfo &room = tMap.getRoomInfo(i);
+            if (room.x + room.width < tempMC.x() // If too much on the left
+                    || room.x > tempMC.x() + game->getCameraSize().first * mapScaleDown // If too much on the right
+                    || room.y + room.height < tempMC.y() // If too high
+                    || room.y > tempMC.y() + game->getCameraSize().second * mapScaleDown) { // If too low
                 continue;
             }
 
-            nlohmann::json roomInfo;
-
-            roomInfo["position_x"] = room["position"][0];
-            roomInfo["position_y"] = room["position"][1];
-            roomInfo["size_x"] = room["size"][0];
-            roomInfo["size_y"] = room["size"][1];
-
-            if (!room["content"]["Area"].is_null()) {
-                if (!room["content"]["Area"]["HorizontalDoor"].is_null()) {
-
-                    std::vector<nlohmann::json> hDoorsInfo;
-
-                    for (nlohmann::json hd : room["content"]["Area"]["HorizontalDoor"]) {
-                        nlohmann::json hDoorInfo;
-
-                        hDoorInfo["x"] = hd["x"].get<int>() + Entity::values["names"]["HorizontalDoor"]["offset_x"].get<int>();
-                        hDoorInfo["y"] = hd["y"].get<int>() + Entity::values["names"]["HorizontalDoor"]["offset_y"].get<int>();
-                        hDoorInfo["w"] = Entity::values["names"]["HorizontalDoor"]["width"].get<int>();
-                        hDoorInfo["h"] = Entity::values["names"]["HorizontalDoor"]["height"].get<int>();
-
-                        hDoorsInfo.push_back(hDoorInfo);
-                    }
-
-                    roomInfo["hDoorsInfo"] = hDoorsInfo;
-                }
-
-                if (!room["content"]["Area"]["VerticalDoor"].is_null()) {
-
-                    std::vector<nlohmann::json> vDoorsInfo;
-
-                    for (nlohmann::json vd : room["content"]["Area"]["VerticalDoor"]) {
-                        nlohmann::json vDoorInfo;
-
-                        vDoorInfo["x"] = vd["x"].get<int>() + Entity::values["names"]["VerticalDoor"]["offset_x"].get<int>();
-                        vDoorInfo["y"] = vd["y"].get<int>() + Entity::values["names"]["VerticalDoor"]["offset_y"].get<int>();
-                        vDoorInfo["w"] = Entity::values["names"]["VerticalDoor"]["width"].get<int>();
-                        vDoorInfo["h"] = Entity::values["names"]["VerticalDoor"]["height"].get<int>();
-
-                        vDoorsInfo.push_back(vDoorInfo);
-                    }
-
-                    roomInfo["vDoorsInfo"] = vDoorsInfo;
-                }
+            RenderFrame::Rect roomRect;
+            roomRect.x = room.x;
+            roomRect.y = room.y;
+            roomRect.width = room.width;
+            roomRect.height = room.height;
+            frame.mapRooms.push_back(roomRect);
+
+            for (std::vector<RoomInfo::DoorInfo>::const_iterator d = room.doors.begin(); d != room.doors.end(); d++) {
+                if (d->name != "HorizontalDoor" && d->name != "VerticalDoor")
+                    continue;
+                const Archetype *doorType = ArchetypeRegistry::get(d->name);
+
+                RenderFrame::Rect doorRect;
+                doorRect.x = d->x + doorType->offsetX + room.x;
+                doorRect.y = d->y + doorType->offsetY + room.y;
+                doorRect.width = doorType->width;
+                doorRect.height = doorType->height;
+                frame.mapDoors.push_back(doorRect);
             }
-
-            roomsInfo.push_back(roomInfo);
         }
 
-        toDraw["mapRoomsInfo"] = roomsInfo;
-
         if (game->getS() != nullptr) {
-            toDraw["minimosPath"] = game->getAssetsPath() + "/textures/" + Entity::values["textures"]["Map"]["Samos"]["file"].get<std::string>();
-
-            Samos* s =game->getS();
-
-            toDraw["samos_x"] = s->getX();
-            toDraw["samos_y"] = s->getY();
-            toDraw["samos_box_x"] = s->getBox()->getX();
-            toDraw["samos_box_y"] = s->getBox()->getY();
-            toDraw["samos_box_w"] = s->getBox()->getWidth();
-            toDraw["samos_box_h"] = s->getBox()->getHeight();
-
+            Samos* s = game->getS();
+            frame.showMinimos = true;
+            frame.minimosX = static_cast<int>(s->getX()) + s->getBox()->getX() + s->getBox()->getWidth() / 2;
+            frame.minimosY = static_cast<int>(s->getY()) + s->getBox()->getY() + s->getBox()->getHeight() / 2;
         }
     }
 
-    if (game->getShowDebugInfo()) {
-        Samos* s =game->getS();
-
-        toDraw["samos_x"] = s->getX();
-        toDraw["samos_y"] = s->getY();
-        toDraw["samos_vx"] = s->getVX();
-        toDraw["samos_vy"] = s->getVY();
-        toDraw["samos_box_x"] = s->getBox()->getX();
-        toDraw["samos_box_y"] = s->getBox()->getY();
-        toDraw["samos_box_w"] = s->getBox()->getWidth();
-        toDraw["samos_box_h"] = s->getBox()->getHeight();
-        toDraw["samos_state"] = s->getState();
-        toDraw["samos_facing"] = s->getFacing();
-        toDraw["samos_speedRetained"] = s->getSpeedRetained();
-        toDraw["samos_retainTime"] = s->getRetainTime();
-        toDraw["samos_onGround"] = s->getOnGround();
-        toDraw["samos_room"] = game->getCurrentMap().getCurrentRoomId();
-        toDraw["samos_iTime"] = s->getITime();
-        toDraw["samos_lagTime"] = s->getLagTime();
-        toDraw["samos_shootTime"] = s->getShootTime();
-        toDraw["samos_switchDelay"] = s->getSwitchDelay();
-        toDraw["samos_fastFalling"] = s->getFastFalling();
-        toDraw["samos_jumpTime"] = s->getJumpTime();
-        toDraw["samos_priorDash_vx"] = s->getSpeedPriorDash().first;
-        toDraw["samos_priorDash_vy"] = s->getSpeedPriorDash().second;
-        toDraw["samos_dashTime"] = s->getDashTime();
-        toDraw["samos_dashCoolDownType"] = s->getDashCoolDownType();
-        toDraw["samos_dashCoolDown"] = s->getDashCoolDown();
-        toDraw["samos_dashDirection"] = s->getDashDirection();
-        toDraw["samos_frameCount"] = game->getFrameCount();
-        toDraw["tas_lineFrameCount"] = game->getLastInstructionFrames();
-        toDraw["tas_lineNumber"] = (game->getCurrentInstructionFrames() == 1 ? game->getLine() - 1 : game->getLine()) + game->getLinesSkipped();
-        toDraw["loadedRooms"] = "[]"_json;
+    if (frame.showDebugInfo) {
+        Samos* s = game->getS();
+        RenderFrame::DebugInfo &info = frame.debugInfo;
+
+        info.x = s->getX();
+        info.y = s->getY();
+        info.vx = s->getVX();
+        info.vy = s->getVY();
+        info.boxX = s->getBox()->getX();
+        info.boxY = s->getBox()->getY();
+        info.boxWidth = s->getBox()->getWidth();
+        info.boxHeight = s->getBox()->getHeight();
+        info.state = s->getStateName();
+        info.facing = s->getFacingName();
+        info.speedRetained = s->getSpeedRetained();
+        info.retainTime = s->getRetainTime();
+        info.onGround = s->getOnGround();
+        info.room = game->getCurrentMap().getCurrentRoomId();
+        info.iTime = s->getITime();
+        info.lagTime = s->getLagTime();
+        info.shootTime = s->getShootTime();
+        info.switchDelay = s->getSwitchDelay();
+        info.fastFalling = s->getFastFalling();
+        info.jumpTime = s->getJumpTime();
+        info.priorDashVX = s->getSpeedPriorDash().first;
+        info.priorDashVY = s->getSpeedPriorDash().second;
+        info.dashTime = s->getDashTime();
+        info.dashCoolDownType = s->getDashCoolDownType();
+        info.dashCoolDown = s->getDashCoolDown();
+        info.dashDirection = s->getDashDirection() == Facing::None ? "" : EntityIds::facingName(s->getDashDirection());
+        info.frameCount = game->getFrameCount();
+        info.tasLineFrameCount = game->getLastInstructionFrames();
+        info.tasLineNumber = (game->getCurrentInstructionFrames() == 1 ? game->getLine() - 1 : game->getLine()) + game->getLinesSkipped();
+        info.narrowphaseChecks = game->getNarrowphaseChecks();
+        info.animationHits = AnimationCache::getHits();
+        info.animationMisses = AnimationCache::getMisses();
+        info.animationBytes = AnimationCache::getResidentBytes();
+        info.prefetchHits = game->getPrefetchHits();
+        info.prefetchMisses = game->getPrefetchMisses();
         for (auto r = game->getRoomEntities().begin(); r != game->getRoomEntities().end(); r++)
             if (r->second != nullptr)
-                toDraw["loadedRooms"].push_back(r->first);
-        toDraw["loadingRooms"] = "[]"_json;
+                info.loadedRooms.push_back(r->first);
         for (auto r = game->getRoomsToLoad()->begin(); r != game->getRoomsToLoad()->end(); r++)
-            toDraw["loadingRooms"].push_back(*r);
-        toDraw["unloadingRooms"] = "[]"_json;
+            info.loadingRooms.push_back(*r);
         for (auto r = game->getRoomsToUnload()->begin(); r != game->getRoomsToUnload()->end(); r++)
-            toDraw["unloadingRooms"].push_back(*r);
+            info.unloadingRooms.push_back(*r);
+        for (auto r = game->getRoomCache().begin(); r != game->getRoomCache().end(); r++)
+            info.cachedRooms.push_back(r->first);
+        info.roomCacheBytes = game->getRoomCacheBytes();
     }
+
+    frames.publish();
+    renderWorker->frameReady();
+}
+
+void MainWindow::addHitbox(RenderFrame &frame, Entity *ent, CollisionBox *box, double alpha, const QColor &color)
+{
+    if (box == nullptr)
+        return;
+    RenderFrame::Rect hitbox;
+    hitbox.x = static_cast<int>(box->getX() + ent->getRenderX(alpha)) - frame.cameraX;
+    hitbox.y = static_cast<int>(box->getY() + ent->getRenderY(alpha)) - frame.cameraY;
+    hitbox.width = box->getWidth();
+    hitbox.height = box->getHeight();
+    hitbox.color = color;
+    frame.hitboxes.push_back(hitbox);
 }
 
 void MainWindow::closeEvent(QCloseEvent *)
@@ -534,368 +415,20 @@ void MainWindow::closeEvent(QCloseEvent *)
 
 void MainWindow::paintEvent(QPaintEvent *)
 {
-    copyingToDraw = true;
-    nlohmann::json tempToDraw = nlohmann::json(toDraw);
-    std::map<int, QImage> tempToDrawTextures = std::map<int, QImage>(toDrawTextures);
-    copyingToDraw = false;
-
-    int c_x =  tempToDraw["camera_position_x"].get<int>();
-    int c_y =  tempToDraw["camera_position_y"].get<int>();
+    // The frame is already rasterized by the RenderWorker, painting only presents it
+    const QImage &image = renderWorker->getPresentedFrame();
+    if (image.isNull())
+        return;
     QPainter painter(this);
-
-    if (!tempToDraw["inInventory"].get<bool>() && !tempToDraw["inMap"].get<bool>()) {
-
-        for (std::string layer : tempToDraw["layers"]) {
-            for (nlohmann::json entityInfo : tempToDraw["entitiesInfo"][layer]) {
-                try {
-                    QImage tTex = tempToDrawTextures[entityInfo["entityID"].get<int>()];
-                    if (entityInfo["iTime"].is_null() ? false : (entityInfo["iTime"].get<double>() > 0.0 && (tempToDraw["updateCount"].get<int>() % 2 == 0))) {
-                        QColor base_color(200,200,200,200);
-
-                        QImage new_image = tTex;
-                        QPainter pa(&new_image);
-                        pa.setCompositionMode(QPainter::CompositionMode_SourceAtop);
-                        pa.fillRect(new_image.rect(), base_color);
-                        pa.end();
-                        painter.drawImage(QRect(entityInfo["x"].get<int>() + tTex.offset().x() -  c_x,
-                                            entityInfo["y"].get<int>() + tTex.offset().y() -  c_y,
-                                            tTex.width() * tempToDraw["renderingMultiplier"].get<int>(),
-                                            tTex.height() * tempToDraw["renderingMultiplier"].get<int>()),
-                                            new_image);
-                    } else {
-                        painter.drawImage(QRect(entityInfo["x"].get<int>() + tTex.offset().x() -  c_x,
-                                            entityInfo["y"].get<int>() + tTex.offset().y() -  c_y,
-                                            tTex.width() * tempToDraw["renderingMultiplier"].get<int>(),
-                                            tTex.height() * tempToDraw["renderingMultiplier"].get<int>()),
-                                            tTex);
-                    }
-                } catch (...) {
-                    painter.drawImage(QRect(entityInfo["x"].get<int>() + errorTexture.offset().x() -  c_x,
-                                        entityInfo["y"].get<int>() + errorTexture.offset().y() -  c_y,
-                                        errorTexture.width() * tempToDraw["renderingMultiplier"].get<int>(),
-                                        errorTexture.height() * tempToDraw["renderingMultiplier"].get<int>()),
-                                        errorTexture);
-                }
-            }
-        }
-
-
-        //Draw hitboxes if necessary
-        if (tempToDraw["renderHitboxes"].get<bool>()) {
-
-            for (nlohmann::json hitboxInfo : tempToDraw["hitboxesInfo"]) {
-
-                if (hitboxInfo["entityType"].get<std::string>() == "Terrain") {
-
-                    painter.setPen(QColor("blue"));
-                    if (!hitboxInfo["box_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["box_x"].get<int>() -  c_x,
-                                            hitboxInfo["box_y"].get<int>() -  c_y,
-                                            hitboxInfo["box_w"].get<int>(),
-                                            hitboxInfo["box_h"].get<int>());
-                    }
-
-                } else if (hitboxInfo["entityType"].get<std::string>() == "Projectile") {
-
-                    painter.setPen(QColor("blue"));
-                    if (!hitboxInfo["box_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["box_x"].get<int>() -  c_x,
-                                            hitboxInfo["box_y"].get<int>() -  c_y,
-                                            hitboxInfo["box_w"].get<int>(),
-                                            hitboxInfo["box_h"].get<int>());
-                    }
-
-                } else if (hitboxInfo["entityType"].get<std::string>() == "Area") {
-
-                    painter.setPen(QColor("gray"));
-                    if (!hitboxInfo["box_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["box_x"].get<int>() -  c_x,
-                                            hitboxInfo["box_y"].get<int>() -  c_y,
-                                            hitboxInfo["box_w"].get<int>(),
-                                            hitboxInfo["box_h"].get<int>());
-                    }
-
-                } else if (hitboxInfo["entityType"].get<std::string>() == "NPC") {
-
-                    painter.setPen(QColor("blue"));
-                    if (!hitboxInfo["box_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["box_x"].get<int>() -  c_x,
-                                            hitboxInfo["box_y"].get<int>() -  c_y,
-                                            hitboxInfo["box_w"].get<int>(),
-                                            hitboxInfo["box_h"].get<int>());
-                    }
-
-                    //Ground boxes);
-                    painter.setPen(QColor("green"));
-                    if (!hitboxInfo["groundBox_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["groundBox_x"].get<int>() -  c_x,
-                                            hitboxInfo["groundBox_y"].get<int>() -  c_y,
-                                            hitboxInfo["groundBox_w"].get<int>(),
-                                            hitboxInfo["groundBox_h"].get<int>());
-                    }
-
-                } else if (hitboxInfo["entityType"].get<std::string>() == "DynamicObj") {
-
-                    painter.setPen(QColor("blue"));
-                    if (!hitboxInfo["box_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["box_x"].get<int>() -  c_x,
-                                            hitboxInfo["box_y"].get<int>() -  c_y,
-                                            hitboxInfo["box_w"].get<int>(),
-                                            hitboxInfo["box_h"].get<int>());
-                    }
-
-                    //Ground boxes);
-                    painter.setPen(QColor("green"));
-                    if (!hitboxInfo["groundBox_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["groundBox_x"].get<int>() -  c_x,
-                                            hitboxInfo["groundBox_y"].get<int>() -  c_y,
-                                            hitboxInfo["groundBox_w"].get<int>(),
-                                            hitboxInfo["groundBox_h"].get<int>());
-                    }
-
-                } else if (hitboxInfo["entityType"].get<std::string>() == "Monster") {
-
-                    painter.setPen(QColor("red"));
-                    if (!hitboxInfo["box_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["box_x"].get<int>() -  c_x,
-                                            hitboxInfo["box_y"].get<int>() -  c_y,
-                                            hitboxInfo["box_w"].get<int>(),
-                                            hitboxInfo["box_h"].get<int>());
-                    }
-
-                    //Ground boxes);
-                    painter.setPen(QColor("green"));
-                    if (!hitboxInfo["groundBox_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["groundBox_x"].get<int>() -  c_x,
-                                            hitboxInfo["groundBox_y"].get<int>() -  c_y,
-                                            hitboxInfo["groundBox_w"].get<int>(),
-                                            hitboxInfo["groundBox_h"].get<int>());
-                    }
-
-                } else if (hitboxInfo["entityType"].get<std::string>() == "Samos") {
-
-                    painter.setPen(QColor("orange"));
-                    if (!hitboxInfo["box_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["box_x"].get<int>() -  c_x,
-                                            hitboxInfo["box_y"].get<int>() -  c_y,
-                                            hitboxInfo["box_w"].get<int>(),
-                                            hitboxInfo["box_h"].get<int>());
-                    }
-
-                    //Ground boxes);
-                    painter.setPen(QColor("green"));
-                    if (!hitboxInfo["groundBox_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["groundBox_x"].get<int>() -  c_x,
-                                            hitboxInfo["groundBox_y"].get<int>() -  c_y,
-                                            hitboxInfo["groundBox_w"].get<int>(),
-                                            hitboxInfo["groundBox_h"].get<int>());
-                    }
-
-                    //Wall boxes);
-                    if (!hitboxInfo["wallBoxL_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["wallBoxL_x"].get<int>() -  c_x,
-                                            hitboxInfo["wallBoxL_y"].get<int>() -  c_y,
-                                            hitboxInfo["wallBoxL_w"].get<int>(),
-                                            hitboxInfo["wallBoxL_h"].get<int>());
-                    }
-                    if (!hitboxInfo["wallBoxR_x"].is_null()) {
-                        painter.drawRect(hitboxInfo["wallBoxR_x"].get<int>() -  c_x,
-                                            hitboxInfo["wallBoxR_y"].get<int>() -  c_y,
-                                            hitboxInfo["wallBoxR_w"].get<int>(),
-                                            hitboxInfo["wallBoxR_h"].get<int>());
-                    }
-                }
-            }
-
-
-
-            painter.setPen(QColor("magenta"));
-            painter.drawRect(tempToDraw["room_position_x"].get<int>() - c_x,
-                                tempToDraw["room_position_y"].get<int>() - c_y,
-                                tempToDraw["room_size_x"].get<int>(),
-                                tempToDraw["room_size_y"].get<int>());
-        }
-
-        // Draw fps if necessary
-        if (tempToDraw["showFps"].get<bool>()) {
-            painter.setPen(QColor("black"));
-            painter.drawText(QPoint(2, 12), QString::fromStdString(std::to_string(tempToDraw["fps"].get<int>()) + " FPS"));
-        }
-
-        QFont f = painter.font();
-        f.setPointSize(f.pointSize() * 2);
-        painter.setFont(f);
-
-        //HUD
-        if ((!tempToDraw["hud_selectedWeapon"].is_null()) && tempToDraw["showHUD"].get<bool>()) {
-
-            painter.setPen(QColor("black"));
-
-            //Selected weapon
-            painter.fillRect(QRect(70,15,100,30), QColor("white"));
-            painter.drawRect(QRect(70,15,100,30));
-            painter.drawText(QPoint(80, 40), QString::fromStdString(tempToDraw["hud_selectedWeapon"].get<std::string>()));
-
-            //Missile count
-            painter.fillRect(QRect(200,15,70,30), QColor("white"));
-            painter.drawRect(QRect(200,15,70,30));
-            painter.drawText(QPoint(210, 40), QString::fromStdString("M : " + std::to_string(tempToDraw["hud_missileCount"].get<int>())));
-
-            //Grenade count
-            painter.fillRect(QRect(290,15,70,30), QColor("white"));
-            painter.drawRect(QRect(290,15,70,30));
-            painter.drawText(QPoint(300, 40), QString::fromStdString("G : " + std::to_string(tempToDraw["hud_grenadeCount"].get<int>())));
-
-            //Health count
-            painter.fillRect(QRect(380,15,80,30), QColor("white"));
-            painter.drawRect(QRect(380,15,80,30));
-            painter.drawText(QPoint(390, 40), QString::fromStdString("H : " + std::to_string(tempToDraw["hud_health"].get<int>())));
-
-
-            //Dash
-            painter.fillRect(QRect(480,15,190,30), QColor("white"));
-            painter.drawRect(QRect(480,15,190,30));
-            painter.drawText(QPoint(490, 40), "Dash : ");
-            painter.fillRect(QRect(560,20,100*tempToDraw["hud_dashBar"].get<double>(),20), QColor(tempToDraw["hud_dashBar"].get<double>() == 1.0 ? "gray" : "darkGray"));
-        }
-
-        // Dialogue
-        if (tempToDraw["inDialogue"].get<bool>()) {
-            // In case we changed it before
-            painter.setPen(QColor("black"));
-
-            painter.drawText(QRectF(QRect(200, 200, 1000, 200)),
-                             QString::fromStdString(tempToDraw["talkingName"].get<std::string>() + " : " + tempToDraw["dialogueText"].get<std::string>()),
-                    QTextOption(Qt::AlignHCenter));
-        }
-
-        //Menu
-        if (tempToDraw["isPaused"].get<bool>()) {
-            painter.fillRect(QRect(0,0,size().width(),size().height()), QBrush(QColor(0,0,0,200)));
-            for (unsigned int i = 0; i < tempToDraw["menuOptions"].size(); i++) {
-                painter.setPen(QColor("white"));
-                if (tempToDraw["selectedOption"].get<int>() == (int) i)
-                    painter.setPen(QColor("cyan"));
-                painter.drawText(0, size().height() / 2 - 15 * tempToDraw["menuOptions"].size() + 30 * i, size().width(), 50, Qt::AlignHCenter, QString::fromStdString(tempToDraw["menuOptions"][i]));
-            }
-        }
-        f.setPointSize(f.pointSize() / 2);
-        painter.setFont(f);
-
-    } else {
-        int mc_x =  tempToDraw["mapCamera_position_x"].get<int>();
-        int mc_y =  tempToDraw["mapCamera_position_y"].get<int>();
-        int mapScaleDown = tempToDraw["mapScaleDown"].get<int>();
-        for (nlohmann::json roomInfo : tempToDraw["mapRoomsInfo"]) {
-            painter.fillRect(QRect((roomInfo["position_x"].get<int>() - mc_x) / mapScaleDown,
-                                    (roomInfo["position_y"].get<int>() - mc_y) / mapScaleDown,
-                                    roomInfo["size_x"].get<int>() / mapScaleDown,
-                                    roomInfo["size_y"].get<int>() / mapScaleDown),
-                                QColor(32,50,100));
-
-            painter.setPen(QPen(QColor(64,100,200), 5));
-            painter.drawRect(QRect((roomInfo["position_x"].get<int>() - mc_x) / mapScaleDown,
-                             (roomInfo["position_y"].get<int>() - mc_y) / mapScaleDown,
-                             roomInfo["size_x"].get<int>() / mapScaleDown,
-                             roomInfo["size_y"].get<int>() / mapScaleDown));
-        }
-
-        for (nlohmann::json roomInfo : tempToDraw["mapRoomsInfo"]) {
-            if (!roomInfo["vDoorsInfo"].is_null()) {
-                for (nlohmann::json vd : roomInfo["vDoorsInfo"]) {
-                    painter.fillRect(QRect((vd["x"].get<int>() + roomInfo["position_x"].get<int>() - mc_x) / mapScaleDown,
-                            (vd["y"].get<int>() + roomInfo["position_y"].get<int>() - mc_y) / mapScaleDown,
-                            vd["w"].get<int>() / mapScaleDown,
-                            vd["h"].get<int>() / mapScaleDown),
-                            QColor("darkGray"));
-                }
-            }
-            if (!roomInfo["hDoorsInfo"].is_null()) {
-                for (nlohmann::json hd : roomInfo["hDoorsInfo"]) {
-                    painter.fillRect(QRect((hd["x"].get<int>() + roomInfo["position_x"].get<int>() - mc_x) / mapScaleDown,
-                            (hd["y"].get<int>() + roomInfo["position_y"].get<int>() - mc_y) / mapScaleDown,
-                            hd["w"].get<int>() / mapScaleDown,
-                            hd["h"].get<int>() / mapScaleDown),
-                            QColor("darkGray"));
-                }
-            }
-        }
-
-        painter.setPen(QPen(QColor(64,192,64,100), 5));
-        painter.drawRect(QRect((c_x - mc_x) / mapScaleDown, (c_y - mc_y) / mapScaleDown,
-                            tempToDraw["mapCamera_size_x"], tempToDraw["mapCamera_size_y"]));
-        if (!tempToDraw["minimosPath"].is_null()) {
-            QImage minimos(QString::fromStdString(tempToDraw["minimosPath"].get<std::string>()));
-
-            painter.drawImage(QRect((tempToDraw["samos_x"].get<int>() + tempToDraw["samos_box_x"].get<int>() + tempToDraw["samos_box_w"].get<int>() / 2 - mc_x) / mapScaleDown - minimos.width() / 2,
-                                    (tempToDraw["samos_y"].get<int>() + tempToDraw["samos_box_y"].get<int>() + tempToDraw["samos_box_h"].get<int>() / 2 - mc_y) / mapScaleDown - minimos.height() / 2,
-                                    minimos.width(),
-                                    minimos.height()),
-                              minimos);
-        }
-    }
-    if (tempToDraw["showDebugInfo"]) {
-        painter.fillRect(QRect(70, 70, 250, 650), QBrush(QColor(0,0,0,150)));
-
-        painter.setPen(QColor("white"));
-
-        painter.drawText(QPoint(80, 90), QString::fromStdString("X : " + std::to_string(tempToDraw["samos_x"].get<double>())));
-        painter.drawText(QPoint(80, 110), QString::fromStdString("Y : " + std::to_string(tempToDraw["samos_y"].get<double>())));
-        painter.drawText(QPoint(80, 130), QString::fromStdString("VX : " + std::to_string(tempToDraw["samos_vx"].get<double>())));
-        painter.drawText(QPoint(80, 150), QString::fromStdString("VY : " + std::to_string(tempToDraw["samos_vy"].get<double>())));
-        painter.drawText(QPoint(80, 170), QString::fromStdString("Box X : " + std::to_string(tempToDraw["samos_box_x"].get<int>())));
-        painter.drawText(QPoint(80, 190), QString::fromStdString("Box Y : " + std::to_string(tempToDraw["samos_box_y"].get<int>())));
-        painter.drawText(QPoint(80, 210), QString::fromStdString("Box Width : " + std::to_string(tempToDraw["samos_box_w"].get<int>())));
-        painter.drawText(QPoint(80, 230), QString::fromStdString("Box Height : " + std::to_string(tempToDraw["samos_box_h"].get<int>())));
-        painter.drawText(QPoint(80, 250), QString::fromStdString("State : " + tempToDraw["samos_state"].get<std::string>()));
-        painter.drawText(QPoint(80, 270), QString::fromStdString("Facing : " + tempToDraw["samos_facing"].get<std::string>()));
-        painter.drawText(QPoint(80, 290), QString::fromStdString("Speed retained : " + std::to_string(tempToDraw["samos_speedRetained"].get<double>())));
-        painter.drawText(QPoint(80, 310), QString::fromStdString("Retain time : " + std::to_string(tempToDraw["samos_retainTime"].get<double>())));
-        painter.drawText(QPoint(80, 330), QString::fromStdString("On ground : " + std::to_string(tempToDraw["samos_onGround"].get<bool>())));
-        painter.drawText(QPoint(80, 350), QString::fromStdString("Room ID : " + tempToDraw["samos_room"].get<std::string>()));
-        painter.drawText(QPoint(80, 370), QString::fromStdString("I-Time : " + std::to_string(tempToDraw["samos_iTime"].get<double>())));
-        painter.drawText(QPoint(80, 390), QString::fromStdString("Lag time : " + std::to_string(tempToDraw["samos_lagTime"].get<double>())));
-        painter.drawText(QPoint(80, 410), QString::fromStdString("Shoot cooldown : " + std::to_string(tempToDraw["samos_shootTime"].get<double>())));
-        painter.drawText(QPoint(80, 430), QString::fromStdString("Switch cooldown : " + std::to_string(tempToDraw["samos_switchDelay"].get<double>())));
-        painter.drawText(QPoint(80, 450), QString::fromStdString("Fast falling : " + std::to_string(tempToDraw["samos_fastFalling"].get<bool>())));
-        painter.drawText(QPoint(80, 470), QString::fromStdString("Jump time : " + std::to_string(tempToDraw["samos_jumpTime"].get<double>())));
-        painter.drawText(QPoint(80, 490), QString::fromStdString("VX prior dash: " + std::to_string(tempToDraw["samos_priorDash_vx"].get<double>())));
-        painter.drawText(QPoint(80, 510), QString::fromStdString("VY prior dash: " + std::to_string(tempToDraw["samos_priorDash_vy"].get<double>())));
-        painter.drawText(QPoint(80, 530), QString::fromStdString("Dash time : " + std::to_string(tempToDraw["samos_dashTime"].get<double>())));
-        painter.drawText(QPoint(80, 550), QString::fromStdString("Dash cooldown : " + std::to_string(tempToDraw["samos_dashCoolDown"].get<double>())));
-        painter.drawText(QPoint(80, 570), QString::fromStdString("Dash cooldown type : " + tempToDraw["samos_dashCoolDownType"].get<std::string>()));
-        painter.drawText(QPoint(80, 590), QString::fromStdString("Dash direction : " + tempToDraw["samos_dashDirection"].get<std::string>()));
-        painter.drawText(QPoint(80, 610), QString::fromStdString("Frame count : " + std::to_string(tempToDraw["samos_frameCount"].get<int>())));
-        painter.drawText(QPoint(80, 630), QString::fromStdString("TAS Current line frame count : " + std::to_string(tempToDraw["tas_lineFrameCount"].get<int>())));
-        painter.drawText(QPoint(80, 650), QString::fromStdString("TAS Current line number : " + std::to_string(tempToDraw["tas_lineNumber"].get<int>())));
-        std::string str = "[";
-        for (unsigned int i = 0; i < tempToDraw["loadedRooms"].size(); i++) {
-            if (i != 0)
-                str += ", ";
-            str += tempToDraw["loadedRooms"][i];
-        }
-        str += "]";
-        painter.drawText(QPoint(80, 670), QString::fromStdString("Loaded rooms : " + str));
-        str = "[";
-        for (unsigned int i = 0; i < tempToDraw["loadingRooms"].size(); i++) {
-            if (i != 0)
-                str += ", ";
-            str += tempToDraw["loadingRooms"][i];
-        }
-        str += "]";
-        painter.drawText(QPoint(80, 690), QString::fromStdString("Rooms being loaded : " + str));
-        str = "[";
-        for (unsigned int i = 0; i < tempToDraw["unloadingRooms"].size(); i++) {
-            if (i != 0)
-                str += ", ";
-            str += tempToDraw["unloadingRooms"][i];
-        }
-        str += "]";
-        painter.drawText(QPoint(80, 710), QString::fromStdString("Rooms being unloaded : " + str));
-    }
+    painter.drawImage(0, 0, image);
     painter.end();
 }
 
+void MainWindow::resizeEvent(QResizeEvent *)
+{
+    renderWorker->setOutputSize(width(), height());
+}
+
 int MainWindow::getRenderingMultiplier() const
 {
     return renderingMultiplier;
@@ -936,12 +469,3 @@ void MainWindow::setGame(Game *newGame)
     game = newGame;
 }
 
-bool MainWindow::getRender() const
-{
-    return render;
-}
-
-void MainWindow::setRender(bool newRender)
-{
-    render = newRender;
-}
@@ -7,6 +7,9 @@
 #include <windows.h>
 
 #include "game.h"
+#include "renderframe.h"
+#include "renderqueue.h"
+#include "renderworker.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -19,10 +22,11 @@ public:
     ~MainWindow();
 
     void paintEvent(QPaintEvent*);
+    void resizeEvent(QResizeEvent*);
     void closeEvent(QCloseEvent*);
     void getInputs();
     void getSpecialInputs();
-    void setupToDraw();
+    void setupToDraw(double alpha = 1.0); // 'alpha' places moving entities between the last two simulation steps
 
     int getRenderingMultiplier() const;
     void setRenderingMultiplier(int newRenderingMultiplier);
@@ -32,26 +36,23 @@ public:
     void setEmptyTexture(const QImage &newEmptyTexture);
     Game *getGame() const;
     void setGame(Game *newGame);
-    bool getRender() const;
-    void setRender(bool newRender);
-    const nlohmann::json &getToDraw() const;
-    void setToDraw(const nlohmann::json &newToDraw);
-    const std::map<int, QImage> &getToDrawTextures() const;
-    void setToDrawTextures(const std::map<int, QImage> &newToDrawTextures);
-    bool getCopyingToDraw() const;
-    void setCopyingToDraw(bool newCopyingToDraw);
 
 private:
+    static const int cullingMargin = 64; // in px, around the camera
+
     QApplication *m_qApp;
     bool eventFilter(QObject *object, QEvent *event);
+    void addHitbox(RenderFrame &frame, Entity* ent, CollisionBox* box, double alpha, const QColor &color); // Does nothing if 'box' is nullptr
 
     Game* game = nullptr;
     int renderingMultiplier = 1; // Textures are rendered with their size being multiplied by this value
     QImage errorTexture;
     QImage emptyTexture;
-    nlohmann::json toDraw;
-    std::map<int, QImage> toDrawTextures;
-    bool copyingToDraw = false;
-    bool render;
+    QImage minimosTexture; // Samos on the map
+    RenderFrameBuffer frames; // Filled by the game thread, rasterized by 'renderWorker'
+    RenderWorker *renderWorker = nullptr; // Rasterizes the frames off the GUI thread
+    RenderQueue renderQueue; // Draw order of the sprites, only used by the game thread
+    std::vector<RenderFrame::Sprite> queuedSprites; // In the order they were pushed to 'renderQueue'
+    std::vector<Entity*> visibleEntities; // Found by the render grid, reused every frame
 };
 #endif // MAINWINDOW_H
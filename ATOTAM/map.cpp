@@ -6,6 +6,8 @@
 #include "Entities/monster.h"
 #include "Entities/savepoint.h"
 
+#include <algorithm>
+
 Map::Map()
 {
     // Create an empty map with an empty room. That room is necessary because of the 'startingRoom' node
@@ -26,6 +28,7 @@ Map::Map()
            "    },"
            "    \"startingRoom\": \"0\""
            "}"_json;
+    buildRoomInfos();
 }
 
 Map Map::loadMap(std::string id, std::string assetsPath)
@@ -39,7 +42,84 @@ Map Map::loadMap(std::string id, std::string assetsPath)
 Map::Map(nlohmann::json json)
     : json(json), name(json["name"]), currentRoomId(json["startingRoom"])
 {
+    buildRoomInfos();
+}
 
+const RoomInfo Map::noRoom;
+
+void Map::buildRoomInfos()
+{
+    roomInfos.clear();
+    if (!json["rooms"].is_object())
+        return;
+
+    for (auto room : json["rooms"].items()) {
+        const nlohmann::json &roomJson = room.value();
+        RoomInfo info;
+        info.id = room.key();
+        info.x = roomJson["position"][0];
+        info.y = roomJson["position"][1];
+        info.width = roomJson["size"][0];
+        info.height = roomJson["size"][1];
+
+        if (roomJson.contains("content")) {
+            const nlohmann::json &content = roomJson["content"];
+            if (content.contains("Area"))
+                for (auto name : content["Area"].items()) {
+                    // Same door detection as loadRoom: the name without its parameters ends with "Door"
+                    std::string n = name.key().substr(0, name.key().find('_'));
+                    if (n.size() < 4 || n.substr(n.size() - 4, 4) != "Door")
+                        continue;
+                    for (const nlohmann::json &obj : name.value()) {
+                        RoomInfo::DoorInfo door;
+                        door.name = n;
+                        door.state = obj.contains("state") ? obj["state"].get<std::string>() : "None";
+                        door.endingRoom = obj["to"];
+                        door.x = obj["x"];
+                        door.y = obj["y"];
+                        info.doors.push_back(door);
+                        if (std::find(info.neighbours.begin(), info.neighbours.end(), door.endingRoom) == info.neighbours.end())
+                            info.neighbours.push_back(door.endingRoom);
+                    }
+                }
+            if (content.contains("NPC") && content["NPC"].contains("Savepoint"))
+                for (const nlohmann::json &obj : content["NPC"]["Savepoint"]) {
+                    RoomInfo::SavepointInfo savepoint;
+                    savepoint.id = obj["spID"];
+                    savepoint.x = obj["x"];
+                    savepoint.y = obj["y"];
+                    info.savepoints.push_back(savepoint);
+                }
+        }
+
+        roomInfos[info.id] = info;
+    }
+}
+
+const RoomInfo &Map::getRoomInfo(const std::string &id) const
+{
+    std::unordered_map<std::string, RoomInfo>::const_iterator info = roomInfos.find(id);
+    if (info == roomInfos.end())
+        return noRoom;
+    return info->second;
+}
+
+QRect Map::getBounds() const
+{
+    QRect bounds;
+    for (std::unordered_map<std::string, RoomInfo>::const_iterator info = roomInfos.begin(); info != roomInfos.end(); info++)
+        bounds = bounds.united(QRect(info->second.x, info->second.y, info->second.width, info->second.height));
+    return bounds;
+}
+
+const RoomInfo &Map::getCurrentRoomInfo() const
+{
+    return getRoomInfo(currentRoomId);
+}
+
+bool Map::hasRoom(const std::string &id) const
+{
+    return roomInfos.find(id) != roomInfos.end();
 }
 
 std::vector<Entity *> Map::loadRoom(std::string id)
@@ -95,9 +175,9 @@ std::vector<Entity *> Map::loadRoom(std::string id)
                     if (!obj["times"].is_null())
                         if (!obj["vertical"].is_null()) { // Should always be true at this point
                             if (obj["vertical"])
-                                y += i * static_cast<int>(Entity::values["names"][n]["height"]);
+                                y += i * ArchetypeRegistry::get(n)->height;
                             else
-                                x += i * static_cast<int>(Entity::values["names"][n]["width"]);
+                                x += i * ArchetypeRegistry::get(n)->width;
                         }
 
                     // Specific Entities fields and initialization
@@ -115,11 +195,11 @@ std::vector<Entity *> Map::loadRoom(std::string id)
                             Savepoint *s = new Savepoint(x, y, obj["spID"], this->name);
                             e = s;
                         } else {
-                            NPC *npc = new NPC(x, y, obj["facing"], n);
+                            NPC *npc = new NPC(x, y, EntityIds::facing(obj["facing"]), n);
                             e = npc;
                         }
                     } else if (entity.key() == "Monster") {
-                        Monster *m = new Monster(x, y, obj["facing"], n);
+                        Monster *m = new Monster(x, y, EntityIds::facing(obj["facing"]), n);
                         e = m;
                     }
 
@@ -131,9 +211,9 @@ std::vector<Entity *> Map::loadRoom(std::string id)
                     e->setFullName(fullName);
 
                     if (obj["state"].is_null())
-                        e->setState("None");
+                        e->setState(State::None);
                     else
-                        e->setState(obj["state"]);
+                        e->setState(EntityIds::state(obj["state"]));
 
                     // If the entity has a repetition, extend its collision box
                     unsigned int horizontalRepeat = obj["horizontalRepeat"].is_null() ? 1 : obj["horizontalRepeat"].get<int>();
@@ -188,7 +268,7 @@ nlohmann::json Map::find(Entity *entity)
     if (j.is_null())
         throw std::invalid_argument("Map::find(Entity*) received an Entity which is in a non-existent room.");
 
-    j = j["content"][entity->getEntType()];
+    j = j["content"][entity->getEntTypeName()];
     // Entity type isn't present in this room
     if (j.is_null())
         throw std::invalid_argument("Map::find(Entity*) received an Entity type which isn't present in this room.");
@@ -231,7 +311,7 @@ void Map::changeRoom(Entity *entity, std::string newRoomId)
     nlohmann::json entJson = find(entity);
 
     // Create the JSON pointer
-    nlohmann::json::json_pointer ptr("/rooms/" + oldRoomId + "/content/" + entity->getEntType() + "/" + entity->getName());
+    nlohmann::json::json_pointer ptr("/rooms/" + oldRoomId + "/content/" + entity->getEntTypeName() + "/" + entity->getName());
 
     // Then erase it from the old room
     nlohmann::json nameJson = json.at(ptr);
@@ -242,18 +322,18 @@ void Map::changeRoom(Entity *entity, std::string newRoomId)
         }
 
     // Remove the subnodes in the old room if they are empty
-    ptr = nlohmann::json::json_pointer("/rooms/" + oldRoomId + "/content/" + entity->getEntType());
+    ptr = nlohmann::json::json_pointer("/rooms/" + oldRoomId + "/content/" + entity->getEntTypeName());
     if (json.at(ptr)[entity->getName()].empty())
         json.at(ptr).erase(entity->getName());
     ptr = nlohmann::json::json_pointer("/rooms/" + oldRoomId + "/content");
-    if (json.at(ptr)[entity->getEntType()].empty())
-        json.at(ptr).erase(entity->getEntType());
+    if (json.at(ptr)[entity->getEntTypeName()].empty())
+        json.at(ptr).erase(entity->getEntTypeName());
 
     // Create the subnodes in the new room if they don't already exist
-    ptr = nlohmann::json::json_pointer("/rooms/" + newRoomId + "/content/" + entity->getEntType());
+    ptr = nlohmann::json::json_pointer("/rooms/" + newRoomId + "/content/" + entity->getEntTypeName());
     if (json.at(ptr).is_null())
         json.at(ptr) = "{}"_json;
-    ptr = nlohmann::json::json_pointer("/rooms/" + newRoomId + "/content/" + entity->getEntType() + "/" + entity->getName());
+    ptr = nlohmann::json::json_pointer("/rooms/" + newRoomId + "/content/" + entity->getEntTypeName() + "/" + entity->getName());
     if (json.at(ptr).is_null())
         json.at(ptr) = "[]"_json;
 
@@ -300,4 +380,5 @@ nlohmann::json* Map::getJson()
 void Map::setJson(const nlohmann::json &newJson)
 {
     json = newJson;
+    buildRoomInfos();
 }
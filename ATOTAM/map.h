@@ -5,6 +5,34 @@
 #define JSON_DIAGNOSTICS 1 // Json extended error messages
 #include "nlohmann/json.hpp"
 #include <string>
+#include <unordered_map>
+
+// What the game needs to know about a room every frame, extracted once from the map Json
+struct RoomInfo
+{
+    struct DoorInfo {
+        std::string name; // Entity name, like "HorizontalDoor"
+        std::string state;
+        std::string endingRoom;
+        int x = 0; // relative to the room, in px
+        int y = 0; // relative to the room, in px
+    };
+
+    struct SavepointInfo {
+        int id = 0;
+        int x = 0; // relative to the room, in px
+        int y = 0; // relative to the room, in px
+    };
+
+    std::string id = "";
+    int x = 0; // in px
+    int y = 0; // in px
+    int width = 0; // in px
+    int height = 0; // in px
+    std::vector<DoorInfo> doors;
+    std::vector<SavepointInfo> savepoints;
+    std::vector<std::string> neighbours; // Rooms the doors lead to, without duplicates
+};
 
 class Map
 {
@@ -16,6 +44,11 @@ public:
     std::vector<Entity*> loadRooms(); // Loads all rooms and returns the array of entity they contain
     nlohmann::json find(Entity* entity); // Finds the given entity in this map's Json and returns its path
     void changeRoom(Entity* entity, std::string newRoomId); // Changes the current room of this Entity to the new one. DOES NOT CHANGE ITS COORDINATES
+    void buildRoomInfos(); // Rebuilds the RoomInfo table from the Json. Must be called after editing the Json through getJson()
+    const RoomInfo &getRoomInfo(const std::string &id) const; // Returns an empty RoomInfo if the room doesn't exist
+    const RoomInfo &getCurrentRoomInfo() const;
+    bool hasRoom(const std::string &id) const;
+    QRect getBounds() const; // Smallest rectangle containing every room, in px
 
     const std::string &getName() const;
     void setName(const std::string &newName);
@@ -34,6 +67,8 @@ private:
     std::string name = "";
     std::string currentRoomId = "0";
     std::string lastRoomId = "0";
+    std::unordered_map<std::string, RoomInfo> roomInfos;
+    static const RoomInfo noRoom;
 };
 
 #endif // MAP_H
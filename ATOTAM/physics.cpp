@@ -9,106 +9,124 @@
 double Physics::frameRate;
 double Physics::gravity;
 
-bool Physics::canChangeBox(Entity *e, CollisionBox *b, std::vector<Terrain*> *ts, std::vector<DynamicObj*> *ds, std::pair<int, int> roomS, std::pair<int, int> roomE)
-{
-    Entity ne = Entity(e->getX(), e->getY(), new CollisionBox(*b), nullptr, e->getEntType(), e->getIsAffectedByGravity(), e->getFacing(), e->getFrictionFactor(), e->getName(), e->getIsMovable());
-    for (std::vector<Terrain*>::iterator i = ts->begin(); i != ts->end(); i++) {
-        if (Entity::checkCollision(&ne, b, *i, (*i)->getBox())) {
-            Entity::calcCollisionReplacement(&ne, *i);
-        }
-    }
-    for (std::vector<DynamicObj*>::iterator i = ds->begin(); i != ds->end(); i++) {
-        if (Entity::checkCollision(&ne, b, *i, (*i)->getBox())) {
-            Entity::calcCollisionReplacement(&ne, *i);
-        }
-    }
-
-    if (ne.getX() + ne.getBox()->getX() + ne.getBox()->getWidth() > roomE.first) {
-        ne.setX(roomE.first - ne.getBox()->getX() - ne.getBox()->getWidth());
-    } else if (ne.getX() + ne.getBox()->getX() < roomS.first) {
-        ne.setX(roomS.first - ne.getBox()->getX());
-    } if (ne.getY() + ne.getBox()->getY() + ne.getBox()->getHeight() > roomE.second) {
-        ne.setY(roomE.second - ne.getBox()->getY() - ne.getBox()->getHeight());
-    } else if (ne.getY() + ne.getBox()->getY() < roomS.second) {
-        ne.setY(roomS.second - ne.getBox()->getY());
-    }
+std::vector<Entity*> Physics::stanceColliders;
 
-    for (std::vector<Terrain*>::iterator i = ts->begin(); i != ts->end(); i++) {
-        if (Entity::checkCollision(&ne, b, *i, (*i)->getBox())) {
-            return false;
-        }
-    }
-    for (std::vector<DynamicObj*>::iterator i = ds->begin(); i != ds->end(); i++) {
-        if (Entity::checkCollision(&ne, b, *i, (*i)->getBox())) {
-            return false;
-        }
-    }
+Physics::Rect Physics::boxAt(Entity *e, CollisionBox *box)
+{
+    Rect r;
+    r.x = e->getX();
+    r.y = e->getY();
+    r.offsetX = box->getX();
+    r.offsetY = box->getY();
+    r.width = box->getWidth();
+    r.height = box->getHeight();
+    return r;
+}
 
-    if (ne.getX() + ne.getBox()->getX() + ne.getBox()->getWidth() > roomE.first) {
-        return false;
-    } else if (ne.getX() + ne.getBox()->getX() < roomS.first) {
-        return false;
-    } if (ne.getY() + ne.getBox()->getY() + ne.getBox()->getHeight() > roomE.second) {
-        return false;
-    } else if (ne.getY() + ne.getBox()->getY() < roomS.second) {
+bool Physics::overlapBox(const Rect &r, Entity *collider)
+{
+    Entity::collisionChecks++;
+    CollisionBox* box = collider->getBox();
+    if (box == nullptr)
         return false;
-    }
-
-    return true;
+    //Same check as Entity::checkCollision
+    return (r.x + r.offsetX + r.width > collider->getX() + box->getX())
+            && (r.x + r.offsetX < collider->getX() + box->getX() + box->getWidth())
+            && (r.y + r.offsetY + r.height > collider->getY() + box->getY())
+            && (r.y + r.offsetY < collider->getY() + box->getY() + box->getHeight());
 }
 
-bool Physics::canChangeBoxAxis(Entity *e, CollisionBox *b, std::vector<Terrain *> *ts, std::vector<DynamicObj *> *ds, std::pair<int, int> roomS, std::pair<int, int> roomE, bool alongY)
+bool Physics::overlapBox(const Rect &r, const std::vector<Entity *> &colliders)
 {
-    Entity ne = Entity(e->getX(), e->getY(), new CollisionBox(*b), nullptr, e->getEntType(), e->getIsAffectedByGravity(), e->getFacing(), e->getFrictionFactor(), e->getName(), e->getIsMovable());
-    for (std::vector<Terrain*>::iterator i = ts->begin(); i != ts->end(); i++) {
-        if (Entity::checkCollision(&ne, b, *i, (*i)->getBox())) {
-            Entity::calcCollisionReplacementAxis(&ne, *i, alongY);
-        }
-    }
-    for (std::vector<DynamicObj*>::iterator i = ds->begin(); i != ds->end(); i++) {
-        if (Entity::checkCollision(&ne, b, *i, (*i)->getBox())) {
-            Entity::calcCollisionReplacementAxis(&ne, *i, alongY);
-        }
-    }
+    for (std::vector<Entity*>::const_iterator i = colliders.begin(); i != colliders.end(); i++)
+        if (overlapBox(r, *i))
+            return true;
+    return false;
+}
 
-    if (ne.getX() + ne.getBox()->getX() + ne.getBox()->getWidth() > roomE.first) {
-        ne.setX(roomE.first - ne.getBox()->getX() - ne.getBox()->getWidth());
-    } else if (ne.getX() + ne.getBox()->getX() < roomS.first) {
-        ne.setX(roomS.first - ne.getBox()->getX());
-    } if (ne.getY() + ne.getBox()->getY() + ne.getBox()->getHeight() > roomE.second) {
-        ne.setY(roomE.second - ne.getBox()->getY() - ne.getBox()->getHeight());
-    } else if (ne.getY() + ne.getBox()->getY() < roomS.second) {
-        ne.setY(roomS.second - ne.getBox()->getY());
+void Physics::resolveBox(Rect &r, const std::vector<Entity *> &colliders)
+{
+    for (std::vector<Entity*>::const_iterator i = colliders.begin(); i != colliders.end(); i++) {
+        if (!overlapBox(r, *i))
+            continue;
+        //Same replacement as Entity::calcCollisionReplacement for a movable Samos against anything else
+        Entity* c = *i;
+        CollisionBox* box = c->getBox();
+        double minX1 = r.x + r.width + r.offsetX - c->getX() - box->getX();
+        double minX2 = c->getX() + box->getWidth() + box->getX() - r.x - r.offsetX;
+        double minY1 = r.y + r.height + r.offsetY - c->getY() - box->getY();
+        double minY2 = c->getY() + box->getHeight() + box->getY() - r.y - r.offsetY;
+        double minX = std::abs(minX1) < std::abs(minX2) ? minX1 : minX2;
+        double minY = std::abs(minY1) < std::abs(minY2) ? minY1 : minY2;
+
+        if (r.x + r.offsetX + r.width / 2 > c->getX() + box->getX() + box->getWidth() / 2) minX *= -1;
+        if (r.y + r.offsetY + r.height / 2 > c->getY() + box->getY() + box->getHeight() / 2) minY *= -1;
+
+        if (std::abs(minX) < std::abs(minY))
+            r.x = r.x - minX;
+        else
+            r.y = r.y - minY;
     }
+}
 
-    for (std::vector<Terrain*>::iterator i = ts->begin(); i != ts->end(); i++) {
-        if (Entity::checkCollision(&ne, b, *i, (*i)->getBox())) {
-            return false;
+void Physics::resolveBoxAxis(Rect &r, const std::vector<Entity *> &colliders, bool alongY)
+{
+    for (std::vector<Entity*>::const_iterator i = colliders.begin(); i != colliders.end(); i++) {
+        if (!overlapBox(r, *i))
+            continue;
+        //Same replacement as Entity::calcCollisionReplacementAxis for a movable Samos against anything else
+        Entity* c = *i;
+        CollisionBox* box = c->getBox();
+        if (alongY) {
+            double minY1 = r.y + r.height + r.offsetY - c->getY() - box->getY();
+            double minY2 = c->getY() + box->getHeight() + box->getY() - r.y - r.offsetY;
+            double minY = std::abs(minY1) < std::abs(minY2) ? minY1 : minY2;
+            if (r.y + r.offsetY > c->getY() + box->getY()) minY *= -1;
+            r.y = r.y - minY;
+        } else {
+            double minX1 = r.x + r.width + r.offsetX - c->getX() - box->getX();
+            double minX2 = c->getX() + box->getWidth() + box->getX() - r.x - r.offsetX;
+            double minX = std::abs(minX1) < std::abs(minX2) ? minX1 : minX2;
+            if (r.x + r.offsetX > c->getX() + box->getX()) minX *= -1;
+            r.x = r.x - minX;
         }
     }
-    for (std::vector<DynamicObj*>::iterator i = ds->begin(); i != ds->end(); i++) {
-        if (Entity::checkCollision(&ne, b, *i, (*i)->getBox())) {
-            return false;
-        }
+}
+
+bool Physics::fitsAt(Rect r, const std::vector<Entity *> &colliders, std::pair<int, int> roomS, std::pair<int, int> roomE, bool alongY)
+{
+    if (alongY)
+        resolveBoxAxis(r, colliders, true);
+    else
+        resolveBox(r, colliders);
+
+    if (r.x + r.offsetX + r.width > roomE.first) {
+        r.x = roomE.first - r.offsetX - r.width;
+    } else if (r.x + r.offsetX < roomS.first) {
+        r.x = roomS.first - r.offsetX;
+    } if (r.y + r.offsetY + r.height > roomE.second) {
+        r.y = roomE.second - r.offsetY - r.height;
+    } else if (r.y + r.offsetY < roomS.second) {
+        r.y = roomS.second - r.offsetY;
     }
 
-    if (ne.getX() + ne.getBox()->getX() + ne.getBox()->getWidth() > roomE.first) {
-        return false;
-    } else if (ne.getX() + ne.getBox()->getX() < roomS.first) {
-        return false;
-    } if (ne.getY() + ne.getBox()->getY() + ne.getBox()->getHeight() > roomE.second) {
-        return false;
-    } else if (ne.getY() + ne.getBox()->getY() < roomS.second) {
+    if (overlapBox(r, colliders))
         return false;
-    }
 
-    return true;
+    return r.x + r.offsetX + r.width <= roomE.first && r.x + r.offsetX >= roomS.first
+            && r.y + r.offsetY + r.height <= roomE.second && r.y + r.offsetY >= roomS.second;
+}
+
+double Physics::queryMargin(Entity *e)
+{
+    // A collision replacement can't move an entity further than the distance it travels in one frame
+    return std::max(std::abs(e->getVX()), std::abs(e->getVY())) / frameRate + 1;
 }
 
 bool Physics::updateProjectile(Projectile *p)
 {
-    if (p->getState() == "Hit")
-        p->setBox(nullptr);
+    if (p->getState() == State::Hit)
+        p->removeBox();
     else {
         p->setLifeTime(p->getLifeTime() - (1 / frameRate));
         if (p->getLifeTime() <= 0.0) {
@@ -116,7 +134,7 @@ bool Physics::updateProjectile(Projectile *p)
         }
     }
 
-    if (p->getState() == "Hit" && p->getFrame() == (static_cast<unsigned int>(Entity::values["textures"][Entity::values["names"][p->getName()]["texture"]]["Hit"]["count"]) - 1))
+    if (p->getState() == State::Hit && p->getFrame() == (p->getArchetype()->getClip(State::Hit).count - 1))
         return true;
     else
         return false;
@@ -125,89 +143,64 @@ bool Physics::updateProjectile(Projectile *p)
 std::vector<Entity*> Physics::updateSamos(Game* game)
 {
     Samos* s = game->getS();
-    std::vector<Terrain*> *ts = game->getTerrains();
+    const std::vector<Terrain*> *ts = game->getStaticColliders();
     std::vector<DynamicObj*> *ds = game->getDynamicObjs();
     std::map<std::string, bool> inputList = *game->getInputList();
     std::map<std::string, double> inputTime = *game->getInputTime();
-    Map currentMap = game->getCurrentMap();
+    Map &currentMap = game->getCurrentMap();
 
     std::vector<Entity*> toAdd;
-    if (s->getState() == "MorphBallStop" || s->getState() == "MorphBallSlow" || s->getState() == "MorphBallSuperSlow")
-        s->setState("MorphBall");
-    else if (s->getState() == "Running")
-        s->setState("Walking");
-    else if (s->getState() == "RunningAimForward")
-        s->setState("WalkingAimForward");
-    else if (s->getState() == "RunningAimUp")
-        s->setState("WalkingAimUp");
-    else if (s->getState() == "RunningAimDown")
-        s->setState("WalkingAimDown");
+    if (SamosStates::get(s->getState()).calmState != SamosStates::keepState)
+        s->setState(SamosStates::get(s->getState()).calmState);
 
     if (s->getLagTime() > 0.0)
         s->setLagTime(s->getLagTime() - 1 / frameRate);
 
-    nlohmann::json samosJson = Entity::values["names"]["Samos"];
-    nlohmann::json roomJson = (*currentMap.getJson())["rooms"][currentMap.getCurrentRoomId()];
-
-    if (s->getOnGround()) {
-        if ((s->getState() == "Jumping") || (s->getState() == "SpinJump") || (s->getState() == "Falling") || (s->getState() == "JumpEnd") || (s->getState() == "WallJump")
-                || (s->getState() == "FallingAimUp")|| (s->getState() == "FallingAimUpDiag")|| (s->getState() == "FallingAimDownDiag")|| (s->getState() == "FallingAimDown")) {
-            if ((s->getState() == "Falling") || (s->getState() == "FallingAimUp")|| (s->getState() == "FallingAimUpDiag")|| (s->getState() == "FallingAimDownDiag")|| (s->getState() == "FallingAimDown")) {
-                s->setY(s->getY() - static_cast<double>(samosJson["height"]) - static_cast<int>(samosJson["offset_y"]) +
-                        static_cast<double>(samosJson["fallingHitbox_height"]) + static_cast<int>(samosJson["fallingHitbox_offset_y"]));
-            } else if (s->getState() == "SpinJump" || s->getState() == "WallJump") {
-                s->setY(s->getY() - static_cast<double>(samosJson["height"]) - static_cast<int>(samosJson["offset_y"]) +
-                        static_cast<double>(samosJson["spinJumpHitbox_height"]) + static_cast<int>(samosJson["spinJumpHitbox_offset_y"]));
-            }
-        }
-    }
-    std::pair<int, int> roomS = {roomJson["position"][0], roomJson["position"][1]};
-    std::pair<int, int> roomE = {roomJson["position"][0].get<int>() + roomJson["size"][0].get<int>(),
-                                 roomJson["position"][1].get<int>() + roomJson["size"][1].get<int>()};
-
-    CollisionBox* spinBox = new CollisionBox(samosJson["spinJumpHitbox_offset_x"], samosJson["spinJumpHitbox_offset_y"],
-                  samosJson["spinJumpHitbox_width"], samosJson["spinJumpHitbox_height"]);
-    bool canSpin = canChangeBoxAxis(s, spinBox, ts, ds, roomS, roomE, true);
-    bool freeCanSpin = false;
-    if (!canSpin) {
-        canSpin = canChangeBox(s, spinBox, ts, ds, roomS, roomE);
-        freeCanSpin = true;
-    }
-    CollisionBox* morphBox = new CollisionBox(samosJson["morphBallHitbox_offset_x"], samosJson["morphBallHitbox_offset_y"],
-                  samosJson["morphBallHitbox_width"], samosJson["morphBallHitbox_height"]);
-    bool canMorph = canChangeBoxAxis(s, morphBox, ts, ds, roomS, roomE, true);
-    bool freeCanMorph = false;
-    if (!canMorph) {
-        canMorph = canChangeBox(s, morphBox, ts, ds, roomS, roomE);
-        freeCanMorph = true;
-    }
-    CollisionBox* fallBox = new CollisionBox(samosJson["fallingHitbox_offset_x"], samosJson["fallingHitbox_offset_y"],
-                samosJson["fallingHitbox_width"], samosJson["fallingHitbox_height"]);
-    bool canFall = canChangeBoxAxis(s, fallBox, ts, ds, roomS, roomE, true);
-    bool freeCanFall = false;
-    if (!canFall) {
-        canFall = canChangeBox(s, fallBox, ts, ds, roomS, roomE);
-        freeCanFall = true;
-    }
-    CollisionBox* crouchBox = new CollisionBox(samosJson["crouchHitbox_offset_x"], samosJson["crouchHitbox_offset_y"],
-                  samosJson["crouchHitbox_width"], samosJson["crouchHitbox_height"]);
-    bool canCrouch = canChangeBoxAxis(s, crouchBox, ts, ds, roomS, roomE, true);
-    bool freeCanCrouch = false;
-    if (!canCrouch) {
-        canCrouch = canChangeBox(s, crouchBox, ts, ds, roomS, roomE);
-        freeCanCrouch = true;
+    const Archetype *samosType = s->getArchetype();
+    const SamosTuning &samosTuning = samosType->samos;
+    const RoomInfo &room = currentMap.getCurrentRoomInfo();
+
+    // Landing: keep the feet where they are when the standing hitbox comes back
+    SamosStates::Stance airStance = SamosStates::get(s->getState()).stance;
+    if (s->getOnGround() && SamosStates::is(s->getState(), SamosStates::airborne) && airStance != SamosStates::Stand) {
+        CollisionBox standBox = samosTuning.hitboxes[SamosStates::Stand];
+        CollisionBox airBox = samosTuning.hitboxes[airStance];
+        s->setY(s->getY() - standBox.getHeight() - standBox.getY() + airBox.getHeight() + airBox.getY());
     }
-    CollisionBox* standBox = new CollisionBox(samosJson["offset_x"], samosJson["offset_y"], samosJson["width"], samosJson["height"]);
-    bool canStand = canChangeBoxAxis(s, standBox, ts, ds, roomS, roomE, true);
-    bool freeCanStand = false;
-    if (!canStand) {
-        canStand = canChangeBox(s, standBox, ts, ds, roomS, roomE);
-        freeCanStand = true;
+    std::pair<int, int> roomS = {room.x, room.y};
+    std::pair<int, int> roomE = {room.x + room.width, room.y + room.height};
+
+    // Colliders the stance probes can reach: around every hitbox, as far as a replacement can push one
+    CollisionBox stanceBounds = samosTuning.stanceBounds;
+    double stanceMargin = std::max(stanceBounds.getWidth(), stanceBounds.getHeight());
+    stanceColliders.clear();
+    game->getCollisionGrid(EntityType::Terrain)->queryArea(s->getX() + stanceBounds.getX() - stanceMargin, s->getY() + stanceBounds.getY() - stanceMargin,
+                                                           stanceBounds.getWidth() + 2 * stanceMargin, stanceBounds.getHeight() + 2 * stanceMargin, stanceColliders);
+    game->getCollisionGrid(EntityType::DynamicObj)->queryArea(s->getX() + stanceBounds.getX() - stanceMargin, s->getY() + stanceBounds.getY() - stanceMargin,
+                                                              stanceBounds.getWidth() + 2 * stanceMargin, stanceBounds.getHeight() + 2 * stanceMargin, stanceColliders);
+
+    // Which hitboxes Samos can switch to, and whether that needs a free (not only vertical) replacement
+    bool canChange[SamosStates::stanceCount];
+    bool freeCanChange[SamosStates::stanceCount];
+    for (unsigned int stance = 0; stance < SamosStates::stanceCount; stance++) {
+        CollisionBox stanceBox = samosTuning.hitboxes[stance];
+        Rect stanceRect = boxAt(s, &stanceBox);
+        canChange[stance] = fitsAt(stanceRect, stanceColliders, roomS, roomE, true);
+        freeCanChange[stance] = false;
+        if (!canChange[stance]) {
+            canChange[stance] = fitsAt(stanceRect, stanceColliders, roomS, roomE, false);
+            freeCanChange[stance] = true;
+        }
     }
+    bool canStand = canChange[SamosStates::Stand];
+    bool canCrouch = canChange[SamosStates::Crouch];
+    bool canFall = canChange[SamosStates::Fall];
+    bool canSpin = canChange[SamosStates::Spin];
+    bool canMorph = canChange[SamosStates::Morph];
 
     bool wallL = false;
     bool wallR = false;
-    for (std::vector<Terrain*>::iterator i = ts->begin(); i != ts->end(); i++) {
+    for (std::vector<Terrain*>::const_iterator i = ts->begin(); i != ts->end(); i++) {
         if (Entity::checkCollision(s ,s->getWallBoxL(), *i, (*i)->getBox())) {
             wallL = true;
         }
@@ -228,159 +221,159 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
             break;
     }
 
-    if (s->getState() == "MorphBalling" && s->getFrame() == (static_cast<unsigned int>(Entity::values["textures"][Entity::values["names"]["Samos"]["texture"]]["MorphBalling"]["count"]) - 1)) {
+    if (s->getState() == State::MorphBalling && s->getFrame() == (samosType->getClip(State::MorphBalling).count - 1)) {
         s->setIsInAltForm(true);
-        s->setState("MorphBall");
-    } else if (s->getState() == "UnMorphBalling" && s->getFrame() == (static_cast<unsigned int>(Entity::values["textures"][Entity::values["names"]["Samos"]["texture"]]["UnMorphBalling"]["count"]) - 1)) {
+        s->setState(State::MorphBall);
+    } else if (s->getState() == State::UnMorphBalling && s->getFrame() == (samosType->getClip(State::UnMorphBalling).count - 1)) {
         if (s->getOnGround()) {
-            s->setState("IdleCrouch");
-            s->setY(s->getY() - static_cast<double>(samosJson["crouchHitbox_height"]) - static_cast<int>(samosJson["crouchHitbox_offset_y"]) +
-                    static_cast<double>(samosJson["morphBallHitbox_height"]) + static_cast<int>(samosJson["morphBallHitbox_offset_y"]));
+            s->setState(State::IdleCrouch);
+            s->setY(s->getY() - static_cast<double>(samosTuning.crouchHitboxHeight) - static_cast<int>(samosTuning.crouchHitboxOffsetY) +
+                    static_cast<double>(samosTuning.morphBallHitboxHeight) + static_cast<int>(samosTuning.morphBallHitboxOffsetY));
         } else
-            s->setState("Falling");
+            s->setState(State::Falling);
     }
 
-    if (inputList["dash"] && inputTime["dash"] == 0.0 && s->getDashCoolDown() <= 0.0 && s->getDashDirection() == "") {
-        s->setDashTime(samosJson["dashTime"].get<double>());
+    if (inputList["dash"] && inputTime["dash"] == 0.0 && s->getDashCoolDown() <= 0.0 && s->getDashDirection() == Facing::None) {
+        s->setDashTime(samosTuning.dashTime);
         s->setIsAffectedByGravity(false);
         s->setFrictionFactor(0);
 
         if (inputList["right"] && !inputList["left"]) {
             if (inputList["up"] && !inputList["down"]) {
 
-                s->setDashDirection("UpRight");
-                s->setFacing("Right");
+                s->setDashDirection(Facing::UpRight);
+                s->setFacing(Facing::Right);
                 if (!s->getIsInAltForm())
-                    s->setState("DashUpDiag");
+                    s->setState(State::DashUpDiag);
                 s->setSpeedPriorDash({s->getVX(), s->getVY()});
-                s->setVX(std::max(s->getVX() + samosJson["dashBonus"].get<double>(), samosJson["dashBaseSpeed"].get<double>() * 0.707));
-                s->setVY(std::min(s->getVY() - samosJson["dashBonus"].get<double>(), -samosJson["dashBaseSpeed"].get<double>() * 0.707));
+                s->setVX(std::max(s->getVX() + samosTuning.dashBonus, samosTuning.dashBaseSpeed * 0.707));
+                s->setVY(std::min(s->getVY() - samosTuning.dashBonus, -samosTuning.dashBaseSpeed * 0.707));
 
             } else if (!inputList["up"] && inputList["down"]) {
 
-                s->setDashDirection("DownRight");
-                s->setFacing("Right");
+                s->setDashDirection(Facing::DownRight);
+                s->setFacing(Facing::Right);
                 if (!s->getIsInAltForm())
-                    s->setState("DashDownDiag");
+                    s->setState(State::DashDownDiag);
                 s->setSpeedPriorDash({s->getVX(), s->getVY()});
-                s->setVX(std::max(s->getVX() + samosJson["dashBonus"].get<double>(), samosJson["dashBaseSpeed"].get<double>() * 0.707));
-                s->setVY(std::max(s->getVY() + samosJson["dashBonus"].get<double>(), samosJson["dashBaseSpeed"].get<double>() * 0.707));
+                s->setVX(std::max(s->getVX() + samosTuning.dashBonus, samosTuning.dashBaseSpeed * 0.707));
+                s->setVY(std::max(s->getVY() + samosTuning.dashBonus, samosTuning.dashBaseSpeed * 0.707));
 
             } else {
 
-                s->setDashDirection("Right");
-                s->setFacing("Right");
+                s->setDashDirection(Facing::Right);
+                s->setFacing(Facing::Right);
                 if (!s->getIsInAltForm())
-                    s->setState("Dash");
+                    s->setState(State::Dash);
                 s->setSpeedPriorDash({s->getVX(), 0.0});
-                s->setVX(std::max(s->getVX() + samosJson["dashBonus"].get<double>(), samosJson["dashBaseSpeed"].get<double>()));
+                s->setVX(std::max(s->getVX() + samosTuning.dashBonus, samosTuning.dashBaseSpeed));
                 s->setVY(0.0);
 
             }
         } else if (!inputList["right"] && inputList["left"]) {
             if (inputList["up"] && !inputList["down"]) {
 
-                s->setDashDirection("UpLeft");
-                s->setFacing("Left");
+                s->setDashDirection(Facing::UpLeft);
+                s->setFacing(Facing::Left);
                 if (!s->getIsInAltForm())
-                    s->setState("DashUpDiag");
+                    s->setState(State::DashUpDiag);
                 s->setSpeedPriorDash({s->getVX(), s->getVY()});
-                s->setVX(std::min(s->getVX() - samosJson["dashBonus"].get<double>(), -samosJson["dashBaseSpeed"].get<double>() * 0.707));
-                s->setVY(std::min(s->getVY() - samosJson["dashBonus"].get<double>(), -samosJson["dashBaseSpeed"].get<double>() * 0.707));
+                s->setVX(std::min(s->getVX() - samosTuning.dashBonus, -samosTuning.dashBaseSpeed * 0.707));
+                s->setVY(std::min(s->getVY() - samosTuning.dashBonus, -samosTuning.dashBaseSpeed * 0.707));
 
             } else if (!inputList["up"] && inputList["down"]) {
 
-                s->setDashDirection("DownLeft");
-                s->setFacing("Left");
+                s->setDashDirection(Facing::DownLeft);
+                s->setFacing(Facing::Left);
                 if (!s->getIsInAltForm())
-                    s->setState("DashDownDiag");
+                    s->setState(State::DashDownDiag);
                 s->setSpeedPriorDash({s->getVX(), s->getVY()});
-                s->setVX(std::min(s->getVX() - samosJson["dashBonus"].get<double>(), -samosJson["dashBaseSpeed"].get<double>() * 0.707));
-                s->setVY(std::max(s->getVY() + samosJson["dashBonus"].get<double>(), samosJson["dashBaseSpeed"].get<double>() * 0.707));
+                s->setVX(std::min(s->getVX() - samosTuning.dashBonus, -samosTuning.dashBaseSpeed * 0.707));
+                s->setVY(std::max(s->getVY() + samosTuning.dashBonus, samosTuning.dashBaseSpeed * 0.707));
 
             } else {
 
-                s->setDashDirection("Left");
-                s->setFacing("Left");
+                s->setDashDirection(Facing::Left);
+                s->setFacing(Facing::Left);
                 if (!s->getIsInAltForm())
-                    s->setState("Dash");
+                    s->setState(State::Dash);
                 s->setSpeedPriorDash({s->getVX(), 0.0});
-                s->setVX(std::min(s->getVX() - samosJson["dashBonus"].get<double>(), -samosJson["dashBaseSpeed"].get<double>()));
+                s->setVX(std::min(s->getVX() - samosTuning.dashBonus, -samosTuning.dashBaseSpeed));
                 s->setVY(0.0);
 
             }
         } else {
             if (inputList["up"] && !inputList["down"]) {
 
-                s->setDashDirection("Up");
+                s->setDashDirection(Facing::Up);
                 if (!s->getIsInAltForm())
-                    s->setState("DashUp");
+                    s->setState(State::DashUp);
                 s->setSpeedPriorDash({0.0, s->getVY()});
                 s->setVX(0.0);
-                s->setVY(std::min(s->getVY() - samosJson["dashBonus"].get<double>(), -samosJson["dashBaseSpeed"].get<double>()));
+                s->setVY(std::min(s->getVY() - samosTuning.dashBonus, -samosTuning.dashBaseSpeed));
 
             } else if (!inputList["up"] && inputList["down"]) {
 
-                s->setDashDirection("Down");
+                s->setDashDirection(Facing::Down);
                 if (!s->getIsInAltForm())
-                    s->setState("DashDown");
+                    s->setState(State::DashDown);
                 s->setSpeedPriorDash({0.0, s->getVY()});
                 s->setVX(0.0);
-                s->setVY(std::max(s->getVY() + samosJson["dashBonus"].get<double>(), samosJson["dashBaseSpeed"].get<double>()));
+                s->setVY(std::max(s->getVY() + samosTuning.dashBonus, samosTuning.dashBaseSpeed));
 
             } else {
-                if (s->getFacing() == "Right") {
+                if (s->getFacing() == Facing::Right) {
 
-                    s->setDashDirection("Right");
+                    s->setDashDirection(Facing::Right);
                     if (!s->getIsInAltForm())
-                        s->setState("Dash");
+                        s->setState(State::Dash);
                     s->setSpeedPriorDash({s->getVX(), 0.0});
-                    s->setVX(std::max(s->getVX() + samosJson["dashBonus"].get<double>(), samosJson["dashBaseSpeed"].get<double>()));
+                    s->setVX(std::max(s->getVX() + samosTuning.dashBonus, samosTuning.dashBaseSpeed));
                     s->setVY(0.0);
 
                 } else {
 
-                    s->setDashDirection("Left");
+                    s->setDashDirection(Facing::Left);
                     if (!s->getIsInAltForm())
-                        s->setState("Dash");
+                        s->setState(State::Dash);
                     s->setSpeedPriorDash({s->getVX(), 0.0});
-                    s->setVX(std::min(s->getVX() - samosJson["dashBonus"].get<double>(), -samosJson["dashBaseSpeed"].get<double>()));
+                    s->setVX(std::min(s->getVX() - samosTuning.dashBonus, -samosTuning.dashBaseSpeed));
                     s->setVY(0.0);
                 }
             }
         }
         if (s->getIsInAltForm())
-            s->setState("MorphBallDash");
-    } else if (s->getDashDirection() != "") {
+            s->setState(State::MorphBallDash);
+    } else if (s->getDashDirection() != Facing::None) {
         if (s->getOnGround()) {
             if (inputList["jump"] && inputTime["jump"] == 0.0 && canSpin) {
                 s->setDashTime(0.0);
-                s->setDashDirection("");
-                s->setDashCoolDown(samosJson["dashGroundCooldown"].get<double>());
+                s->setDashDirection(Facing::None);
+                s->setDashCoolDown(samosTuning.dashGroundCooldown);
                 s->setDashCoolDownType("Ground");
                 s->setJumpTime(0);
                 s->setIsAffectedByGravity(true);
-                s->setFrictionFactor(samosJson["movingFriction"].get<double>());
+                s->setFrictionFactor(samosTuning.movingFriction);
                 if (s->getIsInAltForm()) {
-                    s->setVY(-static_cast<double>(samosJson["morphJumpPower"]));
-                    s->setState("MorphBall");
+                    s->setVY(-static_cast<double>(samosTuning.morphJumpPower));
+                    s->setState(State::MorphBall);
                 } else {
-                    s->setVY(-static_cast<double>(samosJson["jumpPower"]));
-                    s->setState("SpinJump");
+                    s->setVY(-static_cast<double>(samosTuning.jumpPower));
+                    s->setState(State::SpinJump);
                 }
             } else if (s->getDashTime() <= 0.0) {
-                s->setDashDirection("");
+                s->setDashDirection(Facing::None);
                 s->setIsAffectedByGravity(true);
-                s->setFrictionFactor(samosJson["movingFriction"].get<double>());
-                s->setDashCoolDown(samosJson["dashGroundCooldown"].get<double>());
+                s->setFrictionFactor(samosTuning.movingFriction);
+                s->setDashCoolDown(samosTuning.dashGroundCooldown);
                 s->setDashCoolDownType("Ground");
 
                 if (s->getVX() > 0) {
                     if (!wallR) {
                         if (s->getSpeedPriorDash().first > 0.0) {
-                            s->setVX(std::min(s->getVX(), std::max(s->getSpeedPriorDash().first, samosJson["dashBaseEndingSpeed"].get<double>())));
+                            s->setVX(std::min(s->getVX(), std::max(s->getSpeedPriorDash().first, samosTuning.dashBaseEndingSpeed)));
                         } else {
-                            s->setVX(std::min(s->getVX(), samosJson["dashBaseEndingSpeed"].get<double>()));
+                            s->setVX(std::min(s->getVX(), samosTuning.dashBaseEndingSpeed));
                         }
                     } else {
                         s->setVX(0.0);
@@ -388,9 +381,9 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
                 } else {
                     if (!wallL) {
                         if (s->getSpeedPriorDash().first < 0.0) {
-                            s->setVX(std::max(s->getVX(), std::min(s->getSpeedPriorDash().first, -samosJson["dashBaseEndingSpeed"].get<double>())));
+                            s->setVX(std::max(s->getVX(), std::min(s->getSpeedPriorDash().first, -samosTuning.dashBaseEndingSpeed)));
                         } else {
-                            s->setVX(std::max(s->getVX(), -samosJson["dashBaseEndingSpeed"].get<double>()));
+                            s->setVX(std::max(s->getVX(), -samosTuning.dashBaseEndingSpeed));
                         }
                     } else {
                         s->setVX(0.0);
@@ -401,37 +394,37 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
                     s->setVY(0.0);
                 } else {
                     if (s->getSpeedPriorDash().second < 0.0) {
-                        s->setVY(std::max(s->getVY(), std::min(s->getSpeedPriorDash().second, -samosJson["dashBaseEndingUpSpeed"].get<double>())));
+                        s->setVY(std::max(s->getVY(), std::min(s->getSpeedPriorDash().second, -samosTuning.dashBaseEndingUpSpeed)));
                     } else {
-                        s->setVY(std::max(s->getVY(), -samosJson["dashBaseEndingUpSpeed"].get<double>()));
+                        s->setVY(std::max(s->getVY(), -samosTuning.dashBaseEndingUpSpeed));
                     }
                 }
 
                 if (s->getIsInAltForm())
-                    s->setState("MorphBall");
+                    s->setState(State::MorphBall);
                 else {
                     if (canStand)
-                        s->setState("Standing");
+                        s->setState(State::Standing);
                     else if (canMorph && !canCrouch)
-                        s->setState("morphBalling");
+                        s->setState(State::morphBalling);
                     else
-                        s->setState("IdleCrouch");
+                        s->setState(State::IdleCrouch);
                 }
             }
         } else {
             if (s->getDashTime() <= 0.0) {
-                s->setDashDirection("");
+                s->setDashDirection(Facing::None);
                 s->setIsAffectedByGravity(true);
-                s->setFrictionFactor(samosJson["movingFriction"].get<double>());
-                s->setDashCoolDown(samosJson["dashAirCooldown"].get<double>());
+                s->setFrictionFactor(samosTuning.movingFriction);
+                s->setDashCoolDown(samosTuning.dashAirCooldown);
                 s->setDashCoolDownType("Air");
 
                 if (s->getVX() > 0) {
                     if (!wallR) {
                         if (s->getSpeedPriorDash().first > 0.0) {
-                            s->setVX(std::min(s->getVX(), std::max(s->getSpeedPriorDash().first, samosJson["dashBaseEndingSpeed"].get<double>())));
+                            s->setVX(std::min(s->getVX(), std::max(s->getSpeedPriorDash().first, samosTuning.dashBaseEndingSpeed)));
                         } else {
-                            s->setVX(std::min(s->getVX(), samosJson["dashBaseEndingSpeed"].get<double>()));
+                            s->setVX(std::min(s->getVX(), samosTuning.dashBaseEndingSpeed));
                         }
                     } else {
                         s->setVX(0.0);
@@ -439,9 +432,9 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
                 } else {
                     if (!wallL) {
                         if (s->getSpeedPriorDash().first < 0.0) {
-                            s->setVX(std::max(s->getVX(), std::min(s->getSpeedPriorDash().first, -samosJson["dashBaseEndingSpeed"].get<double>())));
+                            s->setVX(std::max(s->getVX(), std::min(s->getSpeedPriorDash().first, -samosTuning.dashBaseEndingSpeed)));
                         } else {
-                            s->setVX(std::max(s->getVX(), -samosJson["dashBaseEndingSpeed"].get<double>()));
+                            s->setVX(std::max(s->getVX(), -samosTuning.dashBaseEndingSpeed));
                         }
                     } else {
                         s->setVX(0.0);
@@ -450,21 +443,21 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
 
                 if (s->getVY() < 0) {
                     if (s->getSpeedPriorDash().second < 0.0) {
-                        s->setVY(std::max(s->getVY(), std::min(s->getSpeedPriorDash().second, -samosJson["dashBaseEndingUpSpeed"].get<double>())));
+                        s->setVY(std::max(s->getVY(), std::min(s->getSpeedPriorDash().second, -samosTuning.dashBaseEndingUpSpeed)));
                     } else {
-                        s->setVY(std::max(s->getVY(), -samosJson["dashBaseEndingUpSpeed"].get<double>()));
+                        s->setVY(std::max(s->getVY(), -samosTuning.dashBaseEndingUpSpeed));
                     }
                 }
 
                 if (s->getIsInAltForm())
-                    s->setState("MorphBall");
+                    s->setState(State::MorphBall);
                 else {
                     if (canFall)
-                        s->setState("Falling");
+                        s->setState(State::Falling);
                     else if (canMorph && !canSpin)
-                        s->setState("morphBalling");
+                        s->setState(State::morphBalling);
                     else
-                        s->setState("SpinJump");
+                        s->setState(State::SpinJump);
                 }
             }
         }
@@ -472,49 +465,49 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
     } else {
         if (s->getIsInAltForm()) {
             if (((inputList["morph"] && inputTime["morph"] == 0.0) || (inputList["up"] && inputTime["up"] == 0.0)) && canCrouch) {
-                s->setState("UnMorphBalling");
+                s->setState(State::UnMorphBalling);
                 s->setIsInAltForm(false);
             } else {
                 if (s->getOnGround()) {
                     if (inputList["left"] && !inputList["right"]) {
                         if (!wallL && s->getLagTime() <= 0.0) {
-                            if (s->getVX() > (static_cast<double>(samosJson["morphGroundAcceleration"]) / frameRate - static_cast<double>(samosJson["morphGroundMaxSpeed"]))) {
-                                s->setVX(s->getVX() - static_cast<double>(samosJson["morphGroundAcceleration"]) / frameRate);
-                            } else if (s->getVX() < (static_cast<double>(samosJson["morphGroundAcceleration"]) / frameRate - static_cast<double>(samosJson["morphGroundMaxSpeed"]))
-                                       && s->getVX() > -static_cast<double>(samosJson["morphGroundMaxSpeed"])) {
-                                s->setVX(-static_cast<double>(samosJson["morphGroundMaxSpeed"]));
+                            if (s->getVX() > (static_cast<double>(samosTuning.morphGroundAcceleration) / frameRate - static_cast<double>(samosTuning.morphGroundMaxSpeed))) {
+                                s->setVX(s->getVX() - static_cast<double>(samosTuning.morphGroundAcceleration) / frameRate);
+                            } else if (s->getVX() < (static_cast<double>(samosTuning.morphGroundAcceleration) / frameRate - static_cast<double>(samosTuning.morphGroundMaxSpeed))
+                                       && s->getVX() > -static_cast<double>(samosTuning.morphGroundMaxSpeed)) {
+                                s->setVX(-static_cast<double>(samosTuning.morphGroundMaxSpeed));
                             }
-                            s->setFrictionFactor(static_cast<double>(samosJson["movingFriction"]));
+                            s->setFrictionFactor(static_cast<double>(samosTuning.movingFriction));
                         } else
-                            s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        s->setFacing("Left");
-                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosJson["preJumpWindow"])) {
-                            s->setVY(-static_cast<double>(samosJson["morphJumpPower"]));
+                            s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        s->setFacing(Facing::Left);
+                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosTuning.preJumpWindow)) {
+                            s->setVY(-static_cast<double>(samosTuning.morphJumpPower));
                             s->setJumpTime(0);
                         }
                     } else if (!inputList["left"] && inputList["right"]) {
                         if (!wallR && s->getLagTime() <= 0.0) {
-                            if (s->getVX() < (static_cast<double>(samosJson["morphGroundMaxSpeed"]) - static_cast<double>(samosJson["morphGroundAcceleration"]) / frameRate)) {
-                                s->setVX(s->getVX() + static_cast<double>(samosJson["morphGroundAcceleration"]) / frameRate);
-                            } else if (s->getVX() > (static_cast<double>(samosJson["morphGroundMaxSpeed"]) - static_cast<double>(samosJson["morphGroundAcceleration"]) / frameRate)
-                                       && s->getVX() < static_cast<double>(samosJson["morphGroundMaxSpeed"])) {
-                                s->setVX(static_cast<double>(samosJson["morphGroundMaxSpeed"]));
+                            if (s->getVX() < (static_cast<double>(samosTuning.morphGroundMaxSpeed) - static_cast<double>(samosTuning.morphGroundAcceleration) / frameRate)) {
+                                s->setVX(s->getVX() + static_cast<double>(samosTuning.morphGroundAcceleration) / frameRate);
+                            } else if (s->getVX() > (static_cast<double>(samosTuning.morphGroundMaxSpeed) - static_cast<double>(samosTuning.morphGroundAcceleration) / frameRate)
+                                       && s->getVX() < static_cast<double>(samosTuning.morphGroundMaxSpeed)) {
+                                s->setVX(static_cast<double>(samosTuning.morphGroundMaxSpeed));
                             }
-                            s->setFrictionFactor(static_cast<double>(samosJson["movingFriction"]));
+                            s->setFrictionFactor(static_cast<double>(samosTuning.movingFriction));
                         } else
-                            s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        s->setFacing("Right");
-                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosJson["preJumpWindow"])) {
-                            s->setVY(-static_cast<double>(samosJson["morphJumpPower"]));
+                            s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        s->setFacing(Facing::Right);
+                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosTuning.preJumpWindow)) {
+                            s->setVY(-static_cast<double>(samosTuning.morphJumpPower));
                             s->setJumpTime(0);
                         }
                     } else {
-                        s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        if (inputList["jump"]  && inputTime["jump"] < static_cast<double>(samosJson["preJumpWindow"])) {
-                            s->setVY(-static_cast<double>(samosJson["morphJumpPower"]));
+                        s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        if (inputList["jump"]  && inputTime["jump"] < static_cast<double>(samosTuning.preJumpWindow)) {
+                            s->setVY(-static_cast<double>(samosTuning.morphJumpPower));
                             s->setJumpTime(0);
                         }
-                        if (std::abs(s->getVX()) < static_cast<double>(samosJson["slowcap"]))
+                        if (std::abs(s->getVX()) < static_cast<double>(samosTuning.slowcap))
                             s->setVX(0);
                     }
                     if (!inputList["jump"]) {
@@ -523,385 +516,371 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
                 } else {
                     if (inputList["left"] && !inputList["right"]) {
                         if (!wallL && s->getLagTime() <= 0.0) {
-                            if (s->getVX() > (static_cast<double>(samosJson["morphAirAcceleration"]) / frameRate - static_cast<double>(samosJson["morphAirMaxSpeed"]))) {
-                                s->setVX(s->getVX() - static_cast<double>(samosJson["morphAirAcceleration"]) / frameRate);
-                            } else if (s->getVX() < (static_cast<double>(samosJson["morphAirAcceleration"]) / frameRate - static_cast<double>(samosJson["morphAirMaxSpeed"]))
-                                       && s->getVX() > -static_cast<double>(samosJson["morphAirMaxSpeed"])) {
-                                s->setVX(-static_cast<double>(samosJson["morphAirMaxSpeed"]));
+                            if (s->getVX() > (static_cast<double>(samosTuning.morphAirAcceleration) / frameRate - static_cast<double>(samosTuning.morphAirMaxSpeed))) {
+                                s->setVX(s->getVX() - static_cast<double>(samosTuning.morphAirAcceleration) / frameRate);
+                            } else if (s->getVX() < (static_cast<double>(samosTuning.morphAirAcceleration) / frameRate - static_cast<double>(samosTuning.morphAirMaxSpeed))
+                                       && s->getVX() > -static_cast<double>(samosTuning.morphAirMaxSpeed)) {
+                                s->setVX(-static_cast<double>(samosTuning.morphAirMaxSpeed));
                             }
-                            s->setFrictionFactor(static_cast<double>(samosJson["movingFriction"]));
+                            s->setFrictionFactor(static_cast<double>(samosTuning.movingFriction));
                         } else
-                            s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        s->setFacing("Left");
-                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosJson["morphJumpTimeMax"]) && s->getJumpTime() >= 0) {
-                            s->setVY(s->getVY() - (static_cast<double>(samosJson["morphJumpTimeMax"]) - s->getJumpTime()) * static_cast<double>(samosJson["morphPostJumpBoost"]) / (frameRate * static_cast<double>(samosJson["morphJumpTimeMax"])));
+                            s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        s->setFacing(Facing::Left);
+                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosTuning.morphJumpTimeMax) && s->getJumpTime() >= 0) {
+                            s->setVY(s->getVY() - (static_cast<double>(samosTuning.morphJumpTimeMax) - s->getJumpTime()) * static_cast<double>(samosTuning.morphPostJumpBoost) / (frameRate * static_cast<double>(samosTuning.morphJumpTimeMax)));
                             s->setJumpTime(s->getJumpTime() + 1 / frameRate);
-                        } else if (s->getJumpTime() < static_cast<double>(samosJson["morphJumpTimeMax"]) && s->getJumpTime() >= 0){
-                            if (s->getVY() < -static_cast<double>(samosJson["morphJumpFall"]))
-                                s->setVY(-static_cast<double>(samosJson["morphJumpFall"]));
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                        } else if (s->getJumpTime() < static_cast<double>(samosTuning.morphJumpTimeMax) && s->getJumpTime() >= 0){
+                            if (s->getVY() < -static_cast<double>(samosTuning.morphJumpFall))
+                                s->setVY(-static_cast<double>(samosTuning.morphJumpFall));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         } else {
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         }
                     } else if (!inputList["left"] && inputList["right"]) {
                         if (!wallR && s->getLagTime() <= 0.0) {
-                            if (s->getVX() < (static_cast<double>(samosJson["morphAirMaxSpeed"]) - static_cast<double>(samosJson["morphAirAcceleration"]) / frameRate)) {
-                                s->setVX(s->getVX() + static_cast<double>(samosJson["morphAirAcceleration"]) / frameRate);
-                            } else if (s->getVX() > (static_cast<double>(samosJson["morphAirMaxSpeed"]) - static_cast<double>(samosJson["morphAirAcceleration"]) / frameRate)
-                                       && s->getVX() < static_cast<double>(samosJson["morphAirMaxSpeed"])) {
-                                s->setVX(static_cast<double>(samosJson["morphAirMaxSpeed"]));
+                            if (s->getVX() < (static_cast<double>(samosTuning.morphAirMaxSpeed) - static_cast<double>(samosTuning.morphAirAcceleration) / frameRate)) {
+                                s->setVX(s->getVX() + static_cast<double>(samosTuning.morphAirAcceleration) / frameRate);
+                            } else if (s->getVX() > (static_cast<double>(samosTuning.morphAirMaxSpeed) - static_cast<double>(samosTuning.morphAirAcceleration) / frameRate)
+                                       && s->getVX() < static_cast<double>(samosTuning.morphAirMaxSpeed)) {
+                                s->setVX(static_cast<double>(samosTuning.morphAirMaxSpeed));
                             }
-                            s->setFrictionFactor(static_cast<double>(samosJson["movingFriction"]));
+                            s->setFrictionFactor(static_cast<double>(samosTuning.movingFriction));
                         } else
-                            s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        s->setFacing("Right");
-                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosJson["morphJumpTimeMax"]) && s->getJumpTime() >= 0) {
-                            s->setVY(s->getVY() - (static_cast<double>(samosJson["morphJumpTimeMax"]) - s->getJumpTime()) * static_cast<double>(samosJson["morphPostJumpBoost"]) / (frameRate * static_cast<double>(samosJson["morphJumpTimeMax"])));
+                            s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        s->setFacing(Facing::Right);
+                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosTuning.morphJumpTimeMax) && s->getJumpTime() >= 0) {
+                            s->setVY(s->getVY() - (static_cast<double>(samosTuning.morphJumpTimeMax) - s->getJumpTime()) * static_cast<double>(samosTuning.morphPostJumpBoost) / (frameRate * static_cast<double>(samosTuning.morphJumpTimeMax)));
                             s->setJumpTime(s->getJumpTime() + 1 / frameRate);
-                        } else if (s->getJumpTime() < static_cast<double>(samosJson["morphJumpTimeMax"]) && s->getJumpTime() >= 0){
-                            if (s->getVY() < -static_cast<double>(samosJson["morphJumpFall"]))
-                                s->setVY(-static_cast<double>(samosJson["morphJumpFall"]));
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                        } else if (s->getJumpTime() < static_cast<double>(samosTuning.morphJumpTimeMax) && s->getJumpTime() >= 0){
+                            if (s->getVY() < -static_cast<double>(samosTuning.morphJumpFall))
+                                s->setVY(-static_cast<double>(samosTuning.morphJumpFall));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         } else {
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         }
                     } else {
-                        s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosJson["morphJumpTimeMax"]) && s->getJumpTime() >= 0) {
-                            s->setVY(s->getVY() - (static_cast<double>(samosJson["morphJumpTimeMax"]) - s->getJumpTime()) * static_cast<double>(samosJson["morphPostJumpBoost"]) / (frameRate * static_cast<double>(samosJson["morphJumpTimeMax"])));
+                        s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosTuning.morphJumpTimeMax) && s->getJumpTime() >= 0) {
+                            s->setVY(s->getVY() - (static_cast<double>(samosTuning.morphJumpTimeMax) - s->getJumpTime()) * static_cast<double>(samosTuning.morphPostJumpBoost) / (frameRate * static_cast<double>(samosTuning.morphJumpTimeMax)));
                             s->setJumpTime(s->getJumpTime() + 1 / frameRate);
-                        } else if (s->getJumpTime() < static_cast<double>(samosJson["morphJumpTimeMax"]) && s->getJumpTime() >= 0){
-                            if (s->getVY() < -static_cast<double>(samosJson["morphJumpFall"]))
-                                s->setVY(-static_cast<double>(samosJson["morphJumpFall"]));
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                        } else if (s->getJumpTime() < static_cast<double>(samosTuning.morphJumpTimeMax) && s->getJumpTime() >= 0){
+                            if (s->getVY() < -static_cast<double>(samosTuning.morphJumpFall))
+                                s->setVY(-static_cast<double>(samosTuning.morphJumpFall));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         } else {
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         }
-                        if (std::abs(s->getVX()) < static_cast<double>(samosJson["slowcap"]))
+                        if (std::abs(s->getVX()) < static_cast<double>(samosTuning.slowcap))
                             s->setVX(0);
                     }
                 }
             }
         } else {
             if (inputList["morph"] && inputTime["morph"] == 0.0 && canMorph) {
-                s->setState("MorphBalling");
+                s->setState(State::MorphBalling);
                 if (s->getOnGround()) {
-                    if ((s->getState() == "Falling") || (s->getState() == "FallingAimUp")|| (s->getState() == "FallingAimUpDiag") || (s->getState() == "FallingAimDownDiag")|| (s->getState() == "FallingAimDown")) {
-                        s->setY(s->getY() - static_cast<int>(samosJson["morphBallHitbox_height"]) - static_cast<int>(samosJson["morphBallHitbox_offset_y"]) +
-                                static_cast<int>(samosJson["fallingHitbox_height"]) + static_cast<int>(samosJson["fallingHitbox_offset_y"]));
-                    } else if (s->getState() == "SpinJump" || s->getState() == "WallJump") {
-                        s->setY(s->getY() - static_cast<int>(samosJson["morphBallHitbox_height"]) - static_cast<int>(samosJson["morphBallHitbox_offset_y"]) +
-                                static_cast<int>(samosJson["spinJumpHitbox_height"]) + static_cast<int>(samosJson["spinJumpHitbox_offset_y"]));
-                    } else if (s->getState() == "IdleCrouch" || s->getState() == "Crouching" || s->getState() == "UnCrouching") {
-                        s->setY(s->getY() - static_cast<int>(samosJson["morphBallHitbox_height"]) - static_cast<int>(samosJson["morphBallHitbox_offset_y"]) +
-                                static_cast<int>(samosJson["crouchHitbox_height"]) + static_cast<int>(samosJson["crouchHitbox_offset_y"]));
-                    } else
-                        s->setY(s->getY() - static_cast<int>(samosJson["morphBallHitbox_height"]) - static_cast<int>(samosJson["morphBallHitbox_offset_y"]) +
-                                static_cast<int>(samosJson["height"]) + static_cast<int>(samosJson["offset_y"]));
-               }
-            } else if (inputList["aim"] && s->getState() != "MorphBalling") {
+                    // The state is already MorphBalling here, so the feet are placed from the standing hitbox
+                    CollisionBox standBox = samosTuning.hitboxes[SamosStates::Stand];
+                    CollisionBox morphBox = samosTuning.hitboxes[SamosStates::Morph];
+                    s->setY(s->getY() - morphBox.getHeight() - morphBox.getY() + standBox.getHeight() + standBox.getY());
+                }
+            } else if (inputList["aim"] && s->getState() != State::MorphBalling) {
                 if (s->getOnGround()) {
-                    if ((s->getState() == "Jumping") || (s->getState() == "SpinJump") || (s->getState() == "Falling") || (s->getState() == "JumpEnd") || (s->getState() == "WallJump")
-                            || (s->getState() == "FallingAimUp")|| (s->getState() == "FallingAimUpDiag")|| (s->getState() == "FallingAimDownDiag")|| (s->getState() == "FallingAimDown")) {
+                    if (SamosStates::is(s->getState(), SamosStates::airborne)) {
                         if (canStand)
-                            s->setState("Landing");
+                            s->setState(State::Landing);
                         else if (canCrouch)
-                            s->setState("IdleCrouch");
+                            s->setState(State::IdleCrouch);
                         else if (canMorph)
-                            s->setState("MorphBalling");
-                    } else if (inputList["jump"]  && inputTime["jump"] < static_cast<double>(samosJson["preJumpWindow"]) && canStand) {
-                        s->setVY(-static_cast<double>(samosJson["jumpPower"]));
+                            s->setState(State::MorphBalling);
+                    } else if (inputList["jump"]  && inputTime["jump"] < static_cast<double>(samosTuning.preJumpWindow) && canStand) {
+                        s->setVY(-static_cast<double>(samosTuning.jumpPower));
                         s->setJumpTime(0);
-                        s->setState("Jumping");
-                    } else if ((s->getState() == "Crouching" || s->getState() == "IdleCrouch" || s->getState() == "CrouchAimUp" || s->getState() == "CrouchAimUpDiag"
-                               || s->getState() == "CrouchAimDownDiag" || s->getState() == "UnMorphBalling") && canCrouch) {
-                        s->setState("IdleCrouch");
+                        s->setState(State::Jumping);
+                    } else if ((SamosStates::is(s->getState(), SamosStates::crouched) || s->getState() == State::UnMorphBalling) && canCrouch) {
+                        s->setState(State::IdleCrouch);
                     } else {
                         if (canStand)
-                            s->setState("Standing");
+                            s->setState(State::Standing);
                         else if (canCrouch)
-                            s->setState("IdleCrouch");
+                            s->setState(State::IdleCrouch);
                         else if (canMorph)
-                            s->setState("MorphBalling");
+                            s->setState(State::MorphBalling);
                     }
                     if (!inputList["jump"])
                         s->setJumpTime(-1);
                 }
-                if (!s->getOnGround() || s->getState() == "Jumping") {
-                    if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosJson["preJumpWindow"]) && s->getState() == "WallJump" && (s->getJumpTime() < 0.0 || s->getJumpTime() >= static_cast<double>(samosJson["jumpTimeMax"]))) {
-                        if (s->getFacing() == "Left") {
+                if (!s->getOnGround() || s->getState() == State::Jumping) {
+                    if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosTuning.preJumpWindow) && s->getState() == State::WallJump && (s->getJumpTime() < 0.0 || s->getJumpTime() >= static_cast<double>(samosTuning.jumpTimeMax))) {
+                        if (s->getFacing() == Facing::Left) {
                             if (!wallL) {
-                                if (s->getVX() > static_cast<double>(samosJson["wallJumpPower_x"]))
+                                if (s->getVX() > static_cast<double>(samosTuning.wallJumpPowerX))
                                     s->setVX(-s->getVX());
-                                else if (s->getRetainTime() > -samosJson["speedRetainWallJumpBonusWindow"].get<double>() && s->getSpeedRetained() > static_cast<double>(samosJson["wallJumpPower_x"])) {
+                                else if (s->getRetainTime() > -samosTuning.speedRetainWallJumpBonusWindow && s->getSpeedRetained() > static_cast<double>(samosTuning.wallJumpPowerX)) {
                                     s->setVX(-s->getSpeedRetained());
                                     s->setRetainTime(0.0);
-                                } else if (s->getVX() > -static_cast<double>(samosJson["wallJumpPower_x"]))
-                                    s->setVX(-static_cast<double>(samosJson["wallJumpPower_x"]));
+                                } else if (s->getVX() > -static_cast<double>(samosTuning.wallJumpPowerX))
+                                    s->setVX(-static_cast<double>(samosTuning.wallJumpPowerX));
                             }
                         } else {
                             if (!wallR) {
-                                if (s->getVX() < -static_cast<double>(samosJson["wallJumpPower_x"]))
+                                if (s->getVX() < -static_cast<double>(samosTuning.wallJumpPowerX))
                                     s->setVX(-s->getVX());
-                                else if (s->getRetainTime() > -samosJson["speedRetainWallJumpBonusWindow"].get<double>() && s->getSpeedRetained() < -static_cast<double>(samosJson["wallJumpPower_x"])) {
+                                else if (s->getRetainTime() > -samosTuning.speedRetainWallJumpBonusWindow && s->getSpeedRetained() < -static_cast<double>(samosTuning.wallJumpPowerX)) {
                                     s->setVX(-s->getSpeedRetained());
                                     s->setRetainTime(0.0);
-                                } else if (s->getVX() < static_cast<double>(samosJson["wallJumpPower_x"]))
-                                    s->setVX(static_cast<double>(samosJson["wallJumpPower_x"]));
+                                } else if (s->getVX() < static_cast<double>(samosTuning.wallJumpPowerX))
+                                    s->setVX(static_cast<double>(samosTuning.wallJumpPowerX));
                             }
                         }
-                        s->setVY(-static_cast<double>(samosJson["wallJumpPower_y"]));
-                        s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                        s->setVY(-static_cast<double>(samosTuning.wallJumpPowerY));
+                        s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                     }
 
                     if (canFall)
-                        s->setState("Falling");
+                        s->setState(State::Falling);
                     else if (canSpin)
-                        s->setState("SpinJump");
+                        s->setState(State::SpinJump);
                     else if (canMorph)
-                        s->setState("MorphBalling");
+                        s->setState(State::MorphBalling);
 
-                    if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosJson["jumpTimeMax"]) && s->getJumpTime() >= 0) {
-                        s->setVY(s->getVY() - (static_cast<double>(samosJson["jumpTimeMax"]) - s->getJumpTime()) * static_cast<double>(samosJson["postJumpBoost"]) / (frameRate * static_cast<double>(samosJson["jumpTimeMax"])));
+                    if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosTuning.jumpTimeMax) && s->getJumpTime() >= 0) {
+                        s->setVY(s->getVY() - (static_cast<double>(samosTuning.jumpTimeMax) - s->getJumpTime()) * static_cast<double>(samosTuning.postJumpBoost) / (frameRate * static_cast<double>(samosTuning.jumpTimeMax)));
                         s->setJumpTime(s->getJumpTime() + 1 / frameRate);
-                    } else if (s->getJumpTime() < static_cast<double>(samosJson["jumpTimeMax"]) && s->getJumpTime() >= 0){
-                        if (s->getVY() < -static_cast<double>(samosJson["jumpFall"]))
-                            s->setVY(-static_cast<double>(samosJson["jumpFall"]));
-                        s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                    } else if (s->getJumpTime() < static_cast<double>(samosTuning.jumpTimeMax) && s->getJumpTime() >= 0){
+                        if (s->getVY() < -static_cast<double>(samosTuning.jumpFall))
+                            s->setVY(-static_cast<double>(samosTuning.jumpFall));
+                        s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                     } else {
-                        s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                        s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                     }
                 }
 
-                if (std::abs(s->getVX()) < static_cast<double>(samosJson["slowcap"]))
+                if (std::abs(s->getVX()) < static_cast<double>(samosTuning.slowcap))
                     s->setVX(0);
-                s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
+                s->setFrictionFactor(static_cast<double>(samosType->friction));
             } else {
                 if (s->getOnGround()) {
-                    if ((s->getState() == "Jumping") || (s->getState() == "SpinJump") || (s->getState() == "Falling") || (s->getState() == "JumpEnd") || (s->getState() == "WallJump")
-                            || (s->getState() == "FallingAimUp")|| (s->getState() == "FallingAimUpDiag")|| (s->getState() == "FallingAimDownDiag")|| (s->getState() == "FallingAimDown")) {
+                    if (SamosStates::is(s->getState(), SamosStates::airborne)) {
                         if (canStand)
-                            s->setState("Landing");
+                            s->setState(State::Landing);
                         else if (canCrouch)
-                            s->setState("IdleCrouch");
+                            s->setState(State::IdleCrouch);
                         else if (canMorph)
-                            s->setState("MorphBalling");
+                            s->setState(State::MorphBalling);
                     } else if (inputList["left"] && !inputList["right"]) {
                         if (!wallL && canStand && s->getLagTime() <= 0.0) {
                             if (!inputList["run"]) {
-                                if (s->getVX() > (static_cast<double>(samosJson["groundAcceleration"]) / frameRate - static_cast<double>(samosJson["groundMaxSpeed"]))) {
-                                    s->setVX(s->getVX() - static_cast<double>(samosJson["groundAcceleration"]) / frameRate);
-                                } else if (s->getVX() < (static_cast<double>(samosJson["groundAcceleration"]) / frameRate - static_cast<double>(samosJson["groundMaxSpeed"]))
-                                           && s->getVX() > -static_cast<double>(samosJson["groundMaxSpeed"])) {
-                                    s->setVX(-static_cast<double>(samosJson["groundMaxSpeed"]));
+                                if (s->getVX() > (static_cast<double>(samosTuning.groundAcceleration) / frameRate - static_cast<double>(samosTuning.groundMaxSpeed))) {
+                                    s->setVX(s->getVX() - static_cast<double>(samosTuning.groundAcceleration) / frameRate);
+                                } else if (s->getVX() < (static_cast<double>(samosTuning.groundAcceleration) / frameRate - static_cast<double>(samosTuning.groundMaxSpeed))
+                                           && s->getVX() > -static_cast<double>(samosTuning.groundMaxSpeed)) {
+                                    s->setVX(-static_cast<double>(samosTuning.groundMaxSpeed));
                                 }
                             } else {
-                                if (s->getVX() > (static_cast<double>(samosJson["groundRunAcceleration"]) / frameRate - static_cast<double>(samosJson["groundRunMaxSpeedGap"]))) {
-                                    if (s->getVX() > -static_cast<double>(samosJson["groundMaxSpeed"]))
-                                        s->setVX(s->getVX() - static_cast<double>(samosJson["groundAcceleration"]) / frameRate);
+                                if (s->getVX() > (static_cast<double>(samosTuning.groundRunAcceleration) / frameRate - static_cast<double>(samosTuning.groundRunMaxSpeedGap))) {
+                                    if (s->getVX() > -static_cast<double>(samosTuning.groundMaxSpeed))
+                                        s->setVX(s->getVX() - static_cast<double>(samosTuning.groundAcceleration) / frameRate);
                                     else
-                                        s->setVX(s->getVX() - static_cast<double>(samosJson["groundRunAcceleration"]) / frameRate);
-                                } else if (s->getVX() < (static_cast<double>(samosJson["groundRunAcceleration"]) / frameRate - static_cast<double>(samosJson["groundRunMaxSpeedGap"]))
-                                           && s->getVX() > -static_cast<double>(samosJson["groundRunMaxSpeed"])) {
-                                    s->setVX(-static_cast<double>(samosJson["groundRunMaxSpeed"]));
+                                        s->setVX(s->getVX() - static_cast<double>(samosTuning.groundRunAcceleration) / frameRate);
+                                } else if (s->getVX() < (static_cast<double>(samosTuning.groundRunAcceleration) / frameRate - static_cast<double>(samosTuning.groundRunMaxSpeedGap))
+                                           && s->getVX() > -static_cast<double>(samosTuning.groundRunMaxSpeed)) {
+                                    s->setVX(-static_cast<double>(samosTuning.groundRunMaxSpeed));
                                 }
                             }
-                            s->setFrictionFactor(static_cast<double>(samosJson["movingFriction"]));
+                            s->setFrictionFactor(static_cast<double>(samosTuning.movingFriction));
                         } else
-                            s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        s->setFacing("Left");
-                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosJson["preJumpWindow"]) && canSpin) {
-                            s->setVY(-static_cast<double>(samosJson["jumpPower"]));
+                            s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        s->setFacing(Facing::Left);
+                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosTuning.preJumpWindow) && canSpin) {
+                            s->setVY(-static_cast<double>(samosTuning.jumpPower));
                             s->setJumpTime(0);
-                            s->setState("SpinJump");
-                        } else if (s->getState() != "MorphBalling" && s->getState() != "UnMorphBalling" && canStand) {
+                            s->setState(State::SpinJump);
+                        } else if (s->getState() != State::MorphBalling && s->getState() != State::UnMorphBalling && canStand) {
                             if (!wallL && s->getLagTime() <= 0.0) {
                                 if (inputList["down"] && !inputList["up"])
-                                    s->setState("WalkingAimDown");
+                                    s->setState(State::WalkingAimDown);
                                 else if (!inputList["down"] && inputList["up"])
-                                    s->setState("WalkingAimUp");
+                                    s->setState(State::WalkingAimUp);
                                 else
-                                    s->setState("Walking");
+                                    s->setState(State::Walking);
                             } else {
-                                s->setState("Standing");
+                                s->setState(State::Standing);
                             }
                         }
                     } else if (!inputList["left"] && inputList["right"]) {
                         if (!wallR && canStand && s->getLagTime() <= 0.0) {
                             if (!inputList["run"]) {
-                                if (s->getVX() < (static_cast<double>(samosJson["groundMaxSpeed"]) - static_cast<double>(samosJson["groundAcceleration"]) / frameRate)) {
-                                    s->setVX(s->getVX() + static_cast<double>(samosJson["groundAcceleration"]) / frameRate);
-                                } else if (s->getVX() > (static_cast<double>(samosJson["groundMaxSpeed"]) - static_cast<double>(samosJson["groundAcceleration"]) / frameRate)
-                                           && s->getVX() < static_cast<double>(samosJson["groundMaxSpeed"])) {
-                                    s->setVX(static_cast<double>(samosJson["groundMaxSpeed"]));
+                                if (s->getVX() < (static_cast<double>(samosTuning.groundMaxSpeed) - static_cast<double>(samosTuning.groundAcceleration) / frameRate)) {
+                                    s->setVX(s->getVX() + static_cast<double>(samosTuning.groundAcceleration) / frameRate);
+                                } else if (s->getVX() > (static_cast<double>(samosTuning.groundMaxSpeed) - static_cast<double>(samosTuning.groundAcceleration) / frameRate)
+                                           && s->getVX() < static_cast<double>(samosTuning.groundMaxSpeed)) {
+                                    s->setVX(static_cast<double>(samosTuning.groundMaxSpeed));
                                 }
                             } else {
-                                if (s->getVX() < (static_cast<double>(samosJson["groundRunMaxSpeedGap"]) - static_cast<double>(samosJson["groundRunAcceleration"]) / frameRate)) {
-                                    if (s->getVX() < static_cast<double>(samosJson["groundMaxSpeed"]))
-                                        s->setVX(s->getVX() + static_cast<double>(samosJson["groundAcceleration"]) / frameRate);
+                                if (s->getVX() < (static_cast<double>(samosTuning.groundRunMaxSpeedGap) - static_cast<double>(samosTuning.groundRunAcceleration) / frameRate)) {
+                                    if (s->getVX() < static_cast<double>(samosTuning.groundMaxSpeed))
+                                        s->setVX(s->getVX() + static_cast<double>(samosTuning.groundAcceleration) / frameRate);
                                     else
-                                        s->setVX(s->getVX() + static_cast<double>(samosJson["groundRunAcceleration"]) / frameRate);
-                                } else if (s->getVX() > (static_cast<double>(samosJson["groundRunMaxSpeedGap"]) - static_cast<double>(samosJson["groundRunAcceleration"]) / frameRate)
-                                           && s->getVX() < static_cast<double>(samosJson["groundRunMaxSpeed"])) {
-                                    s->setVX(static_cast<double>(samosJson["groundRunMaxSpeed"]));
+                                        s->setVX(s->getVX() + static_cast<double>(samosTuning.groundRunAcceleration) / frameRate);
+                                } else if (s->getVX() > (static_cast<double>(samosTuning.groundRunMaxSpeedGap) - static_cast<double>(samosTuning.groundRunAcceleration) / frameRate)
+                                           && s->getVX() < static_cast<double>(samosTuning.groundRunMaxSpeed)) {
+                                    s->setVX(static_cast<double>(samosTuning.groundRunMaxSpeed));
                                 }
                             }
-                            s->setFrictionFactor(static_cast<double>(samosJson["movingFriction"]));
+                            s->setFrictionFactor(static_cast<double>(samosTuning.movingFriction));
                         } else
-                            s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        s->setFacing("Right");
-                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosJson["preJumpWindow"]) && canSpin) {
-                            s->setVY(-static_cast<double>(samosJson["jumpPower"]));
+                            s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        s->setFacing(Facing::Right);
+                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosTuning.preJumpWindow) && canSpin) {
+                            s->setVY(-static_cast<double>(samosTuning.jumpPower));
                             s->setJumpTime(0);
-                            s->setState("SpinJump");
-                        } else if (s->getState() != "MorphBalling" && s->getState() != "UnMorphBalling") {
+                            s->setState(State::SpinJump);
+                        } else if (s->getState() != State::MorphBalling && s->getState() != State::UnMorphBalling) {
                             if (!wallR && s->getLagTime() <= 0.0) {
                                 if (inputList["down"] && !inputList["up"])
-                                    s->setState("WalkingAimDown");
+                                    s->setState(State::WalkingAimDown);
                                 else if (!inputList["down"] && inputList["up"])
-                                    s->setState("WalkingAimUp");
+                                    s->setState(State::WalkingAimUp);
                                 else
-                                    s->setState("Walking");
+                                    s->setState(State::Walking);
                             } else {
-                                s->setState("Standing");
+                                s->setState(State::Standing);
                             }
                         }
                     } else {
-                        s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosJson["preJumpWindow"]) && canStand) {
-                            s->setVY(-static_cast<double>(samosJson["jumpPower"]));
+                        s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosTuning.preJumpWindow) && canStand) {
+                            s->setVY(-static_cast<double>(samosTuning.jumpPower));
                             s->setJumpTime(0);
-                            s->setState("Jumping");
-                        } else if (s->getState() != "MorphBalling" && s->getState() != "UnMorphBalling") {
-                            if (inputList["down"] && !inputList["up"] && inputTime["down"] == 0.0 && canMorph && s->getState() == "IdleCrouch")
-                                s->setState("MorphBalling");
+                            s->setState(State::Jumping);
+                        } else if (s->getState() != State::MorphBalling && s->getState() != State::UnMorphBalling) {
+                            if (inputList["down"] && !inputList["up"] && inputTime["down"] == 0.0 && canMorph && s->getState() == State::IdleCrouch)
+                                s->setState(State::MorphBalling);
                             else {
                                 if (canCrouch) {
-                                    if (!inputList["up"] && inputList["down"] && inputTime["down"] == 0.0 && (s->getState() == "Standing" || s->getState() == "UnCrouching"))
-                                        s->setState("Crouching");
-                                    else if (s->getState() == "Crouching" && s->getFrame() == (static_cast<unsigned int>(Entity::values["textures"][Entity::values["names"]["Samos"]["texture"]]["Crouching"]["count"]) - 1))
-                                        s->setState("IdleCrouch");
+                                    if (!inputList["up"] && inputList["down"] && inputTime["down"] == 0.0 && (s->getState() == State::Standing || s->getState() == State::UnCrouching))
+                                        s->setState(State::Crouching);
+                                    else if (s->getState() == State::Crouching && s->getFrame() == (samosType->getClip(State::Crouching).count - 1))
+                                        s->setState(State::IdleCrouch);
                                 }
                                 if (canStand) {
-                                    if (inputList["up"] && !inputList["down"] && inputTime["up"] == 0.0 && (s->getState() == "IdleCrouch" || s->getState() == "Crouching") && s->getState() != "UnMorphBalling")
-                                        s->setState("UnCrouching");
-                                    else if (s->getState() == "UnCrouching" && s->getFrame() == (static_cast<unsigned int>(Entity::values["textures"][Entity::values["names"]["Samos"]["texture"]]["UnCrouching"]["count"]) - 1))
-                                        s->setState("Standing");
+                                    if (inputList["up"] && !inputList["down"] && inputTime["up"] == 0.0 && (s->getState() == State::IdleCrouch || s->getState() == State::Crouching) && s->getState() != State::UnMorphBalling)
+                                        s->setState(State::UnCrouching);
+                                    else if (s->getState() == State::UnCrouching && s->getFrame() == (samosType->getClip(State::UnCrouching).count - 1))
+                                        s->setState(State::Standing);
 
-                                    if (s->getState() != "IdleCrouch" && s->getState() != "Crouching" && s->getState() != "UnCrouching" && s->getState() != "CrouchAimUp" && s->getState() != "CrouchAimUpDiag" && s->getState() != "CrouchAimDownDiag"&& s->getState() != "UnMorphBalling")
-                                        s->setState("Standing");
+                                    if (SamosStates::get(s->getState()).stance != SamosStates::Crouch)
+                                        s->setState(State::Standing);
                                 }
                             }
                         }
-                        if (std::abs(s->getVX()) < static_cast<double>(samosJson["slowcap"]))
+                        if (std::abs(s->getVX()) < static_cast<double>(samosTuning.slowcap))
                             s->setVX(0);
                     }
                     if (!inputList["jump"]) {
                         s->setJumpTime(-1);
                     }
                 } else {
-                    if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosJson["preJumpWindow"]) && s->getState() == "WallJump" && (s->getJumpTime() < 0.0 || s->getJumpTime() >= static_cast<double>(samosJson["jumpTimeMax"]))) {
-                        if (s->getFacing() == "Left") {
+                    if (inputList["jump"] && inputTime["jump"] < static_cast<double>(samosTuning.preJumpWindow) && s->getState() == State::WallJump && (s->getJumpTime() < 0.0 || s->getJumpTime() >= static_cast<double>(samosTuning.jumpTimeMax))) {
+                        if (s->getFacing() == Facing::Left) {
                             if (!wallL) {
-                                if (s->getVX() > static_cast<double>(samosJson["wallJumpPower_x"]))
+                                if (s->getVX() > static_cast<double>(samosTuning.wallJumpPowerX))
                                     s->setVX(-s->getVX());
-                                else if (s->getRetainTime() > -samosJson["speedRetainWallJumpBonusWindow"].get<double>() && s->getSpeedRetained() > static_cast<double>(samosJson["wallJumpPower_x"])) {
+                                else if (s->getRetainTime() > -samosTuning.speedRetainWallJumpBonusWindow && s->getSpeedRetained() > static_cast<double>(samosTuning.wallJumpPowerX)) {
                                     s->setVX(-s->getSpeedRetained());
                                     s->setRetainTime(0.0);
-                                } else if (s->getVX() > -static_cast<double>(samosJson["wallJumpPower_x"]))
-                                    s->setVX(-static_cast<double>(samosJson["wallJumpPower_x"]));
+                                } else if (s->getVX() > -static_cast<double>(samosTuning.wallJumpPowerX))
+                                    s->setVX(-static_cast<double>(samosTuning.wallJumpPowerX));
                             }
                         } else {
                             if (!wallR) {
-                                if (s->getVX() < -static_cast<double>(samosJson["wallJumpPower_x"]))
+                                if (s->getVX() < -static_cast<double>(samosTuning.wallJumpPowerX))
                                     s->setVX(-s->getVX());
-                                else if (s->getRetainTime() > -samosJson["speedRetainWallJumpBonusWindow"].get<double>() && s->getSpeedRetained() < -static_cast<double>(samosJson["wallJumpPower_x"])) {
+                                else if (s->getRetainTime() > -samosTuning.speedRetainWallJumpBonusWindow && s->getSpeedRetained() < -static_cast<double>(samosTuning.wallJumpPowerX)) {
                                     s->setVX(-s->getSpeedRetained());
                                     s->setRetainTime(0.0);
-                                } else if (s->getVX() < static_cast<double>(samosJson["wallJumpPower_x"]))
-                                    s->setVX(static_cast<double>(samosJson["wallJumpPower_x"]));
+                                } else if (s->getVX() < static_cast<double>(samosTuning.wallJumpPowerX))
+                                    s->setVX(static_cast<double>(samosTuning.wallJumpPowerX));
                             }
                         }
-                        s->setVY(-static_cast<double>(samosJson["wallJumpPower_y"]));
-                        s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                        s->setVY(-static_cast<double>(samosTuning.wallJumpPowerY));
+                        s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                     } else if (inputList["left"] && !inputList["right"]) {
                         if (!wallL && s->getLagTime() <= 0.0) {
-                            if (s->getVX() > (static_cast<double>(samosJson["airAcceleration"]) / frameRate - static_cast<double>(samosJson["airMaxSpeed"]))) {
-                                s->setVX(s->getVX() - static_cast<double>(samosJson["airAcceleration"]) / frameRate);
-                            } else if (s->getVX() < (static_cast<double>(samosJson["airAcceleration"]) / frameRate - static_cast<double>(samosJson["airMaxSpeed"]))
-                                       && s->getVX() > -static_cast<double>(samosJson["airMaxSpeed"])) {
-                                s->setVX(-static_cast<double>(samosJson["airMaxSpeed"]));
+                            if (s->getVX() > (static_cast<double>(samosTuning.airAcceleration) / frameRate - static_cast<double>(samosTuning.airMaxSpeed))) {
+                                s->setVX(s->getVX() - static_cast<double>(samosTuning.airAcceleration) / frameRate);
+                            } else if (s->getVX() < (static_cast<double>(samosTuning.airAcceleration) / frameRate - static_cast<double>(samosTuning.airMaxSpeed))
+                                       && s->getVX() > -static_cast<double>(samosTuning.airMaxSpeed)) {
+                                s->setVX(-static_cast<double>(samosTuning.airMaxSpeed));
                             }
-                            s->setFrictionFactor(static_cast<double>(samosJson["movingFriction"]));
+                            s->setFrictionFactor(static_cast<double>(samosTuning.movingFriction));
                         } else
-                            s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        s->setFacing("Left");
-                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosJson["jumpTimeMax"]) && s->getJumpTime() >= 0) {
-                            s->setVY(s->getVY() - (static_cast<double>(samosJson["jumpTimeMax"]) - s->getJumpTime()) * static_cast<double>(samosJson["postJumpBoost"]) / (frameRate * static_cast<double>(samosJson["jumpTimeMax"])));
+                            s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        s->setFacing(Facing::Left);
+                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosTuning.jumpTimeMax) && s->getJumpTime() >= 0) {
+                            s->setVY(s->getVY() - (static_cast<double>(samosTuning.jumpTimeMax) - s->getJumpTime()) * static_cast<double>(samosTuning.postJumpBoost) / (frameRate * static_cast<double>(samosTuning.jumpTimeMax)));
                             s->setJumpTime(s->getJumpTime() + 1 / frameRate);
-                        } else if (s->getJumpTime() < static_cast<double>(samosJson["jumpTimeMax"]) && s->getJumpTime() >= 0){
-                            if (s->getVY() < -static_cast<double>(samosJson["jumpFall"]))
-                                s->setVY(-static_cast<double>(samosJson["jumpFall"]));
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                        } else if (s->getJumpTime() < static_cast<double>(samosTuning.jumpTimeMax) && s->getJumpTime() >= 0){
+                            if (s->getVY() < -static_cast<double>(samosTuning.jumpFall))
+                                s->setVY(-static_cast<double>(samosTuning.jumpFall));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         } else {
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         }
-                        if (s->getState() == "Jumping" && (!inputList["jump"] || s->getJumpTime() >= static_cast<double>(samosJson["jumpTimeMax"])))
-                                                s->setState("JumpEnd");
+                        if (s->getState() == State::Jumping && (!inputList["jump"] || s->getJumpTime() >= static_cast<double>(samosTuning.jumpTimeMax)))
+                                                s->setState(State::JumpEnd);
 
-                        if (s->getState() != "SpinJump" && s->getState() != "WallJump" && s->getState() != "Jumping" && s->getState() != "JumpEnd"
-                                && s->getState() != "MorphBalling" && s->getState() != "UnMorphBalling" && canFall) {
-                            s->setState("Falling");
+                        if (!SamosStates::is(s->getState(), SamosStates::jump | SamosStates::morphTransition) && canFall) {
+                            s->setState(State::Falling);
                         }
                     } else if (!inputList["left"] && inputList["right"]) {
                         if (!wallR && s->getLagTime() <= 0.0) {
-                            if (s->getVX() < (static_cast<double>(samosJson["airMaxSpeed"]) - static_cast<double>(samosJson["airAcceleration"]) / frameRate)) {
-                                s->setVX(s->getVX() + static_cast<double>(samosJson["airAcceleration"]) / frameRate);
-                            } else if (s->getVX() > (static_cast<double>(samosJson["airMaxSpeed"]) - static_cast<double>(samosJson["airAcceleration"]) / frameRate)
-                                       && s->getVX() < static_cast<double>(samosJson["airMaxSpeed"])) {
-                                s->setVX(static_cast<double>(samosJson["airMaxSpeed"]));
+                            if (s->getVX() < (static_cast<double>(samosTuning.airMaxSpeed) - static_cast<double>(samosTuning.airAcceleration) / frameRate)) {
+                                s->setVX(s->getVX() + static_cast<double>(samosTuning.airAcceleration) / frameRate);
+                            } else if (s->getVX() > (static_cast<double>(samosTuning.airMaxSpeed) - static_cast<double>(samosTuning.airAcceleration) / frameRate)
+                                       && s->getVX() < static_cast<double>(samosTuning.airMaxSpeed)) {
+                                s->setVX(static_cast<double>(samosTuning.airMaxSpeed));
                             }
-                            s->setFrictionFactor(static_cast<double>(samosJson["movingFriction"]));
+                            s->setFrictionFactor(static_cast<double>(samosTuning.movingFriction));
                         } else
-                            s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        s->setFacing("Right");
-                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosJson["jumpTimeMax"]) && s->getJumpTime() >= 0) {
-                            s->setVY(s->getVY() - (static_cast<double>(samosJson["jumpTimeMax"]) - s->getJumpTime()) * static_cast<double>(samosJson["postJumpBoost"]) / (frameRate * static_cast<double>(samosJson["jumpTimeMax"])));
+                            s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        s->setFacing(Facing::Right);
+                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosTuning.jumpTimeMax) && s->getJumpTime() >= 0) {
+                            s->setVY(s->getVY() - (static_cast<double>(samosTuning.jumpTimeMax) - s->getJumpTime()) * static_cast<double>(samosTuning.postJumpBoost) / (frameRate * static_cast<double>(samosTuning.jumpTimeMax)));
                             s->setJumpTime(s->getJumpTime() + 1 / frameRate);
-                        } else if (s->getJumpTime() < static_cast<double>(samosJson["jumpTimeMax"]) && s->getJumpTime() >= 0){
-                            if (s->getVY() < -static_cast<double>(samosJson["jumpFall"]))
-                                s->setVY(-static_cast<double>(samosJson["jumpFall"]));
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                        } else if (s->getJumpTime() < static_cast<double>(samosTuning.jumpTimeMax) && s->getJumpTime() >= 0){
+                            if (s->getVY() < -static_cast<double>(samosTuning.jumpFall))
+                                s->setVY(-static_cast<double>(samosTuning.jumpFall));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         } else {
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         }
-                        if (s->getState() == "Jumping" && (!inputList["jump"] || s->getJumpTime() >= static_cast<double>(samosJson["jumpTimeMax"])))
-                                                s->setState("JumpEnd");
+                        if (s->getState() == State::Jumping && (!inputList["jump"] || s->getJumpTime() >= static_cast<double>(samosTuning.jumpTimeMax)))
+                                                s->setState(State::JumpEnd);
 
-                        if (s->getState() != "SpinJump" && s->getState() != "WallJump" && s->getState() != "Jumping" && s->getState() != "JumpEnd"
-                                && s->getState() != "MorphBalling" && s->getState() != "UnMorphBalling" && canFall) {
-                            s->setState("Falling");
+                        if (!SamosStates::is(s->getState(), SamosStates::jump | SamosStates::morphTransition) && canFall) {
+                            s->setState(State::Falling);
                         }
                     } else {
-                        s->setFrictionFactor(static_cast<double>(samosJson["friction"]));
-                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosJson["jumpTimeMax"]) && s->getJumpTime() >= 0) {
-                            s->setVY(s->getVY() - (static_cast<double>(samosJson["jumpTimeMax"]) - s->getJumpTime()) * static_cast<double>(samosJson["postJumpBoost"]) / (frameRate * static_cast<double>(samosJson["jumpTimeMax"])));
+                        s->setFrictionFactor(static_cast<double>(samosType->friction));
+                        if (inputList["jump"] && s->getJumpTime() < static_cast<double>(samosTuning.jumpTimeMax) && s->getJumpTime() >= 0) {
+                            s->setVY(s->getVY() - (static_cast<double>(samosTuning.jumpTimeMax) - s->getJumpTime()) * static_cast<double>(samosTuning.postJumpBoost) / (frameRate * static_cast<double>(samosTuning.jumpTimeMax)));
                             s->setJumpTime(s->getJumpTime() + 1 / frameRate);
-                        } else if (s->getJumpTime() < static_cast<double>(samosJson["jumpTimeMax"]) && s->getJumpTime() >= 0){
-                            if (s->getVY() < -static_cast<double>(samosJson["jumpFall"]))
-                                s->setVY(-static_cast<double>(samosJson["jumpFall"]));
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                        } else if (s->getJumpTime() < static_cast<double>(samosTuning.jumpTimeMax) && s->getJumpTime() >= 0){
+                            if (s->getVY() < -static_cast<double>(samosTuning.jumpFall))
+                                s->setVY(-static_cast<double>(samosTuning.jumpFall));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         } else {
-                            s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                            s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
                         }
-                        if (s->getState() == "Jumping" && (!inputList["jump"] || s->getJumpTime() >= static_cast<double>(samosJson["jumpTimeMax"])))
-                                                s->setState("JumpEnd");
-                        if (s->getState() != "SpinJump" && s->getState() != "WallJump" && s->getState() != "Jumping" && s->getState() != "JumpEnd"
-                                && s->getState() != "MorphBalling" && s->getState() != "UnMorphBalling" && canFall) {
-                            s->setState("Falling");
+                        if (s->getState() == State::Jumping && (!inputList["jump"] || s->getJumpTime() >= static_cast<double>(samosTuning.jumpTimeMax)))
+                                                s->setState(State::JumpEnd);
+                        if (!SamosStates::is(s->getState(), SamosStates::jump | SamosStates::morphTransition) && canFall) {
+                            s->setState(State::Falling);
                         }
 
-                        if (std::abs(s->getVX()) < static_cast<double>(samosJson["slowcap"]))
+                        if (std::abs(s->getVX()) < static_cast<double>(samosTuning.slowcap))
                             s->setVX(0);
                     }
                 }
@@ -917,105 +896,54 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
         s->setDashCoolDown(s->getDashCoolDown() - 1 / frameRate);
     }
 
-    if (s->getShootTime() <= 0.0 && inputList["shoot"]) {
-        if (s->getState() == "Crouching" || s->getState() == "UnMorphBalling")
-            s->setState("IdleCrouch");
-        else if (s->getState() == "Uncrouching" || s->getState() == "Landing")
-            s->setState("Standing");
-        else if (s->getState() == "JumpEnd" || s->getState() == "Jumping" || s->getState() == "SpinJump" || s->getState() == "WallJump")
-            s->setState("Falling");
-        else if (s->getState() == "Walking")
-            s->setState("WalkingAimForward");
-    }
+    if (s->getShootTime() <= 0.0 && inputList["shoot"] && SamosStates::get(s->getState()).shootState != SamosStates::keepState)
+        s->setState(SamosStates::get(s->getState()).shootState);
 
-    if (s->getShootTime() > 0 && (s->getState() == "Walking" || s->getState() == "WalkingAimForward"))
-        s->setState("WalkingAimForward");
+    if (s->getShootTime() > 0 && (s->getState() == State::Walking || s->getState() == State::WalkingAimForward))
+        s->setState(State::WalkingAimForward);
 
 
-    if (canMorph && !canCrouch && !canStand && s->getOnGround() && s->getState() != "MorphBalling") {
-        s->setState("MorphBall");
+    if (canMorph && !canCrouch && !canStand && s->getOnGround() && s->getState() != State::MorphBalling) {
+        s->setState(State::MorphBall);
         s->setIsInAltForm(true);
     }
 
-    if (canMorph && !canCrouch && !canStand && !canSpin && !canFall && s->getState() != "MorphBalling") {
-        s->setState("MorphBall");
+    if (canMorph && !canCrouch && !canStand && !canSpin && !canFall && s->getState() != State::MorphBalling) {
+        s->setState(State::MorphBall);
         s->setIsInAltForm(true);
     }
 
-    std::string changedBox = "";
-    if (s->getState() == "SpinJump" || s->getState() == "WallJump") {
-        if ((*s->getBox()) != *spinBox) {
-            s->setBox(spinBox);
-            changedBox = "spin";
-        } else
-            delete spinBox;
-        delete morphBox;
-        delete fallBox;
-        delete crouchBox;
-        delete standBox;
-    } else if (s->getState() == "MorphBall" || s->getState() == "MorphBalling" || s->getState() == "MorphBallDash") {
-        if ((*s->getBox()) != *morphBox) {
-            s->setBox(morphBox);
-            changedBox = "morph";
-        } else
-            delete morphBox;
-        delete spinBox;
-        delete fallBox;
-        delete crouchBox;
-        delete standBox;
-    } else if (s->getState() == "Falling" || s->getState() == "FallingAimUp" || s->getState() == "FallingAimUpDiag" || s->getState() == "FallingAimDownDiag" || s->getState() == "FallingAimDown") {
-        if ((*s->getBox()) != *fallBox) {
-            s->setBox(fallBox);
-            changedBox = "fall";
-        } else
-            delete fallBox;
-        delete spinBox;
-        delete morphBox;
-        delete crouchBox;
-        delete standBox;
-    } else if (s->getState() == "IdleCrouch" || s->getState() == "CrouchAimUp" || s->getState() == "CrouchAimUpDiag" || s->getState() == "CrouchAimDownDiag" || s->getState() == "UnCrouching" || s->getState() == "Crouching" || s->getState() == "UnMorphBalling") {
-        if ((*s->getBox()) != *crouchBox) {
-            s->setBox(crouchBox);
-            changedBox = "crouch";
-        } else
-            delete crouchBox;
-        delete spinBox;
-        delete morphBox;
-        delete fallBox;
-        delete standBox;
-    } else {
-        if ((*s->getBox()) != *standBox) {
-            s->setBox(standBox);
-            changedBox = "stand";
-        } else
-            delete standBox;
-        delete spinBox;
-        delete morphBox;
-        delete fallBox;
-        delete crouchBox;
+    SamosStates::Stance stance = SamosStates::get(s->getState()).stance;
+    bool changedBox = false;
+    if ((*s->getBox()) != samosTuning.hitboxes[stance]) {
+        s->setBox(samosTuning.hitboxes[stance]);
+        changedBox = true;
     }
-    if (changedBox != "") {
-        s->setGroundBox(new CollisionBox(s->getBox()->getX(), s->getBox()->getY() + s->getBox()->getHeight(), s->getBox()->getWidth(), 1));
-        s->setWallBoxR(new CollisionBox(s->getBox()->getX() + s->getBox()->getWidth(), s->getBox()->getY(), 1, s->getBox()->getHeight()));
-        s->setWallBoxL(new CollisionBox(s->getBox()->getX() - 1, s->getBox()->getY(), 1, s->getBox()->getHeight()));
-        if ((freeCanSpin && changedBox == "spin") || (freeCanMorph && changedBox == "morph") || (freeCanFall && changedBox == "fall") || (freeCanCrouch && changedBox == "crouch") || (freeCanStand && changedBox == "stand")) {
-            for (std::vector<Terrain*>::iterator i = ts->begin(); i != ts->end(); i++) {
+    if (changedBox) {
+        s->setGroundBox(CollisionBox(s->getBox()->getX(), s->getBox()->getY() + s->getBox()->getHeight(), s->getBox()->getWidth(), 1));
+        s->setWallBoxR(CollisionBox(s->getBox()->getX() + s->getBox()->getWidth(), s->getBox()->getY(), 1, s->getBox()->getHeight()));
+        s->setWallBoxL(CollisionBox(s->getBox()->getX() - 1, s->getBox()->getY(), 1, s->getBox()->getHeight()));
+        // Only what the new hitbox can reach, as far as a replacement can push it
+        std::vector<Terrain*> nearTs = game->getCollisionGrid(EntityType::Terrain)->query<Terrain>(s, s->getBox(), stanceMargin);
+        std::vector<DynamicObj*> nearDs = game->getCollisionGrid(EntityType::DynamicObj)->query<DynamicObj>(s, s->getBox(), stanceMargin);
+        if (freeCanChange[stance]) {
+            for (std::vector<Terrain*>::iterator i = nearTs.begin(); i != nearTs.end(); i++) {
                 if (Entity::checkCollision(s, s->getBox(), *i, (*i)->getBox())) {
                     Entity::calcCollisionReplacement(s, *i);
                 }
             }
-            for (std::vector<DynamicObj*>::iterator i = ds->begin(); i != ds->end(); i++) {
+            for (std::vector<DynamicObj*>::iterator i = nearDs.begin(); i != nearDs.end(); i++) {
                 if (Entity::checkCollision(s, s->getBox(), *i, (*i)->getBox())) {
                     Entity::calcCollisionReplacement(s, *i);
                 }
             }
         } else {
-            for (std::vector<Terrain*>::iterator i = ts->begin(); i != ts->end(); i++) {
+            for (std::vector<Terrain*>::iterator i = nearTs.begin(); i != nearTs.end(); i++) {
                 if (Entity::checkCollision(s, s->getBox(), *i, (*i)->getBox())) {
                     Entity::calcCollisionReplacementAxis(s, *i, true);
                 }
             }
-            for (std::vector<DynamicObj*>::iterator i = ds->begin(); i != ds->end(); i++) {
+            for (std::vector<DynamicObj*>::iterator i = nearDs.begin(); i != nearDs.end(); i++) {
                 if (Entity::checkCollision(s, s->getBox(), *i, (*i)->getBox())) {
                     Entity::calcCollisionReplacementAxis(s, *i, true);
                 }
@@ -1025,7 +953,7 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
 
     bool wallJumpL = false;
     bool wallJumpR = false;
-    for (std::vector<Terrain*>::iterator i = ts->begin(); i != ts->end(); i++) {
+    for (std::vector<Terrain*>::const_iterator i = ts->begin(); i != ts->end(); i++) {
         if (Entity::checkCollision(s ,s->getWallBoxL(), *i, (*i)->getBox())) {
             wallJumpL = true;
         } else if (Entity::checkCollision(s, s->getWallBoxR(), *i, (*i)->getBox())) {
@@ -1044,44 +972,44 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
             break;
     }
 
-    if (!s->getOnGround() && !inputList["aim"] && !inputList["shoot"] && s->getShootTime() <= 0 && !s->getIsInAltForm() && s->getState() != "MorphBalling" && canSpin && s->getDashDirection() == "") {
-        std::string wallJump = "";
+    if (!s->getOnGround() && !inputList["aim"] && !inputList["shoot"] && s->getShootTime() <= 0 && !s->getIsInAltForm() && s->getState() != State::MorphBalling && canSpin && s->getDashDirection() == Facing::None) {
+        Facing wallJump = Facing::None;
 
         if (wallJumpL && !wallJumpR)
-            wallJump = "Left";
+            wallJump = Facing::Left;
         else if (!wallJumpL && wallJumpR)
-            wallJump = "Right";
+            wallJump = Facing::Right;
         else if (wallJumpL && wallJumpR) {
             if (inputList["right"])
-                wallJump = "Right";
+                wallJump = Facing::Right;
             else
-                wallJump = "Left";
+                wallJump = Facing::Left;
 
         }
 
 
-        if (wallJump == "Right" && (inputList["right"] || s->getState() == "WallJump" || s->getState() == "SpinJump")) {
-            s->setFacing("Left");
-            s->setState("WallJump");
+        if (wallJump == Facing::Right && (inputList["right"] || s->getState() == State::WallJump || s->getState() == State::SpinJump)) {
+            s->setFacing(Facing::Left);
+            s->setState(State::WallJump);
             if (!inputList["jump"])
                 s->setJumpTime(-1);
             if (s->getVY() > 0)
-                s->setVY(1 / ((1 / s->getVY()) + (static_cast<double>(samosJson["wallFriction"]) / frameRate)));
+                s->setVY(1 / ((1 / s->getVY()) + (static_cast<double>(samosTuning.wallFriction) / frameRate)));
             else if (s->getVY() < 0)
-                s->setVY(1 / ((1 / s->getVY()) - (static_cast<double>(samosJson["wallFriction"]) / frameRate)));
-        } else if (wallJump == "Left" && (inputList["left"] || s->getState() == "WallJump" || s->getState() == "SpinJump")) {
-            s->setFacing("Right");
-            s->setState("WallJump");
+                s->setVY(1 / ((1 / s->getVY()) - (static_cast<double>(samosTuning.wallFriction) / frameRate)));
+        } else if (wallJump == Facing::Left && (inputList["left"] || s->getState() == State::WallJump || s->getState() == State::SpinJump)) {
+            s->setFacing(Facing::Right);
+            s->setState(State::WallJump);
             if (!inputList["jump"])
                 s->setJumpTime(-1);
             if (s->getVY() > 0)
-                s->setVY(1 / ((1 / s->getVY()) + (static_cast<double>(samosJson["wallFriction"]) / frameRate)));
+                s->setVY(1 / ((1 / s->getVY()) + (static_cast<double>(samosTuning.wallFriction) / frameRate)));
             else if (s->getVY() < 0)
-                s->setVY(1 / ((1 / s->getVY()) - (static_cast<double>(samosJson["wallFriction"]) / frameRate)));
-        } else if (s->getState() == "WallJump") {
-            s->setState("SpinJump");
+                s->setVY(1 / ((1 / s->getVY()) - (static_cast<double>(samosTuning.wallFriction) / frameRate)));
+        } else if (s->getState() == State::WallJump) {
+            s->setState(State::SpinJump);
             if (s->getJumpTime() == -1)
-                s->setJumpTime(static_cast<double>(samosJson["jumpTimeMax"]));
+                s->setJumpTime(static_cast<double>(samosTuning.jumpTimeMax));
         }
     }
 
@@ -1096,180 +1024,24 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
             s->setRetainTime(s->getRetainTime() - 1 / frameRate);
         }
     }
-    if (s->getRetainTime() > -samosJson["speedRetainWallJumpBonusWindow"].get<double>())
+    if (s->getRetainTime() > -samosTuning.speedRetainWallJumpBonusWindow)
         s->setRetainTime(s->getRetainTime() - 1 / frameRate);
 
-    if (s->getState() == "IdleCrouch" || s->getState() == "CrouchAimUp" || s->getState() == "CrouchAimUpDiag" || s->getState() == "CrouchAimDownDiag") {
-        if (inputList["left"] && !inputList["right"]) {
-            s->setFacing("Left");
-            if (inputList["up"] && !inputList["down"]) {
-                s->setState("CrouchAimUpDiag");
-                s->setCanonDirection("UpLeft");
-            } else if (!inputList["up"] && inputList["down"]) {
-                s->setState("CrouchAimDownDiag");
-                s->setCanonDirection("DownLeft");
-            } else{
-                s->setState("IdleCrouch");
-                s->setCanonDirection("Left");
-            }
-        } else if (inputList["right"] && !inputList["left"]) {
-            s->setFacing("Right");
-            if (inputList["up"] && !inputList["down"]) {
-                s->setState("CrouchAimUpDiag");
-                s->setCanonDirection("UpRight");
-            } else if (!inputList["up"] && inputList["down"]) {
-                s->setState("CrouchAimDownDiag");
-                s->setCanonDirection("DownRight");
-            } else {
-                s->setState("IdleCrouch");
-                s->setCanonDirection("Right");
-            }
-        } else {
-            if (inputList["up"] && !inputList["down"]) {
-                s->setState("CrouchAimUp");
-                s->setCanonDirection("Up");
-            } else {
-                s->setState("IdleCrouch");
-                if (s->getFacing() == "Left")
-                    s->setCanonDirection("Left");
-                else
-                    s->setCanonDirection("Right");
-            }
-        }
-    } else if (s->getState() == "Standing" || s->getState() == "StandingAimUpDiag" || s->getState() == "StandingAimDownDiag" || s->getState() == "StandingAimUp") {
-        if (inputList["left"] && !inputList["right"]) {
-            s->setFacing("Left");
-            if (inputList["up"] && !inputList["down"]) {
-                s->setState("StandingAimUpDiag");
-                s->setCanonDirection("UpLeft");
-            } else if (inputList["down"] && !inputList["up"]) {
-                s->setState("StandingAimDownDiag");
-                s->setCanonDirection("DownLeft");
-            } else {
-                s->setState("Standing");
-                s->setCanonDirection("Left");
-            }
-        } else if (inputList["right"] && !inputList["left"]) {
-            s->setFacing("Right");
-            if (inputList["up"] && !inputList["down"]) {
-                s->setState("StandingAimUpDiag");
-                s->setCanonDirection("UpRight");
-            } else if (inputList["down"] && !inputList["up"]) {
-                s->setState("StandingAimDownDiag");
-                s->setCanonDirection("DownRight");
-            } else {
-                s->setState("Standing");
-                s->setCanonDirection("Right");
-            }
-        } else {
-            if (inputList["up"] && !inputList["down"]) {
-                s->setState("StandingAimUp");
-                s->setCanonDirection("Up");
-            } else {
-                s->setState("Standing");
-                if (s->getFacing() == "Left")
-                    s->setCanonDirection("Left");
-                else
-                    s->setCanonDirection("Right");
-            }
-        }
-    } else if (s->getState() == "Falling" || s->getState() == "FallingAimUpDiag" || s->getState() == "FallingAimDownDiag" || s->getState() == "FallingAimUp" || s->getState() == "FallingAimDown") {
-        if (inputList["left"] && !inputList["right"]) {
-            s->setFacing("Left");
-            if (inputList["up"] && !inputList["down"]) {
-                s->setState("FallingAimUpDiag");
-                s->setCanonDirection("UpLeft");
-            } else if (inputList["down"] && !inputList["up"]) {
-                s->setState("FallingAimDownDiag");
-                s->setCanonDirection("DownLeft");
-            } else {
-                s->setState("Falling");
-                s->setCanonDirection("Left");
-            }
-        } else if (inputList["right"] && !inputList["left"]) {
-            s->setFacing("Right");
-            if (inputList["up"] && !inputList["down"]) {
-                s->setState("FallingAimUpDiag");
-                s->setCanonDirection("UpRight");
-            } else if (inputList["down"] && !inputList["up"]) {
-                s->setState("FallingAimDownDiag");
-                s->setCanonDirection("DownRight");
-            } else {
-                s->setState("Falling");
-                s->setCanonDirection("Right");
-            }
-        } else {
-            if (inputList["up"] && !inputList["down"]) {
-                s->setState("FallingAimUp");
-                s->setCanonDirection("Up");
-            } else if (inputList["down"] && !inputList["up"]) {
-                s->setState("FallingAimDown");
-                s->setCanonDirection("Down");
-            } else {
-                s->setState("Falling");
-                if (s->getFacing() == "Left")
-                    s->setCanonDirection("Left");
-                else
-                    s->setCanonDirection("Right");
-            }
-        }
-    } else if (s->getState() == "Walking" || s->getState() == "WalkingAimForward") {
-        if (s->getFacing() == "Left")
-            s->setCanonDirection("Left");
-        else
-            s->setCanonDirection("Right");
-    } else if (s->getState() == "WalkingAimUp") {
-        if (s->getFacing() == "Left")
-            s->setCanonDirection("UpLeft");
-        else
-            s->setCanonDirection("UpRight");
-    } else if (s->getState() == "WalkingAimDown") {
-        if (s->getFacing() == "Left")
-            s->setCanonDirection("DownLeft");
-        else
-            s->setCanonDirection("DownRight");
-    } else if (s->getState() == "MorphBall" || s->getState() == "MorphBalling" || s->getState() == "UnMorphBalling") {
-        if (s->getFacing() == "Left")
-            s->setCanonDirection("Left");
-        else
-            s->setCanonDirection("Right");
-    } else if (s->getState() == "SpinJump" || s->getState() == "WallJump" || s->getState() == "Jumping" || s->getState() == "JumpEnd") {
-        if (inputList["left"] && !inputList["right"]) {
-            if (inputList["up"] && !inputList["down"]) {
-                s->setCanonDirection("UpLeft");
-            } else if (inputList["down"] && !inputList["up"]) {
-                s->setCanonDirection("DownLeft");
-            } else {
-                s->setCanonDirection("Left");
-            }
-        } else if (inputList["right"] && !inputList["left"]) {
-            if (inputList["up"] && !inputList["down"]) {
-                s->setCanonDirection("UpRight");
-            } else if (inputList["down"] && !inputList["up"]) {
-                s->setCanonDirection("DownRight");
-            } else {
-                s->setCanonDirection("Right");
-            }
-        } else {
-            if (inputList["up"] && !inputList["down"]) {
-                s->setCanonDirection("Up");
-            } else if (inputList["down"] && !inputList["up"]) {
-                s->setCanonDirection("Down");
-            } else {
-                if (s->getFacing() == "Left")
-                    s->setCanonDirection("Left");
-                else
-                    s->setCanonDirection("Right");
-            }
-        }
+    const SamosStates::Aim *aim = SamosStates::aim(s->getState(), SamosStates::inputMask(inputList["left"], inputList["right"], inputList["up"], inputList["down"]));
+    if (aim != nullptr) {
+        if (aim->facing != Facing::None)
+            s->setFacing(aim->facing);
+        if (aim->state != SamosStates::keepState)
+            s->setState(aim->state);
+        s->setCanonDirection(s->getFacing() == Facing::Left ? aim->canonLeft : aim->canonRight);
     }
 
     if (inputList["weapon"]) {
         if (s->getSwitchDelay() == 0.0) {
             s->nextWeapon();
-        } else if (s->getSwitchDelay() >= 3 * static_cast<double>(samosJson["switchDelay"]) || (s->getSwitchDelay() >= -1 && s->getSwitchDelay() < 0.0)) {
+        } else if (s->getSwitchDelay() >= 3 * static_cast<double>(samosTuning.switchDelay) || (s->getSwitchDelay() >= -1 && s->getSwitchDelay() < 0.0)) {
             s->nextWeapon();
-            s->setSwitchDelay(-1 - static_cast<double>(samosJson["switchDelay"]));
+            s->setSwitchDelay(-1 - static_cast<double>(samosTuning.switchDelay));
         }
 
         s->setSwitchDelay(s->getSwitchDelay() + 1 / frameRate);
@@ -1277,18 +1049,18 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
     } else
         s->setSwitchDelay(0.0);
 
-    if (s->getShootTime() <= 0.0 && inputList["shoot"] && inputTime["shoot"] == 0.0 && s->getDashDirection() == "") {
+    if (s->getShootTime() <= 0.0 && inputList["shoot"] && inputTime["shoot"] == 0.0 && s->getDashDirection() == Facing::None) {
         Projectile* p = nullptr;
         if (s->getIsInAltForm())
             p = s->shoot("Bomb");
-        else if (s->getState() != "MorphBalling")
+        else if (s->getState() != State::MorphBalling)
             p = s->shoot(s->getSelectedWeapon());
         if (p != nullptr) {
             p->setX(p->getX() + s->getVX() / frameRate);
             p->setY(p->getY() + s->getVY() / frameRate);
 
             toAdd.push_back(p);
-            s->setShootTime(static_cast<double>(samosJson["shootTime"]));
+            s->setShootTime(static_cast<double>(samosTuning.shootTime));
         }
     }
 
@@ -1297,76 +1069,69 @@ std::vector<Entity*> Physics::updateSamos(Game* game)
     else
         s->setFastFalling(false);
 
-    if (s->getState() == "MorphBall") {
+    if (s->getState() == State::MorphBall) {
         if (std::abs(s->getVX()) < 1)
-            s->setState("MorphBallStop");
+            s->setState(State::MorphBallStop);
         else if (std::abs(s->getVX()) < 100)
-            s->setState("MorphBallSuperSlow");
+            s->setState(State::MorphBallSuperSlow);
         else if (std::abs(s->getVX()) < 200)
-            s->setState("MorphBallSlow");
+            s->setState(State::MorphBallSlow);
     }
     if (std::abs(s->getVX()) > 500) {
 
-        if (s->getFrictionFactor() == samosJson["friction"].get<double>())
-            s->setFrictionFactor(samosJson["fastFriction"].get<double>());
+        if (s->getFrictionFactor() == samosType->friction)
+            s->setFrictionFactor(samosTuning.fastFriction);
 
-        if (s->getFrictionFactor() == samosJson["movingFriction"].get<double>())
-            s->setFrictionFactor(samosJson["movingFastFriction"].get<double>());
+        if (s->getFrictionFactor() == samosTuning.movingFriction)
+            s->setFrictionFactor(samosTuning.movingFastFriction);
 
         if (std::abs(s->getVX()) > 1000) {
-            if (s->getState() == "Walking")
-                s->setState("Running");
-            else if (s->getState() == "WalkingAimForward")
-                s->setState("RunningAimForward");
-            else if (s->getState() == "WalkingAimUp")
-                s->setState("RunningAimUp");
-            else if (s->getState() == "WalkingAimDown")
-                s->setState("RunningAimDown");
-
-            if (s->getFrictionFactor() == samosJson["fastFriction"].get<double>())
-                s->setFrictionFactor(samosJson["superFastFriction"].get<double>());
-
-            if (s->getFrictionFactor() == samosJson["movingFastFriction"].get<double>())
-                s->setFrictionFactor(samosJson["movingSuperFastFriction"].get<double>());
+            if (SamosStates::get(s->getState()).runState != SamosStates::keepState)
+                s->setState(SamosStates::get(s->getState()).runState);
+
+            if (s->getFrictionFactor() == samosTuning.fastFriction)
+                s->setFrictionFactor(samosTuning.superFastFriction);
+
+            if (s->getFrictionFactor() == samosTuning.movingFastFriction)
+                s->setFrictionFactor(samosTuning.movingSuperFastFriction);
         }
     }
 
-    if (inputList["run"] && s->getFrictionFactor() == samosJson["movingFriction"].get<double>())
-        s->setFrictionFactor(samosJson["movingFastFriction"].get<double>());
+    if (inputList["run"] && s->getFrictionFactor() == samosTuning.movingFriction)
+        s->setFrictionFactor(samosTuning.movingFastFriction);
 
     return toAdd;
 }
 
-std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> Physics::updatePhysics(Game* game)
+PhysicsStepResult Physics::updatePhysics(Game* game)
 {
     Samos *s = game->getS();
-    std::vector<Terrain*> *ts = game->getTerrains();
     std::vector<DynamicObj*> *ds = game->getDynamicObjs();
     std::vector<Monster*> *ms = game->getMonsters();
     std::vector<Area*> *as = game->getAreas();
     std::vector<NPC*> *ns = game->getNPCs();
     std::vector<Projectile*> *ps = game->getProjectiles();
-    Map currentMap = game->getCurrentMap();
-    Save currentProgress = game->getCurrentProgress();
+    SpatialGrid *terrainGrid = game->getCollisionGrid(EntityType::Terrain);
+    SpatialGrid *monsterGrid = game->getCollisionGrid(EntityType::Monster);
+    SpatialGrid *dynamicObjGrid = game->getCollisionGrid(EntityType::DynamicObj);
+    SpatialGrid *areaGrid = game->getCollisionGrid(EntityType::Area);
+    SpatialGrid *projectileGrid = game->getCollisionGrid(EntityType::Projectile);
+    Map &currentMap = game->getCurrentMap();
 
-    std::string doorTransition = "";
+    PhysicsStepResult result;
 
     //Physics settings
-    nlohmann::json paramJson = Entity::values["general"];
+    const nlohmann::json &paramJson = Entity::values["general"];
     double speedcap = static_cast<double>(paramJson["speedcap"]);
     double fallcap = static_cast<double>(paramJson["fallcap"]);
     double slowcap = static_cast<double>(paramJson["slowcap"]);
-    //Deletion list
-    std::vector<Entity*> toDel;
 
-    nlohmann::json mapJson = (*currentMap.getJson())["rooms"][currentMap.getCurrentRoomId()];
+    const RoomInfo &room = currentMap.getCurrentRoomInfo();
 
-    int roomS_x = mapJson["position"][0];
-    int roomS_y = mapJson["position"][1];
-    int roomE_x = mapJson["size"][0];
-    int roomE_y = mapJson["size"][1];
-    roomE_x += roomS_x;
-    roomE_y += roomS_y;
+    int roomS_x = room.x;
+    int roomS_y = room.y;
+    int roomE_x = room.x + room.width;
+    int roomE_y = room.y + room.height;
 
     double groundFriction = paramJson["groundFriction"];
     double airFriction = paramJson["airFriction"];
@@ -1421,8 +1186,8 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
 
     for (std::vector<Monster*>::iterator m = ms->begin(); m != ms->end(); m++) {
 
-        if ((*m)->getState() == "Death" && (*m)->getFrame() == (static_cast<unsigned int>(Entity::values["textures"][Entity::values["names"][(*m)->getName()]["texture"]]["Death"]["count"]) - 1)) {
-            toDel.push_back(*m);
+        if ((*m)->getState() == State::Death && (*m)->getFrame() == ((*m)->getArchetype()->getClip(State::Death).count - 1)) {
+            result.dead.push_back(*m);
             continue;
         }
 
@@ -1484,8 +1249,8 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
 
     for (std::vector<NPC*>::iterator n = ns->begin(); n != ns->end(); n++) {
 
-        if ((*n)->getState() == "Death" && (*n)->getFrame() == (static_cast<unsigned int>(Entity::values["textures"][Entity::values["names"][(*n)->getName()]["texture"]]["Death"]["count"]) - 1)) {
-            toDel.push_back(*n);
+        if ((*n)->getState() == State::Death && (*n)->getFrame() == ((*n)->getArchetype()->getClip(State::Death).count - 1)) {
+            result.dead.push_back(*n);
             continue;
         }
         //I-frames
@@ -1546,8 +1311,8 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
 
     for (std::vector<DynamicObj*>::iterator d = ds->begin(); d != ds->end(); d++) {
 
-        if ((*d)->getState() == "Death" && (*d)->getFrame() == (static_cast<unsigned int>(Entity::values["textures"][Entity::values["names"][(*d)->getName()]["texture"]]["Death"]["count"]) - 1)) {
-            toDel.push_back(*d);
+        if ((*d)->getState() == State::Death && (*d)->getFrame() == ((*d)->getArchetype()->getClip(State::Death).count - 1)) {
+            result.dead.push_back(*d);
             continue;
         }
 
@@ -1673,89 +1438,91 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
                     (*p)->setVX(-speedcap);
             }
             //Move entities
-            if ((*p)->getLifeTime() != Entity::values["names"][(*p)->getName()]["lifeTime"])
+            if ((*p)->getLifeTime() != (*p)->getArchetype()->lifeTime)
                 (*p)->updateV(frameRate);
 
             if (updateProjectile(*p))
-                toDel.push_back(*p);
+                result.dead.push_back(*p);
         }
     }
 
-    std::vector<Entity*> toAdd;
+
+    // Entities moved during integration: update their position in the broadphase
+    game->updateCollisionGrids();
 
      // SAMOS
 
     if (s != nullptr) {
-        for (std::vector<Terrain*>::iterator j = ts->begin(); j != ts->end(); j++) {
+        std::vector<Terrain*> nearTs = terrainGrid->query<Terrain>(s, s->getBox(), queryMargin(s));
+        for (std::vector<Terrain*>::iterator j = nearTs.begin(); j != nearTs.end(); j++) {
             if (Entity::checkCollision(s, s->getBox(), *j, (*j)->getBox())) {
                 double prevVX = s->getVX();
                 Entity::calcCollisionReplacement(s, *j);
                 if (prevVX != s->getVX()) {
                     s->setSpeedRetained(prevVX);
-                    s->setRetainTime(Entity::values["names"]["Samos"]["speedRetainWindow"].get<double>());
+                    s->setRetainTime(s->getArchetype()->samos.speedRetainWindow);
                 }
             }
         }
-        for (std::vector<Monster*>::iterator j = ms->begin(); j != ms->end(); j++) {
+        std::vector<Monster*> nearMs = monsterGrid->query<Monster>(s, s->getBox(), queryMargin(s));
+        for (std::vector<Monster*>::iterator j = nearMs.begin(); j != nearMs.end(); j++) {
             if (Entity::checkCollision(s, s->getBox(), *j, (*j)->getBox())) {
                 Entity::calcCollisionReplacement(s, *j);
                 if (s->getITime() <= 0.0) {
                     int prevHp = s->getHealth();
-                    s->hit((*j)->getDamage(), *j, Entity::values["names"][s->getName()]["contactKB"], true);
-                    s->setLagTime(Entity::values["names"][s->getName()]["lagTime"]);
+                    s->hit((*j)->getDamage(), *j, s->getArchetype()->samos.contactKB, true);
+                    s->setLagTime(s->getArchetype()->samos.lagTime);
                     if (s->getHealth() != prevHp)
-                        currentProgress.addDamageReceived(prevHp - s->getHealth());
+                        result.damageReceived += prevHp - s->getHealth();
                 }
                 if (s->getLagTime() <= 0.0) {
-                    s->hit(0, *j, Entity::values["names"][s->getName()]["contactKB"], true);
-                    s->setLagTime(Entity::values["names"][s->getName()]["lagTime"]);
+                    s->hit(0, *j, s->getArchetype()->samos.contactKB, true);
+                    s->setLagTime(s->getArchetype()->samos.lagTime);
                 }
                 s->setDashTime(0.0);
             }
         }
-        for (std::vector<DynamicObj*>::iterator j = ds->begin(); j != ds->end(); j++) {
+        std::vector<DynamicObj*> nearDs = dynamicObjGrid->query<DynamicObj>(s, s->getBox(), queryMargin(s));
+        for (std::vector<DynamicObj*>::iterator j = nearDs.begin(); j != nearDs.end(); j++) {
             if (Entity::checkCollision(s, s->getBox(), *j, (*j)->getBox())) {
                 double prevVX = s->getVX();
                 Entity::calcCollisionReplacement(s, *j);
                 if (prevVX != s->getVX()) {
                     s->setSpeedRetained(prevVX);
-                    s->setRetainTime(Entity::values["names"]["Samos"]["speedRetainWindow"].get<double>());
+                    s->setRetainTime(s->getArchetype()->samos.speedRetainWindow);
                 }
             }
         }
-        for (std::vector<Area*>::iterator j = as->begin(); j != as->end(); j++) {
+        std::vector<Area*> nearAs = areaGrid->query<Area>(s, s->getBox());
+        for (std::vector<Area*>::iterator j = nearAs.begin(); j != nearAs.end(); j++) {
             if (Entity::checkCollision(s, s->getBox(), *j, (*j)->getBox())) {
                 if ((*j)->getAreaType() == "Door") {
                     Door* d = static_cast<Door*>(*j);
-                    currentMap.setCurrentRoomId(d->getEndingRoom());
-                    if (d->getState().find("Right") != std::string::npos)
-                        doorTransition = "Right";
-                    else if (d->getState().find("Left") != std::string::npos)
-                        doorTransition = "Left";
-                    else if (d->getState().find("Up") != std::string::npos)
-                        doorTransition = "Up";
-                    else if (d->getState().find("Down") != std::string::npos)
-                        doorTransition = "Down";
-                    // If the new room isn't loaded yet
-                    if (game->getRoomEntities()[currentMap.getCurrentRoomId()] == nullptr) {
-                        // Load it
-                        for (Entity* ent : currentMap.loadRoom())
-                            toAdd.push_back(ent);
-                    } else
-                        for (Entity* ent : *game->getRoomEntities()[currentMap.getCurrentRoomId()])
-                            toAdd.push_back(ent);
+                    result.enteredRoomId = d->getEndingRoom();
+                    if (d->getStateName().find("Right") != std::string::npos)
+                        result.doorTransition = "Right";
+                    else if (d->getStateName().find("Left") != std::string::npos)
+                        result.doorTransition = "Left";
+                    else if (d->getStateName().find("Up") != std::string::npos)
+                        result.doorTransition = "Up";
+                    else if (d->getStateName().find("Down") != std::string::npos)
+                        result.doorTransition = "Down";
+                    // Loaded on the spot if the streamer hasn't brought it yet, and kept track of so that it isn't loaded a second time after the transition
+                    const std::vector<Entity*> &entered = game->enterRoom(result.enteredRoomId);
+                    result.spawned.insert(result.spawned.end(), entered.begin(), entered.end());
                 }
             }
         }
-        for (std::vector<Projectile*>::iterator j = ps->begin(); j != ps->end(); j++) {
+        std::vector<Projectile*> nearPs = projectileGrid->query<Projectile>(s, s->getBox());
+        for (std::vector<Projectile*>::iterator j = nearPs.begin(); j != nearPs.end(); j++) {
             if (Entity::checkCollision(s, s->getBox(), *j, (*j)->getBox())) {
                 int prevHp = s->getHealth();
                 (*j)->hitting(s);
                 if (s->getHealth() != prevHp) {
                     s->setDashTime(0.0);
-                    currentProgress.addDamageReceived(prevHp - s->getHealth());
-                    if ((*j)->getOwnerType() == "Samos")
-                        currentProgress.addDamageDone(prevHp - s->getHealth());
+                    result.damageReceived += prevHp - s->getHealth();
+                    if ((*j)->getOwnerType() == EntityType::Samos)
+                        result.damageDone += prevHp - s->getHealth();
                 }
             }
         }
@@ -1773,36 +1540,43 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
         }
     }
 
+    // Samos may have pushed monsters or dynamic objects around
+    game->updateCollisionGrids();
+
     // MONSTER
 
     for (std::vector<Monster*>::iterator i = ms->begin(); i != ms->end(); i++) {
-        for (std::vector<Terrain*>::iterator j = ts->begin(); j != ts->end(); j++) {
+        std::vector<Terrain*> nearTs = terrainGrid->query<Terrain>(*i, (*i)->getBox(), queryMargin(*i));
+        for (std::vector<Terrain*>::iterator j = nearTs.begin(); j != nearTs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getBox(), *j, (*j)->getBox())) {
                 Entity::calcCollisionReplacement(*i, *j);
             }
         }
-        for (std::vector<DynamicObj*>::iterator j = ds->begin(); j != ds->end(); j++) {
+        std::vector<DynamicObj*> nearDs = dynamicObjGrid->query<DynamicObj>(*i, (*i)->getBox(), queryMargin(*i));
+        for (std::vector<DynamicObj*>::iterator j = nearDs.begin(); j != nearDs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getBox(), *j, (*j)->getBox())) {
                 Entity::calcCollisionReplacement(*i, *j);
+                dynamicObjGrid->update(*j);
             }
         }
-        for (std::vector<Projectile*>::iterator j = ps->begin(); j != ps->end(); j++) {
+        std::vector<Projectile*> nearPs = projectileGrid->query<Projectile>(*i, (*i)->getBox());
+        for (std::vector<Projectile*>::iterator j = nearPs.begin(); j != nearPs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getBox(), *j, (*j)->getBox())) {
                 int prevHp = (*i)->getHealth();
                 if ((*j)->hitting(*i)) {
-                    (*i)->setBox(nullptr);
-                    (*i)->setState("Death");
+                    (*i)->removeBox();
+                    (*i)->setState(State::Death);
                     (*i)->setIsMovable(false);
                     (*i)->setHealth(0);
                     if ((*i)->getHealth() != prevHp) {
-                        if ((*j)->getOwnerType() == "Samos")
-                            currentProgress.addDamageDone(prevHp - (*i)->getHealth());
+                        if ((*j)->getOwnerType() == EntityType::Samos)
+                            result.damageDone += prevHp - (*i)->getHealth();
                     }
                     break;
                 }
                 if ((*i)->getHealth() != prevHp) {
-                    if ((*j)->getOwnerType() == "Samos")
-                        currentProgress.addDamageDone(prevHp - (*i)->getHealth());
+                    if ((*j)->getOwnerType() == EntityType::Samos)
+                        result.damageDone += prevHp - (*i)->getHealth();
                 }
             }
         }
@@ -1822,26 +1596,34 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
                 (*i)->setVY(0.0);
             }
         }
+        monsterGrid->update(*i);
     }
 
     // DYNAMICOBJ
 
     for (std::vector<DynamicObj*>::iterator i = ds->begin(); i != ds->end(); i++) {
-        for (std::vector<Terrain*>::iterator j = ts->begin(); j != ts->end(); j++) {
+        std::vector<Terrain*> nearTs = terrainGrid->query<Terrain>(*i, (*i)->getBox(), queryMargin(*i));
+        for (std::vector<Terrain*>::iterator j = nearTs.begin(); j != nearTs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getBox(), *j, (*j)->getBox())) {
                 Entity::calcCollisionReplacement(*i, *j);
             }
         }
-        for (std::vector<DynamicObj*>::iterator j = i + 1; j != ds->end(); j++) {
+        std::vector<DynamicObj*> nearDs = dynamicObjGrid->query<DynamicObj>(*i, (*i)->getBox(), queryMargin(*i));
+        for (std::vector<DynamicObj*>::iterator j = nearDs.begin(); j != nearDs.end(); j++) {
+            // Each pair is only resolved once
+            if ((*j)->getEntityID() < (*i)->getEntityID())
+                continue;
             if (Entity::checkCollision(*i, (*i)->getBox(), *j, (*j)->getBox())) {
                 Entity::calcCollisionReplacement(*i, *j);
+                dynamicObjGrid->update(*j);
             }
         }
-        for (std::vector<Projectile*>::iterator j = ps->begin(); j != ps->end(); j++) {
+        std::vector<Projectile*> nearPs = projectileGrid->query<Projectile>(*i, (*i)->getBox());
+        for (std::vector<Projectile*>::iterator j = nearPs.begin(); j != nearPs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getBox(), *j, (*j)->getBox())) {
                 if ((*j)->hitting(*i)) {
-                    (*i)->setBox(nullptr);
-                    (*i)->setState("Death");
+                    (*i)->removeBox();
+                    (*i)->setState(State::Death);
                     (*i)->setIsMovable(false);
                     (*i)->setHealth(0);
                     break;
@@ -1864,12 +1646,14 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
                 (*i)->setVY(0.0);
             }
         }
+        dynamicObjGrid->update(*i);
     }
 
     // NPC
 
     for (std::vector<NPC*>::iterator i = ns->begin(); i != ns->end(); i++) {
-        for (std::vector<Terrain*>::iterator j = ts->begin(); j != ts->end(); j++) {
+        std::vector<Terrain*> nearTs = terrainGrid->query<Terrain>(*i, (*i)->getBox(), queryMargin(*i));
+        for (std::vector<Terrain*>::iterator j = nearTs.begin(); j != nearTs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getBox(), *j, (*j)->getBox())) {
                 Entity::calcCollisionReplacement(*i, *j);
             }
@@ -1895,7 +1679,8 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
     //PROJECTILES
 
     for (std::vector<Projectile*>::iterator i = ps->begin(); i != ps->end(); i++) {
-        for (std::vector<Terrain*>::iterator j = ts->begin(); j != ts->end(); j++) {
+        std::vector<Terrain*> nearTs = terrainGrid->query<Terrain>(*i, (*i)->getBox());
+        for (std::vector<Terrain*>::iterator j = nearTs.begin(); j != nearTs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getBox(), *j, (*j)->getBox())) {
                 (*i)->hitting(*j);
             }
@@ -1922,18 +1707,23 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
         }
     }
 
+    // Final positions of this frame
+    game->updateCollisionGrids();
+
     //Update the grounded state of livings
     if (s != nullptr) {
         bool prevOnGround = s->getOnGround();
         s->setOnGround(false);
-        for (std::vector<Terrain*>::iterator j = ts->begin(); j!= ts->end(); j++) {
+        std::vector<Terrain*> nearTs = terrainGrid->query<Terrain>(s, s->getGroundBox());
+        for (std::vector<Terrain*>::iterator j = nearTs.begin(); j!= nearTs.end(); j++) {
             if (Entity::checkCollision(s, s->getGroundBox(), *j, (*j)->getBox())) {
                 s->setStandingOn(*j);
                 s->setOnGround(true);
                 break;
             }
         }
-        for (std::vector<DynamicObj*>::iterator j = ds->begin(); j!= ds->end(); j++) {
+        std::vector<DynamicObj*> nearDs = dynamicObjGrid->query<DynamicObj>(s, s->getGroundBox());
+        for (std::vector<DynamicObj*>::iterator j = nearDs.begin(); j!= nearDs.end(); j++) {
             if (Entity::checkCollision(s, s->getGroundBox(), *j, (*j)->getBox())) {
                 s->setStandingOn(*j);
                 s->setOnGround(true);
@@ -1951,14 +1741,16 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
 
     for (std::vector<Monster*>::iterator i = ms->begin(); i != ms->end(); i++) {
         (*i)->setOnGround(false);
-        for (std::vector<Terrain*>::iterator j = ts->begin(); j!= ts->end(); j++) {
+        std::vector<Terrain*> nearTs = terrainGrid->query<Terrain>(*i, (*i)->getGroundBox());
+        for (std::vector<Terrain*>::iterator j = nearTs.begin(); j!= nearTs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getGroundBox(), *j, (*j)->getBox())) {
                 (*i)->setStandingOn(*j);
                 (*i)->setOnGround(true);
                 break;
             }
         }
-        for (std::vector<DynamicObj*>::iterator j = ds->begin(); j!= ds->end(); j++) {
+        std::vector<DynamicObj*> nearDs = dynamicObjGrid->query<DynamicObj>(*i, (*i)->getGroundBox());
+        for (std::vector<DynamicObj*>::iterator j = nearDs.begin(); j!= nearDs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getGroundBox(), *j, (*j)->getBox())) {
                 (*i)->setStandingOn(*j);
                 (*i)->setOnGround(true);
@@ -1973,14 +1765,16 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
 
     for (std::vector<NPC*>::iterator i = ns->begin(); i != ns->end(); i++) {
         (*i)->setOnGround(false);
-        for (std::vector<Terrain*>::iterator j = ts->begin(); j!= ts->end(); j++) {
+        std::vector<Terrain*> nearTs = terrainGrid->query<Terrain>(*i, (*i)->getGroundBox());
+        for (std::vector<Terrain*>::iterator j = nearTs.begin(); j!= nearTs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getGroundBox(), *j, (*j)->getBox())) {
                 (*i)->setStandingOn(*j);
                 (*i)->setOnGround(true);
                 break;
             }
         }
-        for (std::vector<DynamicObj*>::iterator j = ds->begin(); j!= ds->end(); j++) {
+        std::vector<DynamicObj*> nearDs = dynamicObjGrid->query<DynamicObj>(*i, (*i)->getGroundBox());
+        for (std::vector<DynamicObj*>::iterator j = nearDs.begin(); j!= nearDs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getGroundBox(), *j, (*j)->getBox())) {
                 (*i)->setStandingOn(*j);
                 (*i)->setOnGround(true);
@@ -1995,14 +1789,16 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
 
     for (std::vector<DynamicObj*>::iterator i = ds->begin(); i != ds->end(); i++) {
         (*i)->setOnGround(false);
-        for (std::vector<Terrain*>::iterator j = ts->begin(); j!= ts->end(); j++) {
+        std::vector<Terrain*> nearTs = terrainGrid->query<Terrain>(*i, (*i)->getGroundBox());
+        for (std::vector<Terrain*>::iterator j = nearTs.begin(); j!= nearTs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getGroundBox(), *j, (*j)->getBox())) {
                 (*i)->setStandingOn(*j);
                 (*i)->setOnGround(true);
                 break;
             }
         }
-        for (std::vector<DynamicObj*>::iterator j = ds->begin(); j!= ds->end(); j++) {
+        std::vector<DynamicObj*> nearDs = dynamicObjGrid->query<DynamicObj>(*i, (*i)->getGroundBox());
+        for (std::vector<DynamicObj*>::iterator j = nearDs.begin(); j!= nearDs.end(); j++) {
             if (Entity::checkCollision(*i, (*i)->getGroundBox(), *j, (*j)->getBox())) {
                 (*i)->setStandingOn(*j);
                 (*i)->setOnGround(true);
@@ -2015,5 +1811,5 @@ std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> P
             (*i)->setOnGround(true);
     }
 
-    return std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save>(doorTransition, toAdd, toDel, currentMap, currentProgress);
+    return result;
 }
@@ -9,20 +9,43 @@
 #include "Entities/terrain.h"
 #include "game.h"
 #include "map.h"
+#include "physicsstepresult.h"
 #include "save.h"
+#include "spatialgrid.h"
 
 class Physics
 {
 public:
+    // Plain rectangle, to ask about a box no entity has yet. Kept as a position plus an offset
+    // so that the arithmetic is done in the same order as for the entities, to the last bit
+    struct Rect {
+        double x = 0; // in px
+        double y = 0; // in px
+        int offsetX = 0; // in px
+        int offsetY = 0; // in px
+        int width = 0; // in px
+        int height = 0; // in px
+    };
+
     static double gravity; //p.s^-2
     static double frameRate; //fps
 
-    static std::tuple<std::string, std::vector<Entity*>, std::vector<Entity*>, Map, Save> updatePhysics(Game* game);
+    static PhysicsStepResult updatePhysics(Game* game); // Steps every entity, and returns what Game has to apply afterwards
     static std::vector<Entity*> handleCollision(Entity* obj1, Entity* obj2);
     static bool updateProjectile(Projectile* p);
-    static bool canChangeBox(Entity *e, CollisionBox *b, std::vector<Terrain*> *ts, std::vector<DynamicObj*> *ds, std::pair<int, int> roomS, std::pair<int, int> roomE);
-    static bool canChangeBoxAxis(Entity *e, CollisionBox *b, std::vector<Terrain*> *ts, std::vector<DynamicObj*> *ds, std::pair<int, int> roomS, std::pair<int, int> roomE, bool alongY);
+    static Rect boxAt(Entity* e, CollisionBox* box); // 'box' placed at 'e''s position
+    static bool overlapBox(const Rect &r, Entity* collider);
+    static bool overlapBox(const Rect &r, const std::vector<Entity*> &colliders); // True if any collider overlaps 'r'
+    // Moves 'r' out of the colliders like an entity would be, without touching them
+    static void resolveBox(Rect &r, const std::vector<Entity*> &colliders);
+    static void resolveBoxAxis(Rect &r, const std::vector<Entity*> &colliders, bool alongY);
+    // Whether 'r' can be pushed out of the colliders (only vertically if 'alongY') and stay inside the room
+    static bool fitsAt(Rect r, const std::vector<Entity*> &colliders, std::pair<int, int> roomS, std::pair<int, int> roomE, bool alongY);
     static std::vector<Entity*> updateSamos(Game* game);
+    static double queryMargin(Entity* e); // Broadphase margin needed by an entity resolving its collisions
+
+private:
+    static std::vector<Entity*> stanceColliders; // Reused every frame by the Samos stance probes
 };
 
 #endif // PHYSICS_H
@@ -0,0 +1,21 @@
+#ifndef PHYSICSSTEPRESULT_H
+#define PHYSICSSTEPRESULT_H
+
+#include "Entities/entity.h"
+
+#include <string>
+#include <vector>
+
+// Everything a physics step wants to change outside of the entities themselves.
+// The physics only records it, Game::applyPhysicsStep then applies it in place
+struct PhysicsStepResult
+{
+    std::string doorTransition = ""; // Direction of the door transition to start, empty if none
+    std::string enteredRoomId = ""; // Room the door leads to, empty if no door was entered
+    std::vector<Entity*> spawned; // Entities to add to the game
+    std::vector<Entity*> dead; // Entities to remove from the game and delete
+    int damageDone = 0; // Damage dealt by Samos this step
+    int damageReceived = 0; // Damage received by Samos this step
+};
+
+#endif // PHYSICSSTEPRESULT_H
@@ -0,0 +1,21 @@
+#include "renderframe.h"
+
+void RenderFrame::clear()
+{
+    textures.clear();
+    sprites.clear();
+    hitboxes.clear();
+    menuOptions.clear();
+    mapRooms.clear();
+    mapDoors.clear();
+    debugInfo.loadedRooms.clear();
+    debugInfo.loadingRooms.clear();
+    debugInfo.unloadingRooms.clear();
+    debugInfo.cachedRooms.clear();
+    showFps = false;
+    showHud = false;
+    inDialogue = false;
+    isPaused = false;
+    showMinimos = false;
+    showDebugInfo = false;
+}
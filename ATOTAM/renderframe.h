@@ -0,0 +1,127 @@
+#ifndef RENDERFRAME_H
+#define RENDERFRAME_H
+
+#include <QColor>
+#include <QImage>
+#include "triplebuffer.h"
+
+#include <string>
+#include <vector>
+
+// Everything RenderWorker draws, filled by the game thread in MainWindow::setupToDraw.
+// Sprites are in the backbuffer's space (the camera at the logical pixel-art resolution),
+// everything else is in the camera's space. Rasterizing only has to walk the lists
+struct RenderFrame
+{
+    struct Sprite {
+        int x = 0; // in px, in the backbuffer, drawn at the texture's own size
+        int y = 0;
+        unsigned int texture = 0; // Index in 'textures', already tinted
+    };
+
+    struct Rect {
+        int x = 0; // in px
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        QColor color;
+    };
+
+    struct Hud {
+        std::string selectedWeapon;
+        int health = 0;
+        int missileCount = 0;
+        int grenadeCount = 0;
+        double dashBar = 0.0; // From 0 to 1
+    };
+
+    struct DebugInfo {
+        double x = 0.0;
+        double y = 0.0;
+        double vx = 0.0;
+        double vy = 0.0;
+        int boxX = 0;
+        int boxY = 0;
+        int boxWidth = 0;
+        int boxHeight = 0;
+        std::string state;
+        std::string facing;
+        double speedRetained = 0.0;
+        double retainTime = 0.0;
+        bool onGround = false;
+        std::string room;
+        double iTime = 0.0;
+        double lagTime = 0.0;
+        double shootTime = 0.0;
+        double switchDelay = 0.0;
+        bool fastFalling = false;
+        double jumpTime = 0.0;
+        double priorDashVX = 0.0;
+        double priorDashVY = 0.0;
+        double dashTime = 0.0;
+        std::string dashCoolDownType;
+        double dashCoolDown = 0.0;
+        std::string dashDirection;
+        unsigned long long frameCount = 0;
+        int tasLineFrameCount = 0;
+        int tasLineNumber = 0;
+        unsigned long long narrowphaseChecks = 0;
+        unsigned long long animationHits = 0;
+        unsigned long long animationMisses = 0;
+        unsigned long long animationBytes = 0;
+        unsigned long long prefetchHits = 0;
+        unsigned long long prefetchMisses = 0;
+        std::vector<std::string> loadedRooms;
+        std::vector<std::string> loadingRooms;
+        std::vector<std::string> unloadingRooms;
+        std::vector<std::string> cachedRooms;
+        unsigned long long roomCacheBytes = 0;
+    };
+
+    // Empties the lists but keeps their memory, so filling a reused frame doesn't allocate
+    void clear();
+
+    bool inMap = false; // The map is drawn instead of the room
+    int cameraX = 0; // in px
+    int cameraY = 0;
+    int cameraWidth = 0; // in px, what the camera sees of the world
+    int cameraHeight = 0;
+    int backbufferWidth = 0; // in px, the camera size divided by the rendering multiplier
+    int backbufferHeight = 0;
+    bool integerScaling = false; // Upscale the backbuffer by a whole factor only
+
+    // Room
+    std::vector<QImage> textures; // Implicitly shared copies, the entities may change theirs meanwhile
+    std::vector<Sprite> sprites; // In drawing order, see RenderQueue
+    std::vector<Rect> hitboxes; // Empty if the hitboxes aren't rendered, in the camera's space
+    bool showFps = false;
+    unsigned int fps = 0;
+    bool showHud = false;
+    Hud hud;
+    bool inDialogue = false;
+    std::string talkingName;
+    std::string dialogueText;
+    bool isPaused = false;
+    std::vector<std::string> menuOptions;
+    int selectedOption = 0;
+
+    // Map
+    int mapScaleDown = 1;
+    int mapCameraX = 0; // in px, in the world
+    int mapCameraY = 0;
+    int mapCameraWidth = 0; // in px, on screen
+    int mapCameraHeight = 0;
+    std::vector<Rect> mapRooms; // In the world
+    std::vector<Rect> mapDoors; // In the world
+    bool showMinimos = false;
+    int minimosX = 0; // Center of Samos in the world
+    int minimosY = 0;
+
+    bool showDebugInfo = false;
+    DebugInfo debugInfo;
+};
+
+// Filled by the game thread in MainWindow::setupToDraw, rasterized by the RenderWorker
+typedef TripleBuffer<RenderFrame> RenderFrameBuffer;
+
+#endif // RENDERFRAME_H
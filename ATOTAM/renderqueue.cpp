@@ -0,0 +1,68 @@
+#include "renderqueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Key layout, from the most significant bits:
+// LayerFirst: layer (32 bits), priority (8 bits), texture (24 bits)
+// PriorityFirst: priority (8 bits), layer (32 bits), texture (24 bits)
+static const unsigned int textureBits = 24;
+static const unsigned int textureMask = (1 << textureBits) - 1;
+
+RenderQueue::RenderQueue(Order order)
+    : order(order)
+{
+
+}
+
+unsigned int RenderQueue::textureKey(long long cacheKey)
+{
+    unsigned long long bits = static_cast<unsigned long long>(cacheKey);
+    return (bits ^ (bits >> textureBits) ^ (bits >> (2 * textureBits))) & textureMask;
+}
+
+unsigned long long RenderQueue::layerBits(float layer)
+{
+    unsigned int bits = 0;
+    std::memcpy(&bits, &layer, sizeof(bits));
+    // Positive floats sort like their bits once the sign bit is set, negative ones once every bit is flipped
+    return bits & 0x80000000 ? ~bits : bits | 0x80000000;
+}
+
+void RenderQueue::clear()
+{
+    commands.clear();
+}
+
+void RenderQueue::push(float layer, unsigned int priority, unsigned int texture, unsigned int item)
+{
+    Command command;
+    unsigned long long priorityBits = priority > maxPriority ? maxPriority : priority;
+    if (order == LayerFirst)
+        command.key = layerBits(layer) << 32 | priorityBits << textureBits;
+    else
+        command.key = priorityBits << 56 | layerBits(layer) << textureBits;
+    command.key |= texture & textureMask;
+    command.item = item;
+    commands.push_back(command);
+}
+
+void RenderQueue::sort()
+{
+    // The items are pushed in order, so comparing them keeps the sort stable
+    std::sort(commands.begin(), commands.end(), [](const Command &a, const Command &b) {
+        if (a.key != b.key)
+            return a.key < b.key;
+        return a.item < b.item;
+    });
+}
+
+const std::vector<RenderQueue::Command> &RenderQueue::getCommands() const
+{
+    return commands;
+}
+
+RenderQueue::Order RenderQueue::getOrder() const
+{
+    return order;
+}
@@ -0,0 +1,43 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <vector>
+
+// Draw order of a frame's sprites. Each sprite gets a single integer key packing its layer,
+// the priority of its room and its texture, and the queue is sorted once per frame.
+// Sprites with the same texture end up next to each other, sprites with the same key keep
+// the order they were pushed in
+class RenderQueue
+{
+public:
+    enum Order {
+        LayerFirst, // The layer, then the priority: the game, where layers go across rooms
+        PriorityFirst // The priority, then the layer: the editor, where the current room is on top
+    };
+
+    struct Command {
+        unsigned long long key = 0;
+        unsigned int item = 0; // Index of the sprite in the caller's own list
+    };
+
+    static const unsigned int maxPriority = 0xFF;
+
+    RenderQueue(Order order = LayerFirst);
+
+    static unsigned int textureKey(long long cacheKey); // Folds QImage::cacheKey into the key's texture bits
+
+    void clear(); // Keeps the memory, so filling the queue again doesn't allocate
+    void push(float layer, unsigned int priority, unsigned int texture, unsigned int item); // The bigger 'priority' the later it's drawn
+    void sort();
+    const std::vector<Command> &getCommands() const; // In drawing order once sorted
+
+    Order getOrder() const;
+
+private:
+    static unsigned long long layerBits(float layer); // Ordered like the floats, negative ones included
+
+    Order order;
+    std::vector<Command> commands;
+};
+
+#endif // RENDERQUEUE_H
@@ -0,0 +1,286 @@
+#include "renderworker.h"
+
+#include <QFont>
+#include <QMetaObject>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+RenderWorker::RenderWorker(RenderFrameBuffer &frames, QWidget *target, const QImage &minimosTexture, const QColor &background)
+    : frames(frames)
+    , target(target)
+    , minimosTexture(minimosTexture)
+    , background(background)
+    , thread(&RenderWorker::run, this)
+{
+
+}
+
+RenderWorker::~RenderWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+void RenderWorker::frameReady()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = true;
+    }
+    wake.notify_one();
+}
+
+void RenderWorker::setOutputSize(int width, int height)
+{
+    outputWidth = width;
+    outputHeight = height;
+    frameReady();
+}
+
+const QImage &RenderWorker::getPresentedFrame()
+{
+    // Cleared first: an image finished from now on needs another repaint
+    presentPosted = false;
+    return presented.getFrontFrame();
+}
+
+void RenderWorker::run()
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return pending || stopping; });
+            if (stopping)
+                return;
+            pending = false;
+        }
+
+        // Frames published meanwhile are skipped, only the latest one is worth showing
+        rasterize(frames.getFrontFrame(), presented.getBackFrame());
+        presented.publish();
+
+        // QWidget::update is a slot, the queued call runs it on the GUI thread
+        if (!presentPosted.exchange(true))
+            QMetaObject::invokeMethod(target, "update", Qt::QueuedConnection);
+    }
+}
+
+static std::string joinRooms(const std::vector<std::string> &rooms)
+{
+    std::string str = "[";
+    for (unsigned int i = 0; i < rooms.size(); i++) {
+        if (i != 0)
+            str += ", ";
+        str += rooms[i];
+    }
+    return str + "]";
+}
+
+void RenderWorker::rasterize(const RenderFrame &frame, QImage &image)
+{
+    int c_x = frame.cameraX;
+    int c_y = frame.cameraY;
+
+    // The image is reused while the window keeps its size
+    int width = outputWidth;
+    int height = outputHeight;
+    if (image.width() != width || image.height() != height)
+        image = QImage(width, height, QImage::Format_ARGB32_Premultiplied);
+    image.fill(background);
+
+    // Where the camera goes in the window, as big as possible while keeping its aspect ratio
+    QRect view = viewport(frame, width, height);
+    if (view.isEmpty())
+        return;
+    QPainter painter(&image);
+
+    if (!frame.inMap) {
+        // Unscaled blits into the backbuffer, then a single nearest-neighbour upscale
+        if (backbuffer.width() != frame.backbufferWidth || backbuffer.height() != frame.backbufferHeight)
+            backbuffer = QImage(frame.backbufferWidth, frame.backbufferHeight, QImage::Format_ARGB32_Premultiplied);
+        backbuffer.fill(background);
+        QPainter world(&backbuffer);
+        for (std::vector<RenderFrame::Sprite>::const_iterator sprite = frame.sprites.begin(); sprite != frame.sprites.end(); sprite++)
+            world.drawImage(sprite->x, sprite->y, frame.textures[sprite->texture]);
+        world.end();
+        painter.drawImage(view, backbuffer);
+    }
+
+    // The rest is drawn in the camera's space
+    painter.translate(view.x(), view.y());
+    painter.scale(static_cast<double>(view.width()) / frame.cameraWidth, static_cast<double>(view.height()) / frame.cameraHeight);
+
+    if (!frame.inMap) {
+
+
+        //Draw hitboxes if necessary
+        for (std::vector<RenderFrame::Rect>::const_iterator hitbox = frame.hitboxes.begin(); hitbox != frame.hitboxes.end(); hitbox++) {
+            painter.setPen(hitbox->color);
+            painter.drawRect(hitbox->x, hitbox->y, hitbox->width, hitbox->height);
+        }
+
+        // Draw fps if necessary
+        if (frame.showFps) {
+            painter.setPen(QColor("black"));
+            painter.drawText(QPoint(2, 12), QString::fromStdString(std::to_string(frame.fps) + " FPS"));
+        }
+
+        QFont f = painter.font();
+        f.setPointSize(f.pointSize() * 2);
+        painter.setFont(f);
+
+        //HUD
+        if (frame.showHud) {
+
+            painter.setPen(QColor("black"));
+
+            //Selected weapon
+            painter.fillRect(QRect(70,15,100,30), QColor("white"));
+            painter.drawRect(QRect(70,15,100,30));
+            painter.drawText(QPoint(80, 40), QString::fromStdString(frame.hud.selectedWeapon));
+
+            //Missile count
+            painter.fillRect(QRect(200,15,70,30), QColor("white"));
+            painter.drawRect(QRect(200,15,70,30));
+            painter.drawText(QPoint(210, 40), QString::fromStdString("M : " + std::to_string(frame.hud.missileCount)));
+
+            //Grenade count
+            painter.fillRect(QRect(290,15,70,30), QColor("white"));
+            painter.drawRect(QRect(290,15,70,30));
+            painter.drawText(QPoint(300, 40), QString::fromStdString("G : " + std::to_string(frame.hud.grenadeCount)));
+
+            //Health count
+            painter.fillRect(QRect(380,15,80,30), QColor("white"));
+            painter.drawRect(QRect(380,15,80,30));
+            painter.drawText(QPoint(390, 40), QString::fromStdString("H : " + std::to_string(frame.hud.health)));
+
+
+            //Dash
+            painter.fillRect(QRect(480,15,190,30), QColor("white"));
+            painter.drawRect(QRect(480,15,190,30));
+            painter.drawText(QPoint(490, 40), "Dash : ");
+            painter.fillRect(QRect(560,20,100*frame.hud.dashBar,20), QColor(frame.hud.dashBar == 1.0 ? "gray" : "darkGray"));
+        }
+
+        // Dialogue
+        if (frame.inDialogue) {
+            // In case we changed it before
+            painter.setPen(QColor("black"));
+
+            painter.drawText(QRectF(QRect(200, 200, 1000, 200)),
+                             QString::fromStdString(frame.talkingName + " : " + frame.dialogueText),
+                    QTextOption(Qt::AlignHCenter));
+        }
+
+        //Menu
+        if (frame.isPaused) {
+            painter.fillRect(QRect(0,0,frame.cameraWidth,frame.cameraHeight), QBrush(QColor(0,0,0,200)));
+            for (unsigned int i = 0; i < frame.menuOptions.size(); i++) {
+                painter.setPen(QColor("white"));
+                if (frame.selectedOption == (int) i)
+                    painter.setPen(QColor("cyan"));
+                painter.drawText(0, frame.cameraHeight / 2 - 15 * frame.menuOptions.size() + 30 * i, frame.cameraWidth, 50, Qt::AlignHCenter, QString::fromStdString(frame.menuOptions[i]));
+            }
+        }
+        f.setPointSize(f.pointSize() / 2);
+        painter.setFont(f);
+
+    } else {
+        int mc_x = frame.mapCameraX;
+        int mc_y = frame.mapCameraY;
+        int mapScaleDown = frame.mapScaleDown;
+        for (std::vector<RenderFrame::Rect>::const_iterator room = frame.mapRooms.begin(); room != frame.mapRooms.end(); room++) {
+            QRect roomRect((room->x - mc_x) / mapScaleDown, (room->y - mc_y) / mapScaleDown,
+                           room->width / mapScaleDown, room->height / mapScaleDown);
+            painter.fillRect(roomRect, QColor(32,50,100));
+
+            painter.setPen(QPen(QColor(64,100,200), 5));
+            painter.drawRect(roomRect);
+        }
+
+        for (std::vector<RenderFrame::Rect>::const_iterator door = frame.mapDoors.begin(); door != frame.mapDoors.end(); door++)
+            painter.fillRect(QRect((door->x - mc_x) / mapScaleDown, (door->y - mc_y) / mapScaleDown,
+                                   door->width / mapScaleDown, door->height / mapScaleDown),
+                             QColor("darkGray"));
+
+        painter.setPen(QPen(QColor(64,192,64,100), 5));
+        painter.drawRect(QRect((c_x - mc_x) / mapScaleDown, (c_y - mc_y) / mapScaleDown,
+                            frame.mapCameraWidth, frame.mapCameraHeight));
+        if (frame.showMinimos) {
+            painter.drawImage(QRect((frame.minimosX - mc_x) / mapScaleDown - minimosTexture.width() / 2,
+                                    (frame.minimosY - mc_y) / mapScaleDown - minimosTexture.height() / 2,
+                                    minimosTexture.width(),
+                                    minimosTexture.height()),
+                              minimosTexture);
+        }
+    }
+    if (frame.showDebugInfo) {
+        const RenderFrame::DebugInfo &info = frame.debugInfo;
+        painter.fillRect(QRect(70, 70, 250, 750), QBrush(QColor(0,0,0,150)));
+
+        painter.setPen(QColor("white"));
+
+        painter.drawText(QPoint(80, 90), QString::fromStdString("X : " + std::to_string(info.x)));
+        painter.drawText(QPoint(80, 110), QString::fromStdString("Y : " + std::to_string(info.y)));
+        painter.drawText(QPoint(80, 130), QString::fromStdString("VX : " + std::to_string(info.vx)));
+        painter.drawText(QPoint(80, 150), QString::fromStdString("VY : " + std::to_string(info.vy)));
+        painter.drawText(QPoint(80, 170), QString::fromStdString("Box X : " + std::to_string(info.boxX)));
+        painter.drawText(QPoint(80, 190), QString::fromStdString("Box Y : " + std::to_string(info.boxY)));
+        painter.drawText(QPoint(80, 210), QString::fromStdString("Box Width : " + std::to_string(info.boxWidth)));
+        painter.drawText(QPoint(80, 230), QString::fromStdString("Box Height : " + std::to_string(info.boxHeight)));
+        painter.drawText(QPoint(80, 250), QString::fromStdString("State : " + info.state));
+        painter.drawText(QPoint(80, 270), QString::fromStdString("Facing : " + info.facing));
+        painter.drawText(QPoint(80, 290), QString::fromStdString("Speed retained : " + std::to_string(info.speedRetained)));
+        painter.drawText(QPoint(80, 310), QString::fromStdString("Retain time : " + std::to_string(info.retainTime)));
+        painter.drawText(QPoint(80, 330), QString::fromStdString("On ground : " + std::to_string(info.onGround)));
+        painter.drawText(QPoint(80, 350), QString::fromStdString("Room ID : " + info.room));
+        painter.drawText(QPoint(80, 370), QString::fromStdString("I-Time : " + std::to_string(info.iTime)));
+        painter.drawText(QPoint(80, 390), QString::fromStdString("Lag time : " + std::to_string(info.lagTime)));
+        painter.drawText(QPoint(80, 410), QString::fromStdString("Shoot cooldown : " + std::to_string(info.shootTime)));
+        painter.drawText(QPoint(80, 430), QString::fromStdString("Switch cooldown : " + std::to_string(info.switchDelay)));
+        painter.drawText(QPoint(80, 450), QString::fromStdString("Fast falling : " + std::to_string(info.fastFalling)));
+        painter.drawText(QPoint(80, 470), QString::fromStdString("Jump time : " + std::to_string(info.jumpTime)));
+        painter.drawText(QPoint(80, 490), QString::fromStdString("VX prior dash: " + std::to_string(info.priorDashVX)));
+        painter.drawText(QPoint(80, 510), QString::fromStdString("VY prior dash: " + std::to_string(info.priorDashVY)));
+        painter.drawText(QPoint(80, 530), QString::fromStdString("Dash time : " + std::to_string(info.dashTime)));
+        painter.drawText(QPoint(80, 550), QString::fromStdString("Dash cooldown : " + std::to_string(info.dashCoolDown)));
+        painter.drawText(QPoint(80, 570), QString::fromStdString("Dash cooldown type : " + info.dashCoolDownType));
+        painter.drawText(QPoint(80, 590), QString::fromStdString("Dash direction : " + info.dashDirection));
+        painter.drawText(QPoint(80, 610), QString::fromStdString("Frame count : " + std::to_string(info.frameCount)));
+        painter.drawText(QPoint(80, 630), QString::fromStdString("TAS Current line frame count : " + std::to_string(info.tasLineFrameCount)));
+        painter.drawText(QPoint(80, 650), QString::fromStdString("TAS Current line number : " + std::to_string(info.tasLineNumber)));
+        painter.drawText(QPoint(80, 670), QString::fromStdString("Loaded rooms : " + joinRooms(info.loadedRooms)));
+        painter.drawText(QPoint(80, 690), QString::fromStdString("Rooms being loaded : " + joinRooms(info.loadingRooms)));
+        painter.drawText(QPoint(80, 710), QString::fromStdString("Rooms being unloaded : " + joinRooms(info.unloadingRooms)));
+        painter.drawText(QPoint(80, 730), QString::fromStdString("Narrowphase checks : " + std::to_string(info.narrowphaseChecks)));
+        painter.drawText(QPoint(80, 750), QString::fromStdString("Animation cache : " + std::to_string(info.animationHits) + " hits, "
+                                                                 + std::to_string(info.animationMisses) + " misses"));
+        painter.drawText(QPoint(80, 770), QString::fromStdString("Animation memory : " + std::to_string(info.animationBytes / 1024) + " KiB"));
+        painter.drawText(QPoint(80, 790), QString::fromStdString("Room prefetch : " + std::to_string(info.prefetchHits) + " hits, "
+                                                                 + std::to_string(info.prefetchMisses) + " synchronous loads"));
+        painter.drawText(QPoint(80, 810), QString::fromStdString("Cached rooms : " + joinRooms(info.cachedRooms) + " ("
+                                                                 + std::to_string(info.roomCacheBytes / 1024) + " KiB)"));
+    }
+    painter.end();
+}
+
+QRect RenderWorker::viewport(const RenderFrame &frame, int width, int height) const
+{
+    if (frame.backbufferWidth <= 0 || frame.backbufferHeight <= 0)
+        return QRect();
+
+    double scale = std::min(static_cast<double>(width) / frame.backbufferWidth, static_cast<double>(height) / frame.backbufferHeight);
+    // Every logical pixel then has the same size, the rest of the window stays empty
+    if (frame.integerScaling && scale >= 1.0)
+        scale = std::floor(scale);
+    int viewWidth = frame.backbufferWidth * scale;
+    int viewHeight = frame.backbufferHeight * scale;
+    return QRect((width - viewWidth) / 2, (height - viewHeight) / 2, viewWidth, viewHeight);
+}
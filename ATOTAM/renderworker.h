@@ -0,0 +1,53 @@
+#ifndef RENDERWORKER_H
+#define RENDERWORKER_H
+
+#include <QColor>
+#include <QImage>
+#include <QRect>
+#include <QWidget>
+
+#include "renderframe.h"
+#include "triplebuffer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Rasterizes the latest RenderFrame into a window-sized image on its own thread, so that the
+// simulation, the rasterization and the presentation each run on their own core.
+// The GUI thread only draws the finished images, 'target' is asked to repaint through a queued call
+class RenderWorker
+{
+public:
+    RenderWorker(RenderFrameBuffer &frames, QWidget *target, const QImage &minimosTexture, const QColor &background);
+    ~RenderWorker(); // Waits for the frame being rasterized
+
+    void frameReady(); // Game thread, after publishing a frame
+    void setOutputSize(int width, int height); // GUI thread, rasterizes the latest frame again at this size
+    const QImage &getPresentedFrame(); // GUI thread, the latest finished image, null before the first one
+
+private:
+    void run();
+    void rasterize(const RenderFrame &frame, QImage &image);
+    QRect viewport(const RenderFrame &frame, int width, int height) const; // Where the camera is drawn, empty before the first frame
+
+    RenderFrameBuffer &frames;
+    QWidget *target;
+    QImage minimosTexture; // Samos on the map
+    QColor background;
+    QImage backbuffer; // The world at the logical resolution
+    TripleBuffer<QImage> presented; // Filled by this worker, drawn by the GUI thread
+
+    std::atomic<int> outputWidth{0};
+    std::atomic<int> outputHeight{0};
+    std::atomic<bool> presentPosted{false}; // A repaint is already queued, no need for another one
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool pending = false; // A frame to rasterize, guarded by 'mutex'
+    bool stopping = false;
+    std::thread thread; // Last, started once everything else is initialized
+};
+
+#endif // RENDERWORKER_H
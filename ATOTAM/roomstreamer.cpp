@@ -0,0 +1,214 @@
+#include "roomstreamer.h"
+
+#include <algorithm>
+
+RoomStreamer::RoomStreamer()
+    : thread(&RoomStreamer::run, this)
+{
+
+}
+
+RoomStreamer::~RoomStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+
+    // Nobody will take them anymore
+    for (std::deque<StreamedRoom>::iterator room = jobs[Unload].begin(); room != jobs[Unload].end(); room++)
+        destroy(*room);
+    for (std::vector<StreamedRoom>::iterator room = loaded.begin(); room != loaded.end(); room++)
+        destroy(*room);
+}
+
+std::vector<StreamedRoom> RoomStreamer::restart(const Map &newMap, int newRenderingMultiplier)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    jobs[Load].clear();
+    jobs[Prefetch].clear();
+    // The queued unloads still go, they don't read the map
+    idle.wait(lock, [this] { return !building; });
+
+    map = newMap;
+    renderingMultiplier = newRenderingMultiplier;
+
+    std::vector<StreamedRoom> stale;
+    stale.swap(loaded);
+    return stale;
+}
+
+void RoomStreamer::load(const std::string &roomId, Priority priority)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (findQueued(roomId, Load) != jobs[Load].end()
+                || (priority == Prefetch && findQueued(roomId, Prefetch) != jobs[Prefetch].end()))
+            return;
+        // Prefetched room needed now
+        removeQueued(roomId, Prefetch);
+
+        StreamedRoom job;
+        job.id = roomId;
+        jobs[priority].push_back(job);
+    }
+    wake.notify_one();
+}
+
+void RoomStreamer::unload(const StreamedRoom &room)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs[Unload].push_back(room);
+    }
+    wake.notify_one();
+}
+
+void RoomStreamer::raise(const std::string &roomId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (removeQueued(roomId, Prefetch)) {
+        StreamedRoom job;
+        job.id = roomId;
+        jobs[Load].push_back(job);
+    }
+}
+
+bool RoomStreamer::cancel(const std::string &roomId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    bool queued = removeQueued(roomId, Load);
+    return removeQueued(roomId, Prefetch) || queued;
+}
+
+void RoomStreamer::pause()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    paused = true;
+    idle.wait(lock, [this] { return !building; });
+}
+
+void RoomStreamer::resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        paused = false;
+    }
+    wake.notify_one();
+}
+
+void RoomStreamer::takeFinished(std::vector<StreamedRoom> &loadedRooms, std::vector<std::string> &unloadedRooms)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    loadedRooms.insert(loadedRooms.end(), loaded.begin(), loaded.end());
+    loaded.clear();
+    unloadedRooms.insert(unloadedRooms.end(), unloaded.begin(), unloaded.end());
+    unloaded.clear();
+}
+
+void RoomStreamer::destroy(StreamedRoom &room)
+{
+    if (room.entities != nullptr)
+        for (std::vector<Entity*>::iterator e = room.entities->begin(); e != room.entities->end(); e++)
+            delete *e;
+    delete room.entities;
+    room.entities = nullptr;
+    delete room.geometry;
+    room.geometry = nullptr;
+    delete room.layer;
+    room.layer = nullptr;
+    // The entities only ran their destructors, their memory goes all at once
+    delete room.arena;
+    room.arena = nullptr;
+}
+
+std::size_t RoomStreamer::footprint(const StreamedRoom &room)
+{
+    std::size_t bytes = 0;
+    if (room.arena != nullptr)
+        bytes += room.arena->getUsedBytes();
+    if (room.entities != nullptr) {
+        bytes += room.entities->capacity() * sizeof(Entity*) + room.entities->size() * BodyStore::getSlotBytes();
+        // Frames only this entity holds: the random textures (repeated Stone...) are built for each entity
+        for (std::vector<Entity*>::const_iterator e = room.entities->begin(); e != room.entities->end(); e++)
+            if ((*e)->getCurrentAnimationFrames().use_count() == 1)
+                for (std::vector<QImage>::const_iterator frame = (*e)->getCurrentAnimation().begin(); frame != (*e)->getCurrentAnimation().end(); frame++)
+                    bytes += frame->sizeInBytes();
+    }
+    if (room.geometry != nullptr)
+        bytes += room.geometry->getColliders().size() * (sizeof(Terrain) + sizeof(Terrain*));
+    if (room.layer != nullptr)
+        for (std::map<float, std::vector<StaticLayer::Chunk>>::const_iterator layer = room.layer->getChunks().begin();
+             layer != room.layer->getChunks().end(); layer++)
+            for (std::vector<StaticLayer::Chunk>::const_iterator chunk = layer->second.begin(); chunk != layer->second.end(); chunk++)
+                bytes += sizeof(StaticLayer::Chunk) + chunk->image.sizeInBytes();
+    return bytes;
+}
+
+void RoomStreamer::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] {
+            return stopping || (!paused && (!jobs[Load].empty() || !jobs[Unload].empty() || !jobs[Prefetch].empty()));
+        });
+        if (stopping)
+            return;
+
+        int priority = Load;
+        while (jobs[priority].empty())
+            priority++;
+        StreamedRoom job = jobs[priority].front();
+        jobs[priority].pop_front();
+
+        building = true;
+        if (priority == Unload) {
+            lock.unlock();
+            destroy(job);
+            lock.lock();
+            unloaded.push_back(job.id);
+        } else {
+            lock.unlock();
+            StreamedRoom room = build(job.id);
+            lock.lock();
+            loaded.push_back(room);
+        }
+        building = false;
+        idle.notify_all();
+    }
+}
+
+StreamedRoom RoomStreamer::build(const std::string &roomId)
+{
+    StreamedRoom room;
+    room.id = roomId;
+    room.arena = new RoomArena();
+    {
+        RoomArena::Scope scope(*room.arena);
+        room.entities = new std::vector<Entity*>(map.loadRoom(roomId));
+    }
+    // Merge the room's Terrain and draw its scenery while we're still off the game thread.
+    // This room isn't the current one so the grids don't need to be refitted
+    room.geometry = new StaticGeometry(*room.entities);
+    room.layer = new StaticLayer(*room.entities, renderingMultiplier);
+    // Measured here rather than when the room is left, which happens in the last step of a door transition
+    room.bytes = footprint(room);
+    return room;
+}
+
+std::deque<StreamedRoom>::iterator RoomStreamer::findQueued(const std::string &roomId, Priority priority)
+{
+    return std::find_if(jobs[priority].begin(), jobs[priority].end(),
+                        [&roomId](const StreamedRoom &job) { return job.id == roomId; });
+}
+
+bool RoomStreamer::removeQueued(const std::string &roomId, Priority priority)
+{
+    std::deque<StreamedRoom>::iterator job = findQueued(roomId, priority);
+    if (job == jobs[priority].end())
+        return false;
+    jobs[priority].erase(job);
+    return true;
+}
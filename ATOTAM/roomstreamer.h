@@ -0,0 +1,79 @@
+#ifndef ROOMSTREAMER_H
+#define ROOMSTREAMER_H
+
+#include "map.h"
+#include "staticgeometry.h"
+#include "staticlayer.h"
+#include "Entities/entity.h"
+#include "Entities/roomarena.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Everything the game keeps for a loaded room
+struct StreamedRoom
+{
+    std::string id;
+    std::vector<Entity*> *entities = nullptr;
+    StaticGeometry *geometry = nullptr;
+    StaticLayer *layer = nullptr;
+    RoomArena *arena = nullptr; // Holds the entities, deleted last
+    std::size_t bytes = 0; // footprint, measured once built
+};
+
+// Loads and unloads rooms on one long-lived thread. Any thread can queue jobs, the worker takes
+// them by priority and hands the results back through a completion list, which the game thread
+// drains with takeFinished at a point of the frame where no room is being used.
+// The worker loads rooms from its own copy of the Map, as loading reads the map's json
+class RoomStreamer
+{
+public:
+    enum Priority { Load, Unload, Prefetch, priorityCount }; // Taken in this order
+
+    RoomStreamer();
+    ~RoomStreamer(); // Finishes the current job, deletes the rooms nobody took
+    RoomStreamer(const RoomStreamer&) = delete;
+    RoomStreamer &operator=(const RoomStreamer&) = delete;
+
+    // Drops the queued loads and waits for the one being built, then loads from 'map' from now on.
+    // Returns the loaded rooms that weren't taken yet, they belong to the caller
+    std::vector<StreamedRoom> restart(const Map &map, int renderingMultiplier);
+    void load(const std::string &roomId, Priority priority = Load); // Raises the priority if already queued
+    void unload(const StreamedRoom &room); // Deletes every part of 'room' on the worker
+    void raise(const std::string &roomId); // Moves a queued prefetch ahead of the unloads, does nothing once it is being built
+    bool cancel(const std::string &roomId); // Whether the load was still queued, false once it is being built
+    // Waits for the current job, then runs none until resume. For when the archetypes the rooms are built from change
+    void pause();
+    void resume();
+    // Moves the finished jobs into 'loaded' and 'unloaded' (room ids), the loaded rooms then belong to the caller
+    void takeFinished(std::vector<StreamedRoom> &loaded, std::vector<std::string> &unloaded);
+
+    static void destroy(StreamedRoom &room);
+    static std::size_t footprint(const StreamedRoom &room); // Bytes held by the room's entities and their bodies, the frames of their own, the colliders and the scenery chunks
+
+private:
+    void run();
+    StreamedRoom build(const std::string &roomId); // Called with 'mutex' unlocked
+    std::deque<StreamedRoom>::iterator findQueued(const std::string &roomId, Priority priority); // Called with 'mutex' locked
+    bool removeQueued(const std::string &roomId, Priority priority); // Called with 'mutex' locked
+
+    Map map; // Only read by the worker while 'building'
+    int renderingMultiplier = 1;
+
+    std::mutex mutex;
+    std::condition_variable wake; // A job was queued, resumed, or stopping
+    std::condition_variable idle; // A job was finished
+    std::deque<StreamedRoom> jobs[priorityCount]; // Loads only have an id
+    std::vector<StreamedRoom> loaded;
+    std::vector<std::string> unloaded;
+    bool building = false; // A job is being run. Guarded by 'mutex', as every member above
+    bool paused = false;
+    bool stopping = false;
+    std::thread thread; // Last, started once everything else is initialized
+};
+
+#endif // ROOMSTREAMER_H
@@ -0,0 +1,175 @@
+#include "spatialgrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid()
+{
+    resize(0, 0, defaultCellSize, defaultCellSize);
+}
+
+SpatialGrid::SpatialGrid(int x, int y, int width, int height, int cellSize)
+{
+    resize(x, y, width, height, cellSize);
+}
+
+void SpatialGrid::resize(int x, int y, int width, int height, int cellSize)
+{
+    this->x = x;
+    this->y = y;
+    this->cellSize = cellSize > 0 ? cellSize : defaultCellSize;
+    columns = std::max(1, (width + this->cellSize - 1) / this->cellSize);
+    rows = std::max(1, (height + this->cellSize - 1) / this->cellSize);
+    cells = std::vector<std::vector<Entity*>>(columns * rows);
+    ranges.clear();
+}
+
+void SpatialGrid::clear()
+{
+    for (std::vector<Entity*> &cell : cells)
+        cell.clear();
+    ranges.clear();
+}
+
+void SpatialGrid::insert(Entity *e)
+{
+    place(e, computeRange(e, e->getBox()));
+}
+
+void SpatialGrid::remove(Entity *e)
+{
+    std::map<Entity*, CellRange>::iterator r = ranges.find(e);
+    if (r == ranges.end())
+        return;
+    removeFromCells(e, r->second);
+    ranges.erase(r);
+}
+
+void SpatialGrid::update(Entity *e)
+{
+    place(e, computeRange(e, e->getBox()));
+}
+
+void SpatialGrid::insert(Entity *e, double left, double top, double width, double height)
+{
+    place(e, computeRange(left, top, width, height));
+}
+
+void SpatialGrid::update(Entity *e, double left, double top, double width, double height)
+{
+    place(e, computeRange(left, top, width, height));
+}
+
+std::vector<Entity*> SpatialGrid::query(Entity *e, CollisionBox *box, double margin)
+{
+    std::vector<Entity*> result;
+    if (box == nullptr)
+        return result;
+
+    CellRange range = computeRange(e, box, margin);
+    for (int cy = range.minY; cy <= range.maxY; cy++)
+        for (int cx = range.minX; cx <= range.maxX; cx++)
+            for (Entity* candidate : cells[cy * columns + cx])
+                if (candidate != e)
+                    result.push_back(candidate);
+
+    // An entity overlapping several cells is found several times. Sorting by ID also keeps the
+    // resolution order the same as the order in which the entities were created
+    std::sort(result.begin(), result.end(), [](Entity* a, Entity* b) {
+        return a->getEntityID() < b->getEntityID();
+    });
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void SpatialGrid::queryArea(double left, double top, double width, double height, std::vector<Entity *> &result)
+{
+    std::vector<Entity*>::difference_type first = result.size();
+
+    CellRange range = computeRange(left, top, width, height);
+    for (int cy = range.minY; cy <= range.maxY; cy++)
+        for (int cx = range.minX; cx <= range.maxX; cx++)
+            for (Entity* candidate : cells[cy * columns + cx])
+                result.push_back(candidate);
+
+    // Only the appended entities are sorted, what was already in 'result' keeps its order
+    std::sort(result.begin() + first, result.end(), [](Entity* a, Entity* b) {
+        return a->getEntityID() < b->getEntityID();
+    });
+    result.erase(std::unique(result.begin() + first, result.end()), result.end());
+}
+
+bool SpatialGrid::contains(Entity *e) const
+{
+    return ranges.count(e) != 0;
+}
+
+size_t SpatialGrid::size() const
+{
+    return ranges.size();
+}
+
+SpatialGrid::CellRange SpatialGrid::computeRange(Entity *e, CollisionBox *box, double margin) const
+{
+    CellRange range;
+    // Entities without a box can't collide: they are registered in no cell
+    if (box == nullptr)
+        return range;
+
+    return computeRange(e->getX() + box->getX() - margin, e->getY() + box->getY() - margin,
+                        box->getWidth() + 2 * margin, box->getHeight() + 2 * margin);
+}
+
+SpatialGrid::CellRange SpatialGrid::computeRange(double left, double top, double width, double height) const
+{
+    CellRange range;
+    left -= x;
+    top -= y;
+    double right = left + width;
+    double bottom = top + height;
+
+    // Everything outside of the grid is put in the border cells
+    range.minX = std::min(std::max(static_cast<int>(std::floor(left / cellSize)), 0), columns - 1);
+    range.minY = std::min(std::max(static_cast<int>(std::floor(top / cellSize)), 0), rows - 1);
+    range.maxX = std::min(std::max(static_cast<int>(std::floor(right / cellSize)), 0), columns - 1);
+    range.maxY = std::min(std::max(static_cast<int>(std::floor(bottom / cellSize)), 0), rows - 1);
+    return range;
+}
+
+void SpatialGrid::place(Entity *e, const CellRange &range)
+{
+    std::map<Entity*, CellRange>::iterator r = ranges.find(e);
+    if (r == ranges.end()) {
+        addToCells(e, range);
+        ranges[e] = range;
+        return;
+    }
+    // Most entities stay in the same cells from one frame to the next
+    if (range.minX == r->second.minX && range.minY == r->second.minY
+            && range.maxX == r->second.maxX && range.maxY == r->second.maxY)
+        return;
+    removeFromCells(e, r->second);
+    addToCells(e, range);
+    r->second = range;
+}
+
+void SpatialGrid::addToCells(Entity *e, const CellRange &range)
+{
+    for (int cy = range.minY; cy <= range.maxY; cy++)
+        for (int cx = range.minX; cx <= range.maxX; cx++)
+            cells[cy * columns + cx].push_back(e);
+}
+
+void SpatialGrid::removeFromCells(Entity *e, const CellRange &range)
+{
+    for (int cy = range.minY; cy <= range.maxY; cy++)
+        for (int cx = range.minX; cx <= range.maxX; cx++) {
+            std::vector<Entity*> &cell = cells[cy * columns + cx];
+            std::vector<Entity*>::iterator it = std::find(cell.begin(), cell.end(), e);
+            if (it != cell.end()) {
+                // Order inside a cell doesn't matter since queries are sorted
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+}
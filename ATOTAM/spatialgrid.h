@@ -0,0 +1,78 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "Entities/entity.h"
+
+#include <map>
+#include <vector>
+
+// Uniform grid broadphase. Entities are registered in every cell their CollisionBox overlaps,
+// so a query only has to look at the few entities sharing a cell with the given box.
+// The renderer also uses it for the view culling, with the area covered by each texture
+class SpatialGrid
+{
+public:
+    static const int defaultCellSize = 128; // in px
+
+    SpatialGrid();
+    SpatialGrid(int x, int y, int width, int height, int cellSize = defaultCellSize);
+
+    // Sets the area covered by the grid (usually the room bounds) and removes every entity
+    void resize(int x, int y, int width, int height, int cellSize = defaultCellSize);
+    void clear();
+
+    void insert(Entity* e);
+    void remove(Entity* e);
+    // Moves the entity to the cells it now overlaps. Does nothing if they didn't change
+    void update(Entity* e);
+    // Same as insert and update, but with the given area (in px) instead of the entity's CollisionBox.
+    // Used to index entities by what they draw rather than by what they collide with
+    void insert(Entity* e, double left, double top, double width, double height);
+    void update(Entity* e, double left, double top, double width, double height);
+
+    // Returns the entities that may collide with 'box' placed at 'e''s position, sorted by entity ID.
+    // 'margin' (in px) widens the searched area, for entities that may be moved while resolving collisions
+    std::vector<Entity*> query(Entity* e, CollisionBox* box, double margin = 0);
+    template <typename T>
+    std::vector<T*> query(Entity* e, CollisionBox* box, double margin = 0);
+    // Appends the entities that may overlap the given area (in px) to 'result', sorted by entity ID.
+    // Reusing the same 'result' vector avoids any allocation
+    void queryArea(double left, double top, double width, double height, std::vector<Entity*> &result);
+
+    bool contains(Entity* e) const;
+    size_t size() const;
+
+private:
+    // Cell coordinates covered by an entity, inclusive
+    struct CellRange {
+        int minX = 0;
+        int minY = 0;
+        int maxX = -1;
+        int maxY = -1;
+    };
+
+    CellRange computeRange(Entity* e, CollisionBox* box, double margin = 0) const;
+    CellRange computeRange(double left, double top, double width, double height) const;
+    void place(Entity* e, const CellRange &range); // Inserts 'e' or moves it to 'range'
+    void addToCells(Entity* e, const CellRange &range);
+    void removeFromCells(Entity* e, const CellRange &range);
+
+    int x = 0; // in px
+    int y = 0; // in px
+    int columns = 1;
+    int rows = 1;
+    int cellSize = defaultCellSize; // in px
+    std::vector<std::vector<Entity*>> cells;
+    std::map<Entity*, CellRange> ranges; // Cells in which each registered entity currently is
+};
+
+template <typename T>
+std::vector<T*> SpatialGrid::query(Entity *e, CollisionBox *box, double margin)
+{
+    std::vector<T*> result;
+    for (Entity* candidate : query(e, box, margin))
+        result.push_back(static_cast<T*>(candidate));
+    return result;
+}
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,102 @@
+#include "staticgeometry.h"
+
+#include <algorithm>
+
+StaticGeometry::StaticGeometry(const std::vector<Entity*> &roomEntities)
+{
+    struct Rect {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    std::vector<Rect> boxes;
+    for (std::vector<Entity*>::const_iterator e = roomEntities.begin(); e != roomEntities.end(); e++) {
+        if ((*e)->getEntType() != EntityType::Terrain || (*e)->getBox() == nullptr)
+            continue;
+        CollisionBox* box = (*e)->getBox();
+        if (box->getWidth() <= 0 || box->getHeight() <= 0)
+            continue;
+        boxes.push_back({static_cast<int>((*e)->getX()) + box->getX(), static_cast<int>((*e)->getY()) + box->getY(),
+                         box->getWidth(), box->getHeight()});
+    }
+    sourceCount = boxes.size();
+    if (boxes.empty())
+        return;
+
+    // Compress the coordinates: every box edge becomes a grid line
+    std::vector<int> xs;
+    std::vector<int> ys;
+    for (const Rect &r : boxes) {
+        xs.push_back(r.x);
+        xs.push_back(r.x + r.width);
+        ys.push_back(r.y);
+        ys.push_back(r.y + r.height);
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+    const size_t columns = xs.size() - 1;
+    const size_t rows = ys.size() - 1;
+
+    // Mark the compressed cells covered by Terrain
+    std::vector<bool> solid(columns * rows, false);
+    for (const Rect &r : boxes) {
+        size_t x1 = std::lower_bound(xs.begin(), xs.end(), r.x) - xs.begin();
+        size_t x2 = std::lower_bound(xs.begin(), xs.end(), r.x + r.width) - xs.begin();
+        size_t y1 = std::lower_bound(ys.begin(), ys.end(), r.y) - ys.begin();
+        size_t y2 = std::lower_bound(ys.begin(), ys.end(), r.y + r.height) - ys.begin();
+        for (size_t cy = y1; cy < y2; cy++)
+            for (size_t cx = x1; cx < x2; cx++)
+                solid[cy * columns + cx] = true;
+    }
+
+    // Greedy merge: grow each rectangle to the right as far as possible, then downwards
+    // as long as the whole row below is solid too
+    std::vector<bool> used(columns * rows, false);
+    for (size_t cy = 0; cy < rows; cy++)
+        for (size_t cx = 0; cx < columns; cx++) {
+            if (!solid[cy * columns + cx] || used[cy * columns + cx])
+                continue;
+
+            size_t endX = cx + 1;
+            while (endX < columns && solid[cy * columns + endX] && !used[cy * columns + endX])
+                endX++;
+
+            size_t endY = cy + 1;
+            for (bool fullRow = true; endY < rows && fullRow; ) {
+                for (size_t x = cx; x < endX; x++)
+                    if (!solid[endY * columns + x] || used[endY * columns + x]) {
+                        fullRow = false;
+                        break;
+                    }
+                if (fullRow)
+                    endY++;
+            }
+
+            for (size_t y = cy; y < endY; y++)
+                for (size_t x = cx; x < endX; x++)
+                    used[y * columns + x] = true;
+
+            colliders.push_back(new Terrain(xs[cx], ys[cy], new CollisionBox(0, 0, xs[endX] - xs[cx], ys[endY] - ys[cy]), nullptr, ""));
+        }
+}
+
+StaticGeometry::~StaticGeometry()
+{
+    for (std::vector<Terrain*>::iterator t = colliders.begin(); t != colliders.end(); t++)
+        delete *t;
+}
+
+const std::vector<Terrain *> &StaticGeometry::getColliders() const
+{
+    return colliders;
+}
+
+unsigned int StaticGeometry::getSourceCount() const
+{
+    return sourceCount;
+}
@@ -0,0 +1,27 @@
+#ifndef STATICGEOMETRY_H
+#define STATICGEOMETRY_H
+
+#include "Entities/terrain.h"
+
+#include <vector>
+
+// Collision layer of a room's Terrain. Touching or overlapping Terrain boxes are greedily merged
+// into the fewest maximal rectangles, so the physics has far less colliders to test against.
+// Built once when the room is loaded and never modified afterwards
+class StaticGeometry
+{
+public:
+    StaticGeometry(const std::vector<Entity*> &roomEntities); // Merges the boxes of every Terrain in 'roomEntities'
+    ~StaticGeometry();
+    StaticGeometry(const StaticGeometry&) = delete;
+    StaticGeometry &operator=(const StaticGeometry&) = delete;
+
+    const std::vector<Terrain*> &getColliders() const;
+    unsigned int getSourceCount() const;
+
+private:
+    std::vector<Terrain*> colliders; // One Terrain with no texture per merged rectangle
+    unsigned int sourceCount = 0; // Number of Terrain boxes before merging
+};
+
+#endif // STATICGEOMETRY_H
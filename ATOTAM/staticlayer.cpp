@@ -0,0 +1,89 @@
+#include "staticlayer.h"
+#include "Entities/animationcache.h"
+
+#include <QPainter>
+
+#include <cmath>
+
+bool StaticLayer::isStill(Entity *entity)
+{
+    if (entity->getEntType() != EntityType::Terrain && entity->getEntType() != EntityType::Area)
+        return false;
+    if (entity->getTexture() == nullptr || entity->getTexture()->isNull())
+        return false;
+    // An animation with a single frame never changes either
+    const Archetype *archetype = entity->getArchetype();
+    return entity->getCurrentAnimation().size() <= 1
+            || archetype == nullptr || archetype->getClip(entity->getState()).refreshRate <= 0;
+}
+
+int StaticLayer::toLogical(int worldPx, int renderingMultiplier)
+{
+    return std::floor(static_cast<double>(worldPx) / renderingMultiplier);
+}
+
+StaticLayer::StaticLayer(const std::vector<Entity*> &roomEntities, int renderingMultiplier)
+{
+    struct Placed {
+        QRect area; // in px, at the logical resolution
+        const QImage *texture;
+    };
+
+    // Sort the textures by layer and chunk first, so that each chunk is painted in one go.
+    // The entities keep their order inside a chunk
+    std::map<float, std::map<std::pair<int, int>, std::vector<Placed>>> placed;
+    for (std::vector<Entity*>::const_iterator e = roomEntities.begin(); e != roomEntities.end(); e++) {
+        if (!isStill(*e))
+            continue;
+        const QImage *texture = (*e)->getTexture();
+        QRect area(toLogical(static_cast<int>((*e)->getX()) + texture->offset().x(), renderingMultiplier),
+                   toLogical(static_cast<int>((*e)->getY()) + texture->offset().y(), renderingMultiplier),
+                   texture->width(), texture->height());
+        if (area.width() <= 0 || area.height() <= 0)
+            continue;
+
+        bakedIDs.insert((*e)->getEntityID());
+        int left = std::floor(static_cast<double>(area.x()) / chunkSize);
+        int right = std::floor(static_cast<double>(area.x() + area.width() - 1) / chunkSize);
+        int top = std::floor(static_cast<double>(area.y()) / chunkSize);
+        int bottom = std::floor(static_cast<double>(area.y() + area.height() - 1) / chunkSize);
+        for (int cx = left; cx <= right; cx++)
+            for (int cy = top; cy <= bottom; cy++)
+                placed[(*e)->getLayer()][std::make_pair(cx, cy)].push_back({area, texture});
+    }
+
+    for (std::map<float, std::map<std::pair<int, int>, std::vector<Placed>>>::iterator layer = placed.begin(); layer != placed.end(); layer++) {
+        std::vector<Chunk> &layerChunks = chunks[layer->first];
+        for (std::map<std::pair<int, int>, std::vector<Placed>>::iterator cell = layer->second.begin(); cell != layer->second.end(); cell++) {
+            Chunk chunk;
+            chunk.x = cell->first.first * chunkSize;
+            chunk.y = cell->first.second * chunkSize;
+            chunk.image = QImage(chunkSize, chunkSize, QImage::Format_ARGB32_Premultiplied);
+            chunk.image.fill(Qt::transparent);
+
+            QPainter painter(&chunk.image);
+            for (std::vector<Placed>::iterator p = cell->second.begin(); p != cell->second.end(); p++)
+                painter.drawImage(p->area.x() - chunk.x, p->area.y() - chunk.y, *p->texture);
+            painter.end();
+            // Chunks fully covered by opaque Terrain are copied instead of blended
+            chunk.image = AnimationCache::displayReady(chunk.image);
+
+            layerChunks.push_back(chunk);
+        }
+    }
+}
+
+const std::map<float, std::vector<StaticLayer::Chunk>> &StaticLayer::getChunks() const
+{
+    return chunks;
+}
+
+bool StaticLayer::isBaked(const Entity *entity) const
+{
+    return bakedIDs.count(entity->getEntityID()) > 0;
+}
+
+unsigned int StaticLayer::getBakedCount() const
+{
+    return bakedIDs.size();
+}
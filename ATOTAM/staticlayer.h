@@ -0,0 +1,40 @@
+#ifndef STATICLAYER_H
+#define STATICLAYER_H
+
+#include "Entities/entity.h"
+
+#include <QImage>
+
+#include <map>
+#include <unordered_set>
+#include <vector>
+
+// Rendering layer of a room's still scenery. Terrain and Areas that aren't animated are drawn once
+// into chunks of chunkSize px, so the renderer blits a few chunks instead of every tile.
+// Built along with the StaticGeometry and never modified afterwards
+class StaticLayer
+{
+public:
+    static const int chunkSize = 256; // in px, at the logical resolution (world px divided by the rendering multiplier)
+
+    struct Chunk {
+        int x = 0; // in px, at the logical resolution
+        int y = 0;
+        QImage image;
+    };
+
+    static bool isStill(Entity *entity); // Whether 'entity' can be drawn once for all
+    static int toLogical(int worldPx, int renderingMultiplier); // Rounded down, also for negative positions
+
+    StaticLayer(const std::vector<Entity*> &roomEntities, int renderingMultiplier);
+
+    const std::map<float, std::vector<Chunk>> &getChunks() const; // By entity layer
+    bool isBaked(const Entity *entity) const; // Whether 'entity' is drawn by the chunks
+    unsigned int getBakedCount() const;
+
+private:
+    std::map<float, std::vector<Chunk>> chunks;
+    std::unordered_set<unsigned long long> bakedIDs; // Entity::getEntityID of the drawn entities
+};
+
+#endif // STATICLAYER_H
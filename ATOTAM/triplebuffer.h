@@ -0,0 +1,42 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Hands frames from a producer thread to a consumer thread without locks nor copies.
+// The producer fills the back frame and publishes it by swapping it with the middle one,
+// the consumer swaps the middle frame with its front one when a newer frame was published.
+// Each thread only ever touches its own frame, the middle one is never read in place
+template <typename T>
+class TripleBuffer
+{
+public:
+    T &getBackFrame() // Producer
+    {
+        return frames[back];
+    }
+
+    void publish() // Producer, the back frame is then another, older frame
+    {
+        // Release: the consumer sees the whole frame once it sees the new index
+        back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    const T &getFrontFrame() // Consumer, the latest published frame
+    {
+        if (middle.load(std::memory_order_relaxed) & freshBit)
+            front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return frames[front];
+    }
+
+private:
+    static const unsigned int indexMask = 3;
+    static const unsigned int freshBit = 4; // Set in 'middle' when it holds a frame the consumer hasn't seen
+
+    T frames[3];
+    unsigned int back = 0; // Only used by the producer
+    unsigned int front = 1; // Only used by the consumer
+    std::atomic<unsigned int> middle{2};
+};
+
+#endif // TRIPLEBUFFER_H
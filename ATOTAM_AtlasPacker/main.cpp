@@ -0,0 +1,214 @@
+#include "../ATOTAM/Entities/animationcache.h"
+#include "../ATOTAM/Entities/archetype.h"
+#include "../ATOTAM/Entities/textureatlas.h"
+
+#include <QDir>
+#include <QImage>
+#include <QPainter>
+#include <QString>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Packs every frame of every clip used by an entity into a few atlas pages, and writes the index
+// AnimationCache reads instead of slicing assets/textures at runtime.
+// Run it again whenever entities.json or a texture changes
+
+static const int pageSize = 2048; // in px, the biggest page, frames bigger than this get their own page
+
+struct PackedClip
+{
+    std::string texture;
+    std::string state;
+    AnimationCache::Side side;
+    std::vector<AtlasFrame> frames;
+};
+
+struct PackedFrame
+{
+    QImage image;
+    unsigned int clip; // Index in the PackedClips
+    unsigned int index; // Index in the clip's frames
+};
+
+// Identical frames (the same file region for both sides of a clip, shared sheets...) are packed once
+static unsigned long long hashPixels(const QImage &image)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int y = 0; y < image.height(); y++) {
+        const uchar *line = image.constScanLine(y);
+        for (int x = 0; x < image.width() * 4; x++) {
+            hash ^= line[x];
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string assetsPath = argc > 1 ? argv[1] : "../ATOTAM/assets";
+    std::string texturesPath = assetsPath + "/textures/";
+
+    std::ifstream valuesFile(assetsPath + "/entities.json");
+    if (!valuesFile) {
+        std::cerr << "Can't read " << assetsPath << "/entities.json" << std::endl;
+        return 1;
+    }
+    nlohmann::json values;
+    valuesFile >> values;
+    ArchetypeRegistry::compile(values);
+
+    // Slicing every clip of every texture used by a name, for each side it has
+    std::vector<PackedClip> clips;
+    std::vector<PackedFrame> frames;
+    std::set<std::string> textures;
+    std::map<std::string, QImage> files;
+    for (unsigned int id = 0; id < ArchetypeRegistry::getCount(); id++) {
+        const Archetype *archetype = ArchetypeRegistry::get(id);
+        if (!textures.insert(archetype->texture).second)
+            continue;
+
+        for (std::vector<AnimationClip>::const_iterator clip = archetype->clips.begin(); clip != archetype->clips.end(); clip++) {
+            std::map<std::string, QImage>::iterator file = files.find(clip->file);
+            if (file == files.end())
+                file = files.insert(std::make_pair(clip->file, QImage(QString::fromStdString(texturesPath + clip->file))
+                                                   .convertToFormat(QImage::Format_ARGB32))).first;
+            if (file->second.isNull()) {
+                std::cerr << "Can't read " << texturesPath << clip->file << ", " << archetype->texture
+                          << " " << EntityIds::stateName(clip->state) << " is sliced at runtime" << std::endl;
+                continue;
+            }
+
+            std::vector<AnimationCache::Side> sides = {AnimationCache::Left, AnimationCache::Right};
+            if (clip->multiDirectional)
+                sides.push_back(AnimationCache::Front);
+            for (std::vector<AnimationCache::Side>::iterator side = sides.begin(); side != sides.end(); side++) {
+                PackedClip packedClip;
+                packedClip.texture = archetype->texture;
+                packedClip.state = EntityIds::stateName(clip->state);
+                packedClip.side = *side;
+                std::vector<QImage> clipFrames = AnimationCache::cut(file->second, *clip, *side);
+                packedClip.frames.resize(clipFrames.size());
+                for (unsigned int i = 0; i < clipFrames.size(); i++) {
+                    PackedFrame frame;
+                    frame.image = clipFrames[i].convertToFormat(QImage::Format_ARGB32);
+                    frame.clip = clips.size();
+                    frame.index = i;
+                    frames.push_back(frame);
+                }
+                clips.push_back(packedClip);
+            }
+        }
+    }
+
+    // Shelf packing, the tallest frames first so that the shelves waste little height
+    std::sort(frames.begin(), frames.end(), [](const PackedFrame &a, const PackedFrame &b) {
+        if (a.image.height() != b.image.height())
+            return a.image.height() > b.image.height();
+        return a.image.width() > b.image.width();
+    });
+
+    std::vector<QSize> pageSizes;
+    std::multimap<unsigned long long, std::pair<const AtlasFrame*, const QImage*>> placed; // By hashPixels
+    unsigned int uniqueFrames = 0;
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+    for (std::vector<PackedFrame>::iterator frame = frames.begin(); frame != frames.end(); frame++) {
+        AtlasFrame &place = clips[frame->clip].frames[frame->index];
+        int width = frame->image.width();
+        int height = frame->image.height();
+        if (width == 0 || height == 0)
+            continue; // Mapped to a null image
+
+        unsigned long long hash = hashPixels(frame->image);
+        const AtlasFrame *same = nullptr;
+        for (std::multimap<unsigned long long, std::pair<const AtlasFrame*, const QImage*>>::iterator candidate = placed.lower_bound(hash);
+             candidate != placed.upper_bound(hash) && same == nullptr; candidate++)
+            if (*candidate->second.second == frame->image)
+                same = candidate->second.first;
+        if (same != nullptr) {
+            place = *same;
+            continue;
+        }
+
+        if (x + width > pageSize) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (pageSizes.empty() || y + height > pageSize) {
+            pageSizes.push_back(QSize(0, 0));
+            x = 0;
+            y = 0;
+            shelfHeight = 0;
+        }
+        if (x + width > 0xFFFF || y + height > 0xFFFF) {
+            std::cerr << "A frame of " << clips[frame->clip].texture << " " << clips[frame->clip].state << " is too big for the atlas" << std::endl;
+            return 1;
+        }
+
+        place.page = pageSizes.size() - 1;
+        place.x = x;
+        place.y = y;
+        place.width = width;
+        place.height = height;
+        placed.insert(std::make_pair(hash, std::make_pair(&place, &frame->image)));
+        uniqueFrames++;
+
+        x += width;
+        shelfHeight = std::max(shelfHeight, height);
+        pageSizes.back() = QSize(std::max(pageSizes.back().width(), x), std::max(pageSizes.back().height(), y + height));
+    }
+
+    // Drawing the pages
+    std::string directory = TextureAtlas::directory(texturesPath);
+    QDir().mkpath(QString::fromStdString(directory));
+    std::vector<QImage> pages;
+    std::vector<std::string> pageNames;
+    for (unsigned int i = 0; i < pageSizes.size(); i++) {
+        pages.push_back(QImage(pageSizes[i], QImage::Format_ARGB32));
+        pages.back().fill(Qt::transparent);
+        pageNames.push_back("atlas_" + std::to_string(i) + ".png");
+    }
+    for (std::vector<PackedFrame>::iterator frame = frames.begin(); frame != frames.end(); frame++) {
+        const AtlasFrame &place = clips[frame->clip].frames[frame->index];
+        if (place.width == 0 || place.height == 0)
+            continue;
+        QPainter painter(&pages[place.page]);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(place.x, place.y, frame->image);
+        painter.end();
+    }
+    for (unsigned int i = 0; i < pages.size(); i++)
+        if (!pages[i].save(QString::fromStdString(directory + pageNames[i]))) {
+            std::cerr << "Can't write " << directory << pageNames[i] << std::endl;
+            return 1;
+        }
+
+    TextureAtlas atlas;
+    // Every file that was cut, so that editing one of them makes the runtime slice the files again
+    std::vector<std::string> sourceFiles;
+    for (std::map<std::string, QImage>::iterator file = files.begin(); file != files.end(); file++)
+        if (!file->second.isNull())
+            sourceFiles.push_back(file->first);
+    atlas.setSourceFiles(sourceFiles);
+    atlas.setSourceHash(TextureAtlas::hashSources(assetsPath, sourceFiles));
+    atlas.setPages(pageNames);
+    for (std::vector<PackedClip>::iterator clip = clips.begin(); clip != clips.end(); clip++)
+        atlas.add(clip->texture, clip->state, clip->side, clip->frames);
+    if (!atlas.save(TextureAtlas::indexPath(texturesPath))) {
+        std::cerr << "Can't write " << TextureAtlas::indexPath(texturesPath) << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << frames.size() << " frames (" << uniqueFrames << " different ones) of "
+              << clips.size() << " clips into " << pages.size() << " pages" << std::endl;
+    return 0;
+}
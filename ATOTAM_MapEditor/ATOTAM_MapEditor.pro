@@ -22,16 +22,25 @@ SOURCES += \
     resizeedit.cpp \
     multitypeedit.cpp \
     ../ATOTAM/map.cpp \
+    ../ATOTAM/renderqueue.cpp \
+    ../ATOTAM/spatialgrid.cpp \
     ../ATOTAM/Entities/entity.cpp \
+    ../ATOTAM/Entities/entityids.cpp \
     ../ATOTAM/Entities/area.cpp \
+    ../ATOTAM/Entities/animationcache.cpp \
+    ../ATOTAM/Entities/archetype.cpp \
+    ../ATOTAM/Entities/bodystore.cpp \
+    ../ATOTAM/Entities/roomarena.cpp \
     ../ATOTAM/Entities/collisionbox.cpp \
     ../ATOTAM/Entities/terrain.cpp \
+    ../ATOTAM/Entities/textureatlas.cpp \
     ../ATOTAM/Entities/door.cpp \
     ../ATOTAM/Entities/dynamicobj.cpp \
     ../ATOTAM/Entities/living.cpp \
     ../ATOTAM/Entities/monster.cpp  \
     ../ATOTAM/Entities/npc.cpp \
     ../ATOTAM/Entities/samos.cpp \
+    ../ATOTAM/Entities/samosstates.cpp \
     ../ATOTAM/Entities/savepoint.cpp \
     ../ATOTAM/Entities/projectile.cpp
 
@@ -49,16 +58,25 @@ HEADERS += \
     resizeedit.h \
     multitypeedit.h \
     ../ATOTAM/map.h \
+    ../ATOTAM/renderqueue.h \
+    ../ATOTAM/spatialgrid.h \
     ../ATOTAM/Entities/entity.h \
+    ../ATOTAM/Entities/entityids.h \
     ../ATOTAM/Entities/area.h \
+    ../ATOTAM/Entities/animationcache.h \
+    ../ATOTAM/Entities/archetype.h \
+    ../ATOTAM/Entities/bodystore.h \
+    ../ATOTAM/Entities/roomarena.h \
     ../ATOTAM/Entities/collisionbox.h \
     ../ATOTAM/Entities/terrain.h \
+    ../ATOTAM/Entities/textureatlas.h \
     ../ATOTAM/Entities/door.h \
     ../ATOTAM/Entities/dynamicobj.h \
     ../ATOTAM/Entities/living.h \
     ../ATOTAM/Entities/monster.h  \
     ../ATOTAM/Entities/npc.h \
     ../ATOTAM/Entities/samos.h \
+    ../ATOTAM/Entities/samosstates.h \
     ../ATOTAM/Entities/savepoint.h \
     ../ATOTAM/Entities/projectile.h
 
@@ -10,6 +10,7 @@
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <QCursor>
+#include <algorithm>
 #include <iostream>
 #include <windows.h>
 #include <QLineEdit>
@@ -102,6 +103,7 @@ void EditorPreview::updateProperty(std::string key, std::string value)
 
     PropertiesEdit* edit = new PropertiesEdit(&currentMap, selected, property);
     edit->make();
+    renderGridDirty = true;
     edits.push_back(edit);
 
     update();
@@ -206,6 +208,7 @@ void EditorPreview::undoEdit()
     for (auto edit = edits.rbegin(); edit != edits.rend(); edit++)
         if ((*edit)->getMade()) {
             (*edit)->unmake();
+            renderGridDirty = true;
             update();
             updateCursor(lastMousePosition);
             break;
@@ -217,6 +220,7 @@ void EditorPreview::redoEdit()
     for (auto edit = edits.begin(); edit != edits.end(); edit++)
         if (!(*edit)->getMade()) {
             (*edit)->make();
+            renderGridDirty = true;
             update();
             updateCursor(lastMousePosition);
             break;
@@ -228,7 +232,7 @@ void EditorPreview::duplicateObject()
     if (selected) {
         clearUnmadeEdits();
 
-        std::string type = selected->getEntType();
+        std::string type = selected->getEntTypeName();
         Entity* entity = nullptr;
         if (type == "Terrain")
             entity = new Terrain(*dynamic_cast<Terrain*>(selected));
@@ -261,6 +265,7 @@ void EditorPreview::deleteObject()
         RemoveEdit* remove = new RemoveEdit(&currentMap, selected, &entities, &selected);
         remove->make();
         edits.push_back(remove);
+        renderGridDirty = true;
         update();
         updateCursor(lastMousePosition);
     }
@@ -284,6 +289,7 @@ void EditorPreview::moveObjectByOnePixel(std::string direction)
     MoveEdit* move = new MoveEdit(&currentMap, selected, delta);
     move->make();
     edits.push_back(move);
+    renderGridDirty = true;
     update();
 }
 
@@ -294,6 +300,7 @@ void EditorPreview::resetSizeObject()
                                             std::pair<int, int>(1 - selected->getHorizontalRepeat(), 1 - selected->getVerticalRepeat()));
         resize->make();
         edits.push_back(resize);
+        renderGridDirty = true;
     }
 }
 
@@ -311,6 +318,7 @@ void EditorPreview::addObject(Entity *entity)
         AddEdit* add = new AddEdit(&currentMap, entity, &entities, &selected);
         add->make();
         edits.push_back(add);
+        renderGridDirty = true;
         update();
         updateCursor(lastMousePosition);
     }
@@ -321,42 +329,38 @@ void EditorPreview::clearEntities()
     for (auto ent = entities.begin(); ent != entities.end(); ent++)
         delete *ent;
     entities.clear();
+    renderGridDirty = true;
 }
 
 void EditorPreview::paintEvent(QPaintEvent *)
 {
     QPainter painter(this);
     visibleEntities.clear();
-    removeNullEntities();
-    std::vector<Entity*> currentRoom;
-
-    for (std::vector<Entity*>::iterator ent = entities.begin(); ent != entities.end(); ent++) {
-        // Make sure not to use a null pointer in case there is one
-        if (*ent == nullptr)
-            continue;
-
-        // The current room's entities are drawn on top
-        if ((*ent)->getRoomId() == roomId) {
-            currentRoom.push_back(*ent);
-            continue;
-        }
-
-        // The selected entity is drawn on top
-        if (*ent == selected)
-            continue;
-
-        drawEntity(*ent, &painter);
+    if (renderGridDirty)
+        buildRenderGrid();
+
+    // Only the entities around the camera, so that a zoomed out world map doesn't draw every room at once.
+    // The selected entity may be dragged anywhere, it is always drawn
+    candidates.clear();
+    renderGrid.queryArea(camera.x(), camera.y(), width() / zoomFactor, height() / zoomFactor, candidates);
+    candidates.erase(std::remove(candidates.begin(), candidates.end(), selected), candidates.end());
+    if (selected != nullptr)
+        candidates.push_back(selected);
+
+    // The current room's entities are drawn on top of the other rooms' ones, the selected entity on top of everything.
+    // Each group is then ordered by layer, like in the game
+    renderQueue.clear();
+    for (unsigned int i = 0; i < candidates.size(); i++) {
+        unsigned int priority = candidates[i] == selected ? 2 : candidates[i]->getRoomId() == roomId ? 1 : 0;
+        long long texture = candidates[i]->getTexture() == nullptr ? 0 : candidates[i]->getTexture()->cacheKey();
+        renderQueue.push(candidates[i]->getLayer(), priority, RenderQueue::textureKey(texture), i);
     }
-
-    // Draw current room's entities on top
-    for (std::vector<Entity*>::iterator ent = currentRoom.begin(); ent != currentRoom.end(); ent++)
-        drawEntity(*ent, &painter);
+    renderQueue.sort();
+    for (std::vector<RenderQueue::Command>::const_iterator command = renderQueue.getCommands().begin(); command != renderQueue.getCommands().end(); command++)
+        drawEntity(candidates[command->item], &painter);
 
     if (selected != nullptr) {
 
-        // Draw the selected entity on top
-        drawEntity(selected, &painter);
-
         int x = selected->getX();
         int y = selected->getY();
 
@@ -476,6 +480,18 @@ void EditorPreview::drawEntity(Entity* ent, QPainter* painter)
     }
 }
 
+void EditorPreview::buildRenderGrid()
+{
+    removeNullEntities();
+    QRect bounds = currentMap.getBounds();
+    renderGrid.resize(bounds.x(), bounds.y(), bounds.width(), bounds.height(), renderGridCellSize);
+    // The area drawEntity tests against the camera
+    for (std::vector<Entity*>::iterator ent = entities.begin(); ent != entities.end(); ent++)
+        renderGrid.insert(*ent, (*ent)->getX() + getClickAreaOffset(*ent).x(), (*ent)->getY() + getClickAreaOffset(*ent).y(),
+                          getClickAreaSize(*ent).first * renderingMultiplier, getClickAreaSize(*ent).second * renderingMultiplier);
+    renderGridDirty = false;
+}
+
 void EditorPreview::removeNullEntities()
 {
     std::vector<Entity*> nonNullEntities;
@@ -622,15 +638,19 @@ void EditorPreview::mouseReleaseEvent(QMouseEvent *event)
             if (!edits.empty()) {
                 if (MoveEdit* move = dynamic_cast<MoveEdit*>(*(edits.end() - 1))) {
                     setCursor(Qt::CursorShape::OpenHandCursor);
-                    if (!move->getDelta().isNull())
+                    if (!move->getDelta().isNull()) {
                         move->make();
+                        renderGridDirty = true;
+                    }
                     else {
                         delete move;
                         edits.pop_back();
                     }
                 } else if (ResizeEdit* resize = dynamic_cast<ResizeEdit*>(*(edits.end() - 1))) {
-                    if (resize->getDelta().first != 0 || resize->getDelta().second != 0)
+                    if (resize->getDelta().first != 0 || resize->getDelta().second != 0) {
                         resize->make();
+                        renderGridDirty = true;
+                    }
                     else {
                         delete resize;
                         edits.pop_back();
@@ -795,19 +815,19 @@ void EditorPreview::dragEnterEvent(QDragEnterEvent *event)
         if (type == "Terrain")
             entity = new Terrain(x, y, name);
         else if (type == "NPC")
-            entity = new NPC(x, y, "Right", name);
+            entity = new NPC(x, y, Facing::Right, name);
         else if (type == "Area") {
             if (name.substr(name.size() - 4, 4) == "Door")
                 entity = new Door(x, y, name);
             else
                 entity = new Area(x, y, name);
         } else if (type == "Monster")
-            entity = new Monster(x, y, "Right", name);
+            entity = new Monster(x, y, Facing::Right, name);
 
         entity->setRoomId(roomId);
 
         // Rendering (should be the last function calls)
-        entity->setState(Entity::values["names"][name]["defaultState"]);
+        entity->setState(EntityIds::state(Entity::values["names"][name]["defaultState"]));
         entity->setCurrentAnimation(entity->updateAnimation());
         entity->setFrame(0);
         entity->updateTexture();
@@ -867,6 +887,7 @@ void EditorPreview::dropEvent(QDropEvent *event)
     event->acceptProposedAction();
     if (AddEdit* add = dynamic_cast<AddEdit*>(edits[edits.size() - 1])) {
         add->make();
+        renderGridDirty = true;
         setFocus(Qt::MouseFocusReason);
         updateCursor(event->position().toPoint());
         update();
@@ -911,6 +932,7 @@ Map* EditorPreview::getCurrentMap()
 void EditorPreview::setCurrentMap(const Map &newCurrentMap)
 {
     currentMap = newCurrentMap;
+    renderGridDirty = true;
 }
 
 std::string EditorPreview::getRoomId() const
@@ -986,4 +1008,5 @@ const std::vector<Entity *> &EditorPreview::getEntities() const
 void EditorPreview::setEntities(const std::vector<Entity *> &newEntities)
 {
     entities = newEntities;
+    renderGridDirty = true;
 }
@@ -6,6 +6,8 @@
 
 #include "../ATOTAM/Entities/entity.h"
 #include "../ATOTAM/map.h"
+#include "../ATOTAM/renderqueue.h"
+#include "../ATOTAM/spatialgrid.h"
 #include <QWidget>
 
 class EditorPreview : public QWidget
@@ -68,7 +70,10 @@ public slots:
     void updateProperty(std::string key, std::string value);
 
 private:
+    static const int renderGridCellSize = 512; // in px, bigger than in the game as the world map is mostly seen zoomed out
+
     void drawEntity(Entity* ent, QPainter* painter);
+    void buildRenderGrid(); // Also removes the null entities
     void removeNullEntities();
     void updateProperties();
 
@@ -83,6 +88,10 @@ private:
     // paintEvent fields
     std::vector<Entity*> entities = std::vector<Entity*>();
     std::vector<Entity*> visibleEntities = std::vector<Entity*>();
+    RenderQueue renderQueue = RenderQueue(RenderQueue::PriorityFirst);
+    SpatialGrid renderGrid; // Every entity by the area drawEntity tests, for the view culling
+    bool renderGridDirty = true; // Set by every edit, the grid is then rebuilt by the next paintEvent
+    std::vector<Entity*> candidates = std::vector<Entity*>(); // Entities found by the grid, reused every paintEvent
     QImage* errorTexture = nullptr;
     QImage* emptyTexture = nullptr;
     QPoint camera = QPoint();
@@ -472,6 +472,7 @@ void EditorWindow::readMapJsonIO()
 void EditorWindow::readEntitiesJsonIO()
 {
     Entity::values = Entity::loadValues(preview->getAssetsPath());
+    ArchetypeRegistry::compile(Entity::values);
 }
 
 void EditorWindow::resetPositionView()
@@ -46,11 +46,11 @@ QStandardItemModel* setupObjectList() {
                 else
                     e = new Area(0, 0, name);
             } else if (type == "NPC")
-                e = new NPC(0, 0, "Right", name);
+                e = new NPC(0, 0, Facing::Right, name);
             else if (type == "Monster")
-                e = new Monster(0, 0, "Right", name);
+                e = new Monster(0, 0, Facing::Right, name);
 
-            e->setState(j.value()["defaultState"]);
+            e->setState(EntityIds::state(j.value()["defaultState"]));
             e->setCurrentAnimation(e->updateAnimation());
             e->updateTexture();
 
@@ -71,7 +71,7 @@ QStandardItemModel* setupObjectList() {
         for (std::vector<Entity*>::iterator e = entities.begin(); e != entities.end(); e++) {
             if (*e == nullptr)
                 continue;
-            if ((*e)->getEntType() != t)
+            if ((*e)->getEntTypeName() != t)
                 continue;
             QStandardItem* item = new QStandardItem;
 
@@ -99,8 +99,8 @@ void setupEditorWindow(nlohmann::json editorJson, std::string assetsPath)
     std::ifstream file(assetsPath + "/params.json");
     nlohmann::json params;
     file >> params;
-    EditorPreview* preview = new EditorPreview(&editedMap, new QImage(QString::fromStdString(assetsPath + "/textures/error.png"))
-                                               , new QImage(QString::fromStdString(assetsPath + "/textures/empty.png")), 2
+    EditorPreview* preview = new EditorPreview(&editedMap, new QImage(AnimationCache::displayReady(QImage(QString::fromStdString(assetsPath + "/textures/error.png"))))
+                                               , new QImage(AnimationCache::displayReady(QImage(QString::fromStdString(assetsPath + "/textures/empty.png")))), 2
                                                , editorJson, params["frameRate"], assetsPath);
 
     // Window
@@ -160,6 +160,7 @@ int main(int argc, char *argv[])
     nlohmann::json editorJson;
     file >> editorJson;
     Entity::values = Entity::loadValues(assetsPath);
+    ArchetypeRegistry::compile(Entity::values);
     setupEditorWindow(editorJson, assetsPath);
 
     return a.exec();
@@ -32,7 +32,7 @@ void MoveEdit::unmake()
         // Get map Json pointer
         nlohmann::json* mapJson = map->getJson();
         // json_pointer to the entity list
-        nlohmann::json::json_pointer ptr("/rooms/" + entity->getRoomId() + "/content/" + entity->getEntType() + "/" + entity->getFullName());
+        nlohmann::json::json_pointer ptr("/rooms/" + entity->getRoomId() + "/content/" + entity->getEntTypeName() + "/" + entity->getFullName());
         // json_pointer to the room position
         nlohmann::json::json_pointer roomPtr("/rooms/" + entity->getRoomId() + "/position");
         // Find Entity json node in the map
@@ -72,7 +72,7 @@ void MoveEdit::make()
         nlohmann::json* mapJson = map->getJson();
         // json_pointer to the entity list
         nlohmann::json::json_pointer ptr("/rooms/" + entity->getRoomId()
-                                         + "/content/" + entity->getEntType() + "/" + entity->getFullName());
+                                         + "/content/" + entity->getEntTypeName() + "/" + entity->getFullName());
         // json_pointer to the room position
         nlohmann::json::json_pointer roomPtr("/rooms/" + entity->getRoomId() + "/position");
         // Find Entity json node in the map
@@ -29,7 +29,7 @@ void PropertiesEdit::unmake()
         nlohmann::json* mapJson = map->getJson();
         // json_pointer to the entity list
         nlohmann::json::json_pointer ptr("/rooms/" + entity->getRoomId()
-                                         + "/content/" + entity->getEntType() + "/" + entity->getFullName());
+                                         + "/content/" + entity->getEntTypeName() + "/" + entity->getFullName());
         // Find Entity json node in the map
         nlohmann::json entityJson = map->find(entity);
         // Iterate over the entities with the same entType and name
@@ -66,7 +66,7 @@ void PropertiesEdit::unmake()
 
                 // Update map
                 ptr = nlohmann::json::json_pointer("/rooms/" + entity->getRoomId()
-                                                   + "/content/" + entity->getEntType() + "/" + entity->getFullName());
+                                                   + "/content/" + entity->getEntTypeName() + "/" + entity->getFullName());
                 mapJson->at(ptr)[std::stoi(ent.key())] = entityJson;
                 break;
             }
@@ -82,7 +82,7 @@ void PropertiesEdit::make()
         nlohmann::json* mapJson = map->getJson();
         // json_pointer to the entity list
         nlohmann::json::json_pointer ptr("/rooms/" + entity->getRoomId()
-                                         + "/content/" + entity->getEntType() + "/" + entity->getFullName());
+                                         + "/content/" + entity->getEntTypeName() + "/" + entity->getFullName());
         // Find Entity json node in the map
         nlohmann::json entityJson = map->find(entity);
         // Iterate over the entities with the same entType and name
@@ -119,7 +119,7 @@ void PropertiesEdit::make()
 
                 // Update map
                 ptr = nlohmann::json::json_pointer("/rooms/" + entity->getRoomId()
-                                                   + "/content/" + entity->getEntType() + "/" + entity->getFullName());
+                                                   + "/content/" + entity->getEntTypeName() + "/" + entity->getFullName());
                 mapJson->at(ptr)[std::stoi(ent.key())] = entityJson;
                 break;
             }
@@ -40,7 +40,7 @@ void ResizeEdit::unmake()
         nlohmann::json* mapJson = map->getJson();
         // json_pointer to the entity list
         nlohmann::json::json_pointer ptr("/rooms/" + entity->getRoomId()
-                                         + "/content/" + entity->getEntType() + "/" + entity->getFullName());
+                                         + "/content/" + entity->getEntTypeName() + "/" + entity->getFullName());
         // json_pointer to the room position
         nlohmann::json::json_pointer roomPtr("/rooms/" + entity->getRoomId() + "/position");
         // Find Entity json node in the map
@@ -91,7 +91,7 @@ void ResizeEdit::make()
         nlohmann::json* mapJson = map->getJson();
         // json_pointer to the entity list
         nlohmann::json::json_pointer ptr("/rooms/" + entity->getRoomId()
-                                         + "/content/" + entity->getEntType() + "/" + entity->getFullName());
+                                         + "/content/" + entity->getEntTypeName() + "/" + entity->getFullName());
         // json_pointer to the room position
         nlohmann::json::json_pointer roomPtr("/rooms/" + entity->getRoomId() + "/position");
         // Find Entity json node in the map
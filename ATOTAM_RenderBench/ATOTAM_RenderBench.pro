@@ -0,0 +1,34 @@
+QT       += core gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+# Times the blits of every animation frame onto the backbuffer, as decoded from the PNG files
+# and as AnimationCache::displayReady prepares them.
+# 'make bench' builds it and runs it on the game's assets
+
+SOURCES += \
+    main.cpp \
+    ../ATOTAM/Entities/animationcache.cpp \
+    ../ATOTAM/Entities/archetype.cpp \
+    ../ATOTAM/Entities/collisionbox.cpp \
+    ../ATOTAM/Entities/entityids.cpp \
+    ../ATOTAM/Entities/samosstates.cpp \
+    ../ATOTAM/Entities/textureatlas.cpp
+
+HEADERS += \
+    ../ATOTAM/Entities/animationcache.h \
+    ../ATOTAM/Entities/archetype.h \
+    ../ATOTAM/Entities/collisionbox.h \
+    ../ATOTAM/Entities/entityids.h \
+    ../ATOTAM/Entities/samosstates.h \
+    ../ATOTAM/Entities/textureatlas.h
+
+bench.commands = $$shell_path($$OUT_PWD/$$TARGET) $$shell_path($$PWD/../ATOTAM/assets)
+bench.depends = first
+QMAKE_EXTRA_TARGETS += bench
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,122 @@
+#include "../ATOTAM/Entities/animationcache.h"
+#include "../ATOTAM/Entities/archetype.h"
+
+#include <QImage>
+#include <QPainter>
+#include <QString>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Compares the cost of drawing the animation frames onto the backbuffer in the format the PNG decoder gives
+// and in the format AnimationCache::displayReady converts them to once at load time.
+// Run it again after changing how the frames are prepared
+
+static const int backbufferWidth = 960; // in px, the logical resolution of the default camera
+static const int backbufferHeight = 540;
+static const unsigned int blitsPerRun = 200000;
+
+// Average time of a blit, in ns. Every frame is drawn in turn at positions spread over the backbuffer
+static double timeBlits(const std::vector<QImage> &frames)
+{
+    if (frames.empty())
+        return 0.0;
+
+    QImage backbuffer(backbufferWidth, backbufferHeight, QImage::Format_ARGB32_Premultiplied);
+    backbuffer.fill(Qt::white);
+    QPainter painter(&backbuffer);
+
+    // A first pass so that every lazy conversion or allocation happens before the timing
+    for (std::vector<QImage>::const_iterator frame = frames.begin(); frame != frames.end(); frame++)
+        painter.drawImage(0, 0, *frame);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < blitsPerRun; i++)
+        painter.drawImage((i * 97) % backbufferWidth, (i * 57) % backbufferHeight, frames[i % frames.size()]);
+    painter.end();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / blitsPerRun;
+}
+
+static void report(const std::string &name, const std::vector<QImage> &decoded, const std::vector<QImage> &ready)
+{
+    double before = timeBlits(decoded);
+    double after = timeBlits(ready);
+    std::cout << name << " (" << ready.size() << " frames) : " << before << " ns per blit as decoded, "
+              << after << " ns per blit display-ready";
+    if (after > 0.0)
+        std::cout << " (x" << before / after << ")";
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string assetsPath = argc > 1 ? argv[1] : "../ATOTAM/assets";
+    std::string texturesPath = assetsPath + "/textures/";
+
+    std::ifstream valuesFile(assetsPath + "/entities.json");
+    if (!valuesFile) {
+        std::cerr << "Can't read " << assetsPath << "/entities.json" << std::endl;
+        return 1;
+    }
+    nlohmann::json values;
+    valuesFile >> values;
+    ArchetypeRegistry::compile(values);
+
+    // Every clip of every texture, facing right, as the game slices them
+    std::vector<QImage> decoded;
+    std::vector<QImage> ready;
+    std::vector<QImage> opaqueDecoded;
+    std::vector<QImage> opaqueReady;
+    std::set<std::string> textures;
+    std::map<std::string, QImage> files;
+    for (unsigned int id = 0; id < ArchetypeRegistry::getCount(); id++) {
+        const Archetype *archetype = ArchetypeRegistry::get(id);
+        if (!textures.insert(archetype->texture).second)
+            continue;
+
+        for (std::vector<AnimationClip>::const_iterator clip = archetype->clips.begin(); clip != archetype->clips.end(); clip++) {
+            std::map<std::string, QImage>::iterator file = files.find(clip->file);
+            if (file == files.end())
+                file = files.insert(std::make_pair(clip->file, QImage(QString::fromStdString(texturesPath + clip->file)))).first;
+            if (file->second.isNull())
+                continue;
+
+            std::vector<QImage> frames = AnimationCache::cut(file->second, *clip, AnimationCache::Right);
+            for (std::vector<QImage>::iterator frame = frames.begin(); frame != frames.end(); frame++) {
+                if (frame->isNull())
+                    continue;
+                QImage prepared = AnimationCache::displayReady(*frame);
+                decoded.push_back(*frame);
+                ready.push_back(prepared);
+                if (prepared.format() == QImage::Format_RGB32) {
+                    opaqueDecoded.push_back(*frame);
+                    opaqueReady.push_back(prepared);
+                }
+            }
+        }
+    }
+
+    if (decoded.empty()) {
+        std::cerr << "No frame to draw in " << texturesPath << std::endl;
+        return 1;
+    }
+
+    std::map<QImage::Format, unsigned int> decodedFormats;
+    for (std::vector<QImage>::iterator frame = decoded.begin(); frame != decoded.end(); frame++)
+        decodedFormats[frame->format()]++;
+    std::cout << "Decoded formats :";
+    for (std::map<QImage::Format, unsigned int>::iterator format = decodedFormats.begin(); format != decodedFormats.end(); format++)
+        std::cout << " " << format->second << " frames in QImage::Format " << static_cast<int>(format->first) << ",";
+    std::cout << " " << opaqueReady.size() << " opaque frames converted to RGB32" << std::endl;
+
+    report("Every frame", decoded, ready);
+    report("Opaque frames", opaqueDecoded, opaqueReady);
+    return 0;
+}